@@ -70,6 +70,7 @@ static DoubleOption  opt_restart_inc       (_cat, "rinc",        "Restart interv
 static DoubleOption  opt_garbage_frac      (_cat, "gc-frac",     "The fraction of wasted memory allowed before a garbage collection is triggered",  0.20, DoubleRange(0, false, HUGE_VAL, false));
 static IntOption     opt_chrono            (_cat, "chrono",  "Controls if to perform chrono backtrack", 100, IntRange(-1, INT32_MAX));
 static IntOption     opt_conf_to_chrono    (_cat, "confl-to-chrono",  "Controls number of conflicts to perform chrono backtrack", 4000, IntRange(-1, INT32_MAX));
+static BoolOption    opt_ls_async          (_cat, "ls-async",    "Run local search on a helper thread, concurrently with CDCL", false);
 
 static IntOption     opt_max_lbd_dup       ("DUP-LEARNTS", "lbd-limit",  "specifies the maximum lbd of learnts to be screened for duplicates.", 14, IntRange(0, INT32_MAX));
 static IntOption     opt_min_dupl_app      ("DUP-LEARNTS", "min-dup-app",  "specifies the minimum number of learnts to be included into db.", 2, IntRange(2, INT32_MAX));
@@ -161,6 +162,8 @@ Solver::Solver() :
   , nbconfbeforesimplify(1000)
   , incSimplify(1000)
 
+  , ls_async(opt_ls_async)
+
 {}
 
 
@@ -1786,12 +1789,12 @@ void Solver::info_based_rephase(){
     int var_nums = nVars();
     for(int i=0;i<var_nums;++i) polarity[i] = !ls_mediation_soln[i];
     
-    for(int i=0;i<lssolver->in_conflict_sz;++i){
-        int v = lssolver->in_conflict[i];
+    for(int i=0;i<ls_confl_vars.size();++i){
+        Var v = ls_confl_vars[i];
         if(VSIDS){
-            varBumpActivity(v-1,lssolver->conflict_ct[v]);
+            varBumpActivity(v,ls_confl_weights[i]);
         }else{
-            conflicted[v-1] += lssolver->conflict_ct[v];
+            conflicted[v] += ls_confl_weights[i];
         }
     }
     
@@ -1850,7 +1853,16 @@ lbool Solver::search(int& nof_conflicts)
     freeze_ls_restart_num--;
     bool    can_call_ls = true;
 
-    if(freeze_ls_restart_num<1){
+    if(ls_async){
+        // pick up the result of the running LS, if any, and keep the worker busy
+        bool res;
+        if(poll_ls(res) && finish_ls(res)){
+            solved_by_ls = true;
+            return l_True;
+        }
+        if(!ls_job) launch_ls(top_trail_UP);
+
+    }else if(freeze_ls_restart_num<1){
 
         bool res = call_ls(top_trail_UP);
 
@@ -2277,10 +2289,16 @@ lbool Solver::solve_()
         ok = false;
 
     cancelUntil(0);
+    stop_ls();
     delete [] ls_mediation_soln;
     delete [] ls_best_soln;
     delete [] top_trail_soln;
     delete [] tmp_up_build_soln;
+    if(fps_has_constructed){
+        clear_ls_formula();
+        free_memory(lssolver);
+        fps_has_constructed = false;
+    }
     free(lssolver);
     return status;
 }
@@ -2403,9 +2421,20 @@ void Solver::relocAll(ClauseAllocator& to)
     for (int i = 0; i < learnts_local.size(); i++)
         ca.reloc(learnts_local[i], to);
 
-    // All original:
+    // Learnts mirrored in the LS formula:
     //
     int i, j;
+    for (i = j = 0; i < ls_learnts.size(); i++)
+        if (removed(ls_learnts[i].cr)){
+            ls_pending_deletes.push(ls_learnts[i].idx);
+            ls_dropped++;
+        }else{
+            ca.reloc(ls_learnts[i].cr, to);
+            ls_learnts[j++] = ls_learnts[i]; }
+    ls_learnts.shrink(i - j);
+
+    // All original:
+    //
     for (i = j = 0; i < clauses.size(); i++)
         if (ca[clauses[i]].mark() != 1){
             ca.reloc(clauses[i], to);
@@ -2430,80 +2459,78 @@ void Solver::garbageCollect()
 
 
 
+int Solver::ls_add_clause(const Clause& c){
+    ls_tmp_lits.clear();
+    for(int i=0;i<c.size();i++) ls_tmp_lits.push(toFormal(c[i]));
+    return fps_add_clause(lssolver,(int*)ls_tmp_lits,ls_tmp_lits.size());
+}
+
+void Solver::clear_ls_formula(){
+    for(int i=0;i<ls_learnts.size();i++)
+        if(!removed(ls_learnts[i].cr)) ca[ls_learnts[i].cr].setLSImported(false);
+    ls_learnts.clear();
+    ls_pending_deletes.clear();
+    ls_formula_loaded = false;
+    ls_units_imported = 0;
+    ls_dropped        = 0;
+    fps_clear_formula(lssolver);
+}
+
+// Bring the LS formula up to date instead of rebuilding it: original clauses are loaded once
+// (those later removed are satisfied at the root, and the root units take care of them),
+// core/tier2 learnts are appended or dropped as the tiers change, and new root units are added.
 void Solver::load_ls_data(){
-    using namespace std;
-    int ls_var_nums = nVars();
-    int ls_cls_nums = nClauses()+learnts_core.size()+learnts_tier2.size();
-    int ls_trail_sz;
-    if(trail_lim.size()>0) ls_trail_sz = trail_lim[0];
-    else ls_trail_sz = trail.size();
-    ls_cls_nums += ls_trail_sz;
-    lssolver->num_vars = ls_var_nums;
-    lssolver->num_clauses = ls_cls_nums;
-    lssolver->mems_left = (long long) ls_mems_num;
-    lssolver->ratio = (lssolver->num_clauses+0.0)/lssolver->num_vars;
-    alloc_memory(lssolver);
-    for (int c = 0; c < lssolver->num_clauses; c++) 
-		lssolver->clause_lit_count[c] = lssolver->clause_delete[c] = 0;
-	for (int v=1; v<=lssolver->num_vars; ++v)
-		lssolver->var_lit_count[v] = lssolver->fix[v] = 0;
-	lssolver->max_clause_len = 0;
-	lssolver->min_clause_len = lssolver->num_vars;
-    
-    using namespace std;
-    int cls_ct = 0;
-    for(int idx=0;idx<3;++idx){
-        vec<CRef> &vs = (idx==0)?clauses:(idx==1?learnts_core:(idx==2?learnts_tier2:learnts_local));
-        int vs_sz = vs.size();
-        for(int j=0;j<vs_sz;j++){
-            CRef &cr = vs[j];
-            Clause &c = ca[cr];
-            lssolver->clause_lit_count[cls_ct] = c.size();
-            lssolver->clause_lit[cls_ct] = (lit*)malloc(sizeof(lit)*(lssolver->clause_lit_count[cls_ct]+1));
-            int i=0;
-            for(;i<lssolver->clause_lit_count[cls_ct];i++){
-                int cur_lit = toFormal(c[i]);
-                lssolver->clause_lit[cls_ct][i].clause_num = cls_ct;
-                lssolver->clause_lit[cls_ct][i].var_num = abs(cur_lit);
-                if (cur_lit > 0) lssolver->clause_lit[cls_ct][i].sense = 1;
-                else    lssolver->clause_lit[cls_ct][i].sense = 0;
-                lssolver->var_lit_count[lssolver->clause_lit[cls_ct][i].var_num]++;
-            }
-            lssolver->clause_lit[cls_ct][i].var_num=0; 
-		    lssolver->clause_lit[cls_ct][i].clause_num = -1;
-            //unit clause
-            if(lssolver->clause_lit_count[cls_ct]==1){
-                lssolver->unitclause_queue[lssolver->unitclause_queue_end_pointer++] = lssolver->clause_lit[cls_ct][0];
-                lssolver->clause_delete[cls_ct]=1;
-            }
-            if(lssolver->clause_lit_count[cls_ct] > lssolver->max_clause_len)
-                lssolver->max_clause_len = lssolver->clause_lit_count[cls_ct];
-            else if(lssolver->clause_lit_count[cls_ct] < lssolver->min_clause_len)
-                lssolver->min_clause_len = lssolver->clause_lit_count[cls_ct];
-            lssolver->formula_len += lssolver->clause_lit_count[cls_ct];
+    for(int i=0;i<ls_pending_deletes.size();i++)
+        fps_delete_clause(lssolver,ls_pending_deletes[i]);
+    ls_pending_deletes.clear();
+
+    // dropped clauses leave holes, start over once they outnumber the live ones
+    if(ls_dropped > lssolver->num_clauses-ls_dropped) clear_ls_formula();
+
+    if(!ls_formula_loaded){
+        for(int j=0;j<clauses.size();j++)
+            ls_add_clause(ca[clauses[j]]);
+        ls_formula_loaded = true;
+    }
 
-            cls_ct++;
+    int i,j;
+    for(i=j=0;i<ls_learnts.size();i++){
+        LSLearnt& l = ls_learnts[i];
+        if(!removed(l.cr) && ca[l.cr].mark()!=LOCAL && ca[l.cr].size()==l.size){
+            ls_learnts[j++] = l;
+            continue;
         }
+        // removed, demoted to local or strengthened since it was sent
+        fps_delete_clause(lssolver,l.idx);
+        ls_dropped++;
+        if(!removed(l.cr)) ca[l.cr].setLSImported(false);
     }
-    for(int j=0;j<ls_trail_sz;++j){
-        int cur_lit = toFormal(trail[j]);
-        lssolver->clause_lit_count[cls_ct] = 1;
-        lssolver->clause_lit[cls_ct] = (lit*)malloc(sizeof(lit)*(2));
-        lssolver->clause_lit[cls_ct][0].clause_num = cls_ct;
-        lssolver->clause_lit[cls_ct][0].var_num = abs(cur_lit);
-        if (cur_lit > 0) lssolver->clause_lit[cls_ct][0].sense = 1;
-        else    lssolver->clause_lit[cls_ct][0].sense = 0;
-        lssolver->var_lit_count[lssolver->clause_lit[cls_ct][0].var_num]++;
-        lssolver->clause_lit[cls_ct][1].var_num=0; 
-        lssolver->clause_lit[cls_ct][1].clause_num=-1;
-        lssolver->unitclause_queue[lssolver->unitclause_queue_end_pointer++] = lssolver->clause_lit[cls_ct][0];
-        lssolver->clause_delete[cls_ct]=1;
-        if(lssolver->min_clause_len > 1)lssolver->min_clause_len = 1;
-        lssolver->formula_len += 1;
-        cls_ct++;
+    ls_learnts.shrink(i-j);
+
+    for(int idx=0;idx<2;++idx){
+        vec<CRef> &vs = (idx==0)?learnts_core:learnts_tier2;
+        for(j=0;j<vs.size();j++){
+            CRef cr = vs[j];
+            Clause &c = ca[cr];
+            if(removed(cr) || c.lsImported()) continue;
+            LSLearnt l;
+            l.cr   = cr;
+            l.idx  = ls_add_clause(c);
+            l.size = c.size();
+            ls_learnts.push(l);
+            c.setLSImported(true);
+        }
     }
+
+    int ls_trail_sz;
+    if(trail_lim.size()>0) ls_trail_sz = trail_lim[0];
+    else ls_trail_sz = trail.size();
+    for(;ls_units_imported<ls_trail_sz;ls_units_imported++)
+        fps_add_unit(lssolver,toFormal(trail[ls_units_imported]));
+
     update_after_build(lssolver);
-    
+    lssolver->mems_left = (long long) ls_mems_num;
+    lssolver->ratio = (lssolver->num_clauses+0.0)/lssolver->num_vars;
 }
 
 void Solver::build_soln_with_UP(){
@@ -2625,20 +2652,34 @@ void Solver::build_soln_with_UP(){
 
 bool Solver::call_ls(build_type type){
     // double start_time = cpuTime();
+    prepare_ls(type);
+    // double construct_time = cpuTime()-start_time;
+    bool res = local_search(lssolver);
+    return finish_ls(res);
+}
+
+// Bring lssolver up to date with the clause set and initialise it from the chosen phase.
+void Solver::prepare_ls(build_type type){
     if(fps_has_constructed)reinit_FPS(lssolver);
-    else init_FPS(lssolver),fps_has_constructed=true;
+    else init_FPS(lssolver,nVars()),fps_has_constructed=true;
     load_ls_data();
-    bool res = false;
-    int  init_ls_unsat_ct;
     if(type == current_UP){
         build_soln_with_UP();
         settings(lssolver,tmp_up_build_soln);
     }else if(type == top_trail_UP){settings(lssolver,top_trail_soln);}
     else if(type == random_build){settings(lssolver,NULL);}
-    init_ls_unsat_ct = lssolver->unsat_stack_fill_pointer;
-    // double construct_time = cpuTime()-start_time;
-    res = local_search(lssolver);
+}
+
+// Take the phases and conflict counts out of a finished local search.
+bool Solver::finish_ls(bool res){
     confl_trans(lssolver);
+    ls_confl_vars.clear();
+    ls_confl_weights.clear();
+    for(int i=0;i<lssolver->in_conflict_sz;++i){
+        int v = lssolver->in_conflict[i];
+        ls_confl_vars.push(v-1);
+        ls_confl_weights.push(lssolver->conflict_ct[v]);
+    }
     int ls_var_nums=nVars();
     for(int i=0;i<ls_var_nums;++i)ls_mediation_soln[i] = lssolver->best_soln[i+1];
     if(lssolver->best_cost <= ls_best_unsat_num){
@@ -2664,3 +2705,50 @@ bool Solver::call_ls(build_type type){
     
     return res;
 }
+
+// Asynchronous LS: the snapshot is taken here, local_search runs on ls_thread
+// and the result is picked up by poll_ls at a later restart.
+void Solver::launch_ls(build_type type){
+    prepare_ls(type);
+    {
+        std::lock_guard<std::mutex> lock(ls_mutex);
+        ls_job      = true;
+        ls_job_done = false;
+    }
+    if(!ls_thread.joinable()) ls_thread = std::thread(&Solver::ls_worker,this);
+    else ls_cv.notify_one();
+}
+
+bool Solver::poll_ls(bool& res){
+    if(!ls_job) return false;
+    std::lock_guard<std::mutex> lock(ls_mutex);
+    if(!ls_job_done) return false;
+    ls_job = false;
+    res    = ls_job_res;
+    return true;
+}
+
+void Solver::stop_ls(){
+    if(!ls_thread.joinable()) return;
+    lssolver->interrupted.store(true,std::memory_order_relaxed);
+    {
+        std::lock_guard<std::mutex> lock(ls_mutex);
+        ls_quit = true;
+    }
+    ls_cv.notify_one();
+    ls_thread.join();
+    ls_quit = ls_job = ls_job_done = false;
+}
+
+void Solver::ls_worker(){
+    std::unique_lock<std::mutex> lock(ls_mutex);
+    for(;;){
+        ls_cv.wait(lock,[this]{ return ls_quit || (ls_job && !ls_job_done); });
+        if(ls_quit) return;
+        lock.unlock();
+        bool res = local_search(lssolver);
+        lock.lock();
+        ls_job_res  = res;
+        ls_job_done = true;
+    }
+}
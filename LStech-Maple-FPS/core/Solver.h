@@ -53,6 +53,9 @@ OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWA
 
 // duplicate learnts version
 #include <chrono>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
 #include <vector>
 #include <unordered_map>
 #include <unordered_set>
@@ -520,6 +523,20 @@ private:
     int     up_build_num            = 0;
     double  up_build_time           = 0.0;
 
+    // Asynchronous LS: lssolver is owned by ls_thread between a launch and the pickup of
+    // its result, the CDCL side only touches it while no job is running.
+    bool    ls_async;
+    std::thread             ls_thread;
+    std::mutex              ls_mutex;
+    std::condition_variable ls_cv;
+    bool    ls_job                  = false;  // a local search is requested or running
+    bool    ls_job_done             = false;  // its result is waiting to be picked up
+    bool    ls_job_res              = false;
+    bool    ls_quit                 = false;
+    // conflict information of the last LS (variables and weights), copied out of lssolver
+    vec<Var> ls_confl_vars;
+    vec<int> ls_confl_weights;
+
     //Phases
     // save the recent ls soln and best ls soln, need to call ls once.
     char* ls_mediation_soln; 
@@ -530,12 +547,31 @@ private:
     char* tmp_up_build_soln;
     
 
+    // LS formula, kept in lssolver between calls:
+    // learnts mirrored in it (with their clause number and imported size),
+    // root trail literals already sent, and clause numbers dropped since the last rebuild.
+    struct LSLearnt { CRef cr; int idx; int size; };
+    vec<LSLearnt> ls_learnts;
+    vec<int>      ls_tmp_lits;
+    vec<int>      ls_pending_deletes;   // from relocAll, applied by the next load_ls_data
+    bool    ls_formula_loaded       = false;
+    int     ls_units_imported       = 0;
+    int     ls_dropped              = 0;
+
     //functions 
     // bool    call_ls(bool use_up_build);
     bool    fps_has_constructed = false;
     enum    build_type{current_UP,top_trail_UP,random_build};
     bool    call_ls(build_type type);
+    void    prepare_ls(build_type type);
+    bool    finish_ls(bool res);
+    void    launch_ls(build_type type);
+    bool    poll_ls(bool& res);
+    void    stop_ls();
+    void    ls_worker();
     void    load_ls_data();
+    int     ls_add_clause(const Clause& c);
+    void    clear_ls_formula();
     void    build_soln_with_UP();
     void    rand_based_rephase();
     void    info_based_rephase();
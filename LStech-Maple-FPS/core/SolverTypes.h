@@ -149,7 +149,8 @@ class Clause {
         unsigned removable : 1;
         unsigned size      : 32;
         //simplify
-        unsigned simplified : 1;}                            header;
+        unsigned simplified : 1;
+        unsigned ls_imported : 1;}                           header;
     union { Lit lit; float act; uint32_t abs; uint32_t touched; CRef rel; } data[0];
 
     friend class ClauseAllocator;
@@ -167,6 +168,7 @@ class Clause {
         //simplify
         //
         header.simplified = 0;
+        header.ls_imported = 0;
 
         for (int i = 0; i < ps.size(); i++)
             data[i].lit = ps[i];
@@ -222,6 +224,9 @@ public:
     //
     void setSimplified(bool b) { header.simplified = b; }
     bool simplified() { return header.simplified; }
+    // mirrored in the local search formula
+    void setLSImported(bool b) { header.ls_imported = b; }
+    bool lsImported() const    { return header.ls_imported; }
 };
 
 
@@ -291,6 +296,7 @@ public:
             // simplify
             //
             to[cr].setSimplified(c.simplified());
+            to[cr].setLSImported(c.lsImported());
         }
         else if (to[cr].has_extra()) to[cr].calcAbstraction();
     }
@@ -100,6 +100,7 @@ int main(int argc, char** argv)
         StringOption dimacs ("MAIN", "dimacs", "If given, stop after preprocessing and write the result to this file.");
         IntOption    cpu_lim("MAIN", "cpu-lim","Limit on CPU time allowed in seconds.\n", INT32_MAX, IntRange(0, INT32_MAX));
         IntOption    mem_lim("MAIN", "mem-lim","Limit on memory usage in megabytes.\n", INT32_MAX, IntRange(0, INT32_MAX));
+        IntOption    parse_threads("MAIN", "parse-threads", "Threads for parsing uncompressed input (0=one per 16 MB, up to the number of cores).\n", 0, IntRange(0, 256));
         BoolOption   drup   ("MAIN", "drup",   "Generate DRUP UNSAT proof.", false);
         StringOption drup_file("MAIN", "drup-file", "DRUP UNSAT proof ouput file.", "");
 
@@ -159,7 +160,8 @@ int main(int argc, char** argv)
             printf("c ============================[ Problem Statistics ]=============================\n");
             printf("c |                                                                             |\n"); }
         
-        parse_DIMACS(in, S);
+        if (argc == 1 || !parse_DIMACS(argv[1], S, parse_threads))
+            parse_DIMACS(in, S);
         gzclose(in);
         FILE* res = (argc >= 3) ? fopen(argv[2], "wb") : NULL;
 
@@ -23,6 +23,10 @@ OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWA
 
 #include <stdlib.h>
 #include <stdio.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
 
 #include <zlib.h>
 
@@ -54,11 +58,68 @@ public:
 };
 
 
+//-------------------------------------------------------------------------------------------------
+// A read-only memory mapping of an uncompressed input file:
+
+class MappedFile {
+    const char* buf;
+    size_t      sz;
+
+    void unmap() {
+        if (buf != NULL) munmap((void*)buf, sz);
+        buf = NULL;
+        sz  = 0; }
+
+    MappedFile(const MappedFile&);
+    MappedFile& operator = (const MappedFile&);
+
+public:
+    // Mapping fails for anything but a non-empty regular file and for gzip compressed files,
+    // which have to be read through 'StreamBuffer' instead.
+    explicit MappedFile(const char* path) : buf(NULL), sz(0) {
+        int fd = open(path, O_RDONLY);
+        if (fd < 0) return;
+        struct stat st;
+        if (fstat(fd, &st) == 0 && S_ISREG(st.st_mode) && st.st_size > 0){
+            void* p = mmap(NULL, st.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+            if (p != MAP_FAILED){
+                buf = (const char*)p;
+                sz  = st.st_size;
+                if (sz >= 2 && (unsigned char)buf[0] == 0x1f && (unsigned char)buf[1] == 0x8b)
+                    unmap();
+                else
+                    madvise(p, sz, MADV_SEQUENTIAL); } }
+        close(fd); }
+
+    ~MappedFile() { unmap(); }
+
+    bool        mapped() const { return buf != NULL; }
+    const char* data  () const { return buf; }
+    size_t      size  () const { return sz; }
+};
+
+
+//-------------------------------------------------------------------------------------------------
+// A character stream over a range of memory, e.g., a chunk of a 'MappedFile':
+
+class CharRange {
+    const char* pos;
+    const char* end;
+
+public:
+    CharRange(const char* b, const char* e) : pos(b), end(e) {}
+
+    int  operator *  () const { return (pos >= end) ? EOF : (unsigned char)*pos; }
+    void operator ++ ()       { pos++; }
+};
+
+
 //-------------------------------------------------------------------------------------------------
 // End-of-file detection functions for StreamBuffer and char*:
 
 
 static inline bool isEof(StreamBuffer& in) { return *in == EOF;  }
+static inline bool isEof(CharRange&    in) { return *in == EOF;  }
 static inline bool isEof(const char*   in) { return *in == '\0'; }
 
 //-------------------------------------------------------------------------------------------------
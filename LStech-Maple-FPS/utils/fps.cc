@@ -1,4 +1,5 @@
 #include "fps.h"
+#include <string.h>
 #define pop(stack) stack[--stack ## _fill_pointer]
 #define push(item, stack) stack[stack ## _fill_pointer++] = item
 #define fps_Mersenne_N 624
@@ -21,11 +22,10 @@ void smooth_clause_weights(FPS*);
 void update_clause_weights(FPS*);
 void update_clause_scores(FPS*,int);
 void set_clause_weighting(FPS*);
+void push_unit(FPS*,lit);
+void build_var_lit(FPS*);
 
 void default_initialize(FPS* lssolver){
-	lssolver->formula_len=0;
-	lssolver->unitclause_queue_beg_pointer=0;
-    lssolver->unitclause_queue_end_pointer=0;
 	lssolver->max_tries = 10000;
 	lssolver->max_flips = 200000000;
 	lssolver->ave_weight=1;
@@ -33,114 +33,213 @@ void default_initialize(FPS* lssolver){
 	lssolver->q_scale=0;
 	lssolver->q_init=0;
 	lssolver->mems_left=50000000;
+	lssolver->interrupted.store(false,std::memory_order_relaxed);
 }
 
+//hand out n bytes of a pool, keeping every array 8-byte aligned
+void* carve(char** pool, size_t n){
+	void* p = *pool;
+	*pool += (n+7)&~(size_t)7;
+	return p;
+}
+
+size_t pool_bytes(size_t n){ return (n+7)&~(size_t)7; }
+
+//(re)carve every per-clause array for cls_mem clauses; only the formula part
+//(clause_beg, clause_lit_count, clause_delete) survives, the rest is set up by init()
+void grow_clause_memory(FPS *lssolver, int cls_mem){
+	char* old_pool = lssolver->clause_pool;
+	int* old_beg = lssolver->clause_beg;
+	int* old_count = lssolver->clause_lit_count;
+	int* old_delete = lssolver->clause_delete;
+	size_t ints = pool_bytes(sizeof(int)*cls_mem);
+	char* p = lssolver->clause_pool = (char*)malloc(12*ints+pool_bytes(sizeof(double)*cls_mem));
+	lssolver->clause_beg		= (int*)carve(&p,ints);
+	lssolver->clause_lit_count	= (int*)carve(&p,ints);
+	lssolver->clause_delete 	= (int*)carve(&p,ints);
+	lssolver->clause_weight		= (int*)carve(&p,ints);
+	lssolver->sat_count			= (int*)carve(&p,ints);
+	lssolver->sat_var			= (int*)carve(&p,ints);
+	lssolver->unsat_stack		= (int*)carve(&p,ints);
+	lssolver->index_in_unsat_stack=(int*)carve(&p,ints);
+  lssolver->sel_cs        = (int*)carve(&p,ints);
+  lssolver->selected_clauses = (int*)carve(&p,ints);
+  lssolver->selected_times = (int*)carve(&p,ints);
+  lssolver->sampled_clauses = (int*)carve(&p,ints);
+  lssolver->clause_score = (double*)carve(&p,sizeof(double)*cls_mem);
+	if(old_pool!=NULL)
+	{
+		memcpy(lssolver->clause_beg,old_beg,sizeof(int)*lssolver->num_clauses);
+		memcpy(lssolver->clause_lit_count,old_count,sizeof(int)*lssolver->num_clauses);
+		memcpy(lssolver->clause_delete,old_delete,sizeof(int)*lssolver->num_clauses);
+		free(old_pool);
+	}
+	lssolver->clause_cap = cls_mem;
+}
+
+//make room for len more clause literals
+void grow_lit_memory(FPS *lssolver, int len){
+	if(lssolver->lit_size+len <= lssolver->lit_cap) return;
+	int cap = lssolver->lit_cap*2;
+	if(cap < lssolver->lit_size+len) cap = lssolver->lit_size+len;
+	char* old_pool = lssolver->lit_pool;
+	int* old_var = lssolver->clause_var;
+	char* old_sense = lssolver->clause_sense;
+	char* p = lssolver->lit_pool = (char*)malloc(pool_bytes(sizeof(int)*cap)+pool_bytes(cap));
+	lssolver->clause_var = (int*)carve(&p,sizeof(int)*cap);
+	lssolver->clause_sense = (char*)carve(&p,cap);
+	if(old_pool!=NULL)
+	{
+		memcpy(lssolver->clause_var,old_var,sizeof(int)*lssolver->lit_size);
+		memcpy(lssolver->clause_sense,old_sense,lssolver->lit_size);
+		free(old_pool);
+	}
+	lssolver->lit_cap = cap;
+}
+
+//make room for occurrence lists of n literals, their contents are rebuilt anyway
+void grow_occ_memory(FPS *lssolver, int n){
+	if(n <= lssolver->occ_cap) return;
+	free(lssolver->occ_pool);
+	lssolver->occ_cap = n+n/2;
+	char* p = lssolver->occ_pool = (char*)malloc(pool_bytes(sizeof(int)*lssolver->occ_cap)+pool_bytes(lssolver->occ_cap));
+	lssolver->var_clause = (int*)carve(&p,sizeof(int)*lssolver->occ_cap);
+	lssolver->var_sense = (char*)carve(&p,lssolver->occ_cap);
+}
+
+void push_unit(FPS *lssolver, lit l){
+	if(lssolver->unitclause_queue_end_pointer == lssolver->unitclause_queue_cap){
+		lssolver->unitclause_queue_cap *= 2;
+		lssolver->unitclause_queue = (lit*)realloc(lssolver->unitclause_queue,sizeof(lit)*lssolver->unitclause_queue_cap);
+	}
+	lssolver->unitclause_queue[lssolver->unitclause_queue_end_pointer++] = l;
+}
+
+//allocated once per instance, the clause pools grow geometrically with the formula
 void alloc_memory(FPS *lssolver){
 	int var_mem = lssolver->num_vars+2;
-	int cls_mem = lssolver->num_clauses+2;
-  int fps_cnum_mem = 10+2;
-  int bandit_cnum_mem = 20+2;
-	lssolver->score_inc_vars 	= (int*)malloc(sizeof(int)*var_mem);
-	lssolver->score_inc_flag 	= (int*)malloc(sizeof(int)*var_mem);
-	lssolver->var_lit 			= (lit**)malloc(sizeof(lit*)*var_mem);
-	lssolver->var_lit_count 	= (int*)malloc(sizeof(int)*var_mem);
-	lssolver->clause_lit  		= (lit**)malloc(sizeof(lit*)*cls_mem);
-	lssolver->clause_lit_count	= (int*)malloc(sizeof(int)*cls_mem);
-	lssolver->score				= (int*)malloc(sizeof(int)*var_mem);
-	lssolver->time_stamp		= (int*)malloc(sizeof(int)*var_mem);
-	lssolver->fix				= (int*)malloc(sizeof(int)*var_mem);
-	lssolver->cscc 				= (int*)malloc(sizeof(int)*var_mem);
-	lssolver->clause_weight		= (int*)malloc(sizeof(int)*cls_mem);
-	lssolver->sat_count			= (int*)malloc(sizeof(int)*cls_mem);
-	lssolver->sat_var			= (int*)malloc(sizeof(int)*cls_mem);
-	lssolver->unsat_stack		= (int*)malloc(sizeof(int)*cls_mem);
-	lssolver->index_in_unsat_stack=(int*)malloc(sizeof(int)*cls_mem);
-	lssolver->unsatvar_stack  	= (int*)malloc(sizeof(int)*var_mem);
-	lssolver->index_in_unsatvar_stack = (int*)malloc(sizeof(int)*var_mem);
-	lssolver->unsat_app_count 	= (int*)malloc(sizeof(int)*var_mem);
-	lssolver->goodvar_stack 	= (int*)malloc(sizeof(int)*var_mem);
-	lssolver->already_in_goodvar_stack = (int*)malloc(sizeof(int)*var_mem);
+	size_t ints = pool_bytes(sizeof(int)*var_mem);
+	char* p = lssolver->var_pool = (char*)malloc(24*ints+2*pool_bytes(var_mem));
+	lssolver->score_inc_vars 	= (int*)carve(&p,ints);
+	lssolver->score_inc_flag 	= (int*)carve(&p,ints);
+	lssolver->var_beg 			= (int*)carve(&p,ints);
+	lssolver->var_lit_count 	= (int*)carve(&p,ints);
+	lssolver->score				= (int*)carve(&p,ints);
+	lssolver->time_stamp		= (int*)carve(&p,ints);
+	lssolver->fix				= (int*)carve(&p,ints);
+	lssolver->cscc 				= (int*)carve(&p,ints);
+	lssolver->unsatvar_stack  	= (int*)carve(&p,ints);
+	lssolver->index_in_unsatvar_stack = (int*)carve(&p,ints);
+	lssolver->unsat_app_count 	= (int*)carve(&p,ints);
+	lssolver->goodvar_stack 	= (int*)carve(&p,ints);
+	lssolver->already_in_goodvar_stack = (int*)carve(&p,ints);
+	lssolver->cur_soln			= (char*)carve(&p,var_mem);
+	lssolver->best_soln			= (char*)carve(&p,var_mem);
+	lssolver->conflict_ct		= (int*)carve(&p,ints);
+	lssolver->in_conflict		= (int*)carve(&p,ints);
+  lssolver->cscc2         = (int*)carve(&p,ints);
+  lssolver->selected      = (int*)carve(&p,ints);
+  lssolver->selected_during_flip = (int*)carve(&p,ints);
+  lssolver->score2        = (int*)carve(&p,ints);
+  lssolver->scores        = (int*)carve(&p,ints);
+  lssolver->vars2         = (int*)carve(&p,ints);
+  lssolver->goodvar_stack2 = (int*)carve(&p,ints);
+  lssolver->best_vars     = (int*)carve(&p,ints);
+
 	lssolver->unitclause_queue 	= (lit*)malloc(sizeof(lit)*var_mem);
-	lssolver->clause_delete 	= (int*)malloc(sizeof(int)*cls_mem);
-	lssolver->cur_soln			= (char*)malloc(sizeof(int)*var_mem);
-	lssolver->best_soln			= (char*)malloc(sizeof(int)*var_mem);
-	lssolver->conflict_ct		= (int*)malloc(sizeof(int)*var_mem);
-	lssolver->in_conflict		= (int*)malloc(sizeof(int)*var_mem);
- 
-  lssolver->cscc2         = (int*)malloc(sizeof(int)*var_mem);
-  
-  lssolver->sel_cs        = (int*)malloc(sizeof(int)*cls_mem);
-  lssolver->selected      = (int*)malloc(sizeof(int)*var_mem);
-  lssolver->selected_during_flip = (int*)malloc(sizeof(int)*var_mem);
-  lssolver->score2        = (int*)malloc(sizeof(int)*var_mem);
-  lssolver->scores        = (int*)malloc(sizeof(int)*var_mem);
-  lssolver->vars2         = (int*)malloc(sizeof(int)*var_mem);
-  lssolver->goodvar_stack2 = (int*)malloc(sizeof(int)*var_mem);
-  lssolver->best_vars     = (int*)malloc(sizeof(int)*var_mem);
-  
-  lssolver->selected_clauses = (int*)malloc(sizeof(int)*cls_mem);
-  lssolver->selected_times = (int*)malloc(sizeof(int)*cls_mem);
-  lssolver->sampled_clauses = (int*)malloc(sizeof(int)*cls_mem);
-  lssolver->clause_score = (double*)malloc(sizeof(double)*cls_mem);
-  
-	for(int i=1;i<=lssolver->num_vars;++i) lssolver->conflict_ct[i]=0;
+	lssolver->unitclause_queue_cap = var_mem;
+
+	lssolver->clause_pool = NULL;
+	grow_clause_memory(lssolver,1024);
+	lssolver->lit_pool = NULL;
+	lssolver->lit_size = lssolver->lit_cap = 0;
+	grow_lit_memory(lssolver,4096);
+	lssolver->occ_pool = NULL;
+	lssolver->occ_cap = 0;
 }
 
 void free_memory(FPS *lssolver)
 {
-	int i;
-	for (i = 0; i < lssolver->num_clauses; i++) 
+	free(lssolver->var_pool);
+	free(lssolver->clause_pool);
+	free(lssolver->lit_pool);
+	free(lssolver->occ_pool);
+	free(lssolver->unitclause_queue);
+}
+
+//append a clause (formal literals) to the formula, simplified by the fixed variables.
+//returns its clause number.
+int fps_add_clause(FPS *lssolver, const int* lits, int size)
+{
+	int c = lssolver->num_clauses;
+	if(c+2 > lssolver->clause_cap) grow_clause_memory(lssolver,lssolver->clause_cap*2);
+	grow_lit_memory(lssolver,size+1);
+
+	int  beg = lssolver->clause_beg[c] = lssolver->lit_size;
+	int* clause_v = lssolver->clause_var+beg;
+	char* clause_s = lssolver->clause_sense+beg;
+	int  n = 0, v, sense;
+	bool sat = false;
+	for(int i=0; i<size; ++i)
 	{
-		free(lssolver->clause_lit[i]);
+		v = abs(lits[i]);
+		sense = lits[i]>0 ? 1 : 0;
+		if(lssolver->fix[v]==1)
+		{
+			if(lssolver->cur_soln[v]==sense) sat = true;
+			continue;
+		}
+		clause_v[n] = v;
+		clause_s[n] = sense;
+		n++;
 	}
-	
-	for(i=1; i<=lssolver->num_vars; ++i)
+	clause_v[n] = 0;
+	lssolver->lit_size += n+1;
+
+	lssolver->clause_lit_count[c] = n;
+	lssolver->clause_delete[c] = 0;
+	lssolver->num_clauses++;
+	if(sat || n==0) lssolver->clause_delete[c] = 1;
+	else if(n==1)
 	{
-		free(lssolver->var_lit[i]);
+		lit uc;
+		uc.clause_num = c;
+		uc.var_num = clause_v[0];
+		uc.sense = clause_s[0];
+		push_unit(lssolver,uc);
+		lssolver->clause_delete[c] = 1;
 	}
-	
-	free(lssolver->score_inc_vars);
-	free(lssolver->score_inc_flag);
-	free(lssolver->var_lit);
-	free(lssolver->var_lit_count); 
-	free(lssolver->clause_lit); 
-	free(lssolver->clause_lit_count); 
-	free(lssolver->score);
-	free(lssolver->time_stamp);
-	free(lssolver->fix);	
-	free(lssolver->cscc); 
-	free(lssolver->clause_weight);	
-	free(lssolver->sat_count);	
-	free(lssolver->sat_var);		
-	free(lssolver->unsat_stack);	
-	free(lssolver->index_in_unsat_stack);
-	free(lssolver->unsatvar_stack); 
-	free(lssolver->index_in_unsatvar_stack);
-	free(lssolver->unsat_app_count);
-	free(lssolver->goodvar_stack);
-	free(lssolver->already_in_goodvar_stack);
-	free(lssolver->unitclause_queue);
-	free(lssolver->clause_delete);
-	free(lssolver->cur_soln);
-	free(lssolver->best_soln);
-	free(lssolver->conflict_ct);
-	free(lssolver->in_conflict);
-  
-  free(lssolver->cscc2);
-  
-  free(lssolver->sel_cs);
-  free(lssolver->selected);
-  free(lssolver->selected_during_flip);
-  free(lssolver->score2);
-  free(lssolver->scores);
-  free(lssolver->vars2);
-  free(lssolver->goodvar_stack2);
-  free(lssolver->best_vars);
-  
-  free(lssolver->selected_clauses);
-  free(lssolver->selected_times);
-  free(lssolver->sampled_clauses);
-  free(lssolver->clause_score);
+	lssolver->occ_dirty = true;
+	return c;
+}
+
+void fps_delete_clause(FPS *lssolver, int c)
+{
+	if(lssolver->clause_delete[c]==1) return;
+	lssolver->clause_delete[c] = 1;
+	lssolver->occ_dirty = true;
+}
+
+//root units are permanent, so whatever they simplify stays simplified in later calls
+void fps_add_unit(FPS *lssolver, int l)
+{
+	lit uc;
+	uc.clause_num = -1;
+	uc.var_num = abs(l);
+	uc.sense = l>0 ? 1 : 0;
+	if(lssolver->fix[uc.var_num]==1) return;
+	push_unit(lssolver,uc);
+}
+
+void fps_clear_formula(FPS *lssolver)
+{
+	lssolver->num_clauses = 0;
+	lssolver->lit_size = 0;
+	lssolver->formula_len = 0;
+	lssolver->unitclause_queue_beg_pointer = 0;
+	lssolver->unitclause_queue_end_pointer = 0;
+	for(int v=1; v<=lssolver->num_vars; ++v) lssolver->fix[v] = 0;
+	lssolver->occ_dirty = true;
 }
 
 
@@ -149,7 +248,6 @@ void pick_var_FPS(FPS *lssolver)
 {
   int         i,k,c,v;
 	int         best_var;
-	lit*		clause_c;
 	
   lssolver->tabu_step = 1;
  
@@ -204,7 +302,7 @@ void pick_var_FPS(FPS *lssolver)
   int best_vars_num = 0;
   for (i = 0; i < 10; i++){
     lssolver->sel_cs[i] = lssolver->unsat_stack[fps_rand(lssolver,lssolver->unsat_stack_fill_pointer)];
-    lssolver->best_vars[best_vars_num] = lssolver->clause_lit[lssolver->sel_cs[i]][fps_rand(lssolver,lssolver->clause_lit_count[lssolver->sel_cs[i]])].var_num;
+    lssolver->best_vars[best_vars_num] = lssolver->clause_var[lssolver->clause_beg[lssolver->sel_cs[i]]+fps_rand(lssolver,lssolver->clause_lit_count[lssolver->sel_cs[i]])];
     if (lssolver->selected[lssolver->best_vars[best_vars_num]] || lssolver->cscc[lssolver->best_vars[best_vars_num]] == 0){
       lssolver->selected_nums--;
     }
@@ -357,6 +455,7 @@ bool local_search(FPS *lssolver)
 		}
 		if(lssolver->unsat_stack_fill_pointer==0) return true;
 		if(lssolver->mems_left<0 && lssolver->step>1000) return false;
+		if(lssolver->interrupted.load(std::memory_order_relaxed)) return false;
    
     pick_var_FPS(lssolver);
 		//flipvar = pick_var(lssolver);
@@ -380,7 +479,7 @@ inline void unsat(FPS *lssolver, int clause)
 	
 	//update appreance count of each var in unsat clause and update stack of vars in unsat clauses
 	int v;
-	for(lit* p=lssolver->clause_lit[clause]; (v=p->var_num)!=0; p++)
+	for(int* p=lssolver->clause_var+lssolver->clause_beg[clause]; (v=*p)!=0; p++)
 	{	
 		lssolver->unsat_app_count[v]++;
 		if(lssolver->unsat_app_count[v]==1)
@@ -403,7 +502,7 @@ inline void sat(FPS *lssolver, int clause)
 	
 	//update appreance count of each var in unsat clause and update stack of vars in unsat clauses
 	int v,last_unsat_var;
-	for(lit* p=lssolver->clause_lit[clause]; (v=p->var_num)!=0; p++)
+	for(int* p=lssolver->clause_var+lssolver->clause_beg[clause]; (v=*p)!=0; p++)
 	{	
 		lssolver->unsat_app_count[v]--;
 		if(lssolver->unsat_app_count[v]==0)
@@ -464,12 +563,13 @@ void init(FPS *lssolver,char *soln)
 		
 		lssolver->sat_count[c] = 0;
 		
+		int   beg = lssolver->clause_beg[c];
 		for(j=0; j<lssolver->clause_lit_count[c]; ++j)
 		{
-			if (lssolver->cur_soln[lssolver->clause_lit[c][j].var_num] == lssolver->clause_lit[c][j].sense)
+			if (lssolver->cur_soln[lssolver->clause_var[beg+j]] == lssolver->clause_sense[beg+j])
 			{
 				lssolver->sat_count[c]++;
-				lssolver->sat_var[c] = lssolver->clause_lit[c][j].var_num;	
+				lssolver->sat_var[c] = lssolver->clause_var[beg+j];	
 			}
 		}
 
@@ -491,11 +591,12 @@ void init(FPS *lssolver,char *soln)
 
 		lit_count = lssolver->var_lit_count[v];
 		
+		int   beg = lssolver->var_beg[v];
 		for(i=0; i<lit_count; ++i)
 		{
-			c = lssolver->var_lit[v][i].clause_num;
+			c = lssolver->var_clause[beg+i];
 			if (lssolver->sat_count[c]==0) lssolver->score[v]++;
-			else if (lssolver->sat_count[c]==1 && lssolver->var_lit[v][i].sense==lssolver->cur_soln[v]) lssolver->score[v]--;
+			else if (lssolver->sat_count[c]==1 && lssolver->var_sense[beg+i]==lssolver->cur_soln[v]) lssolver->score[v]--;
 		}
 	}
 	
@@ -528,16 +629,20 @@ void flip(FPS *lssolver, int flipvar)
 	int i;
 	int v,c;
 
-	lit* clause_c;
+	int*  clause_v;
+	char* clause_s;
 	
 	int org_flipvar_score = lssolver->score[flipvar];
 	
 	//update related clauses and neighbor vars
 	lssolver->mems_left-=lssolver->var_lit_count[flipvar];
-	for(lit *q = lssolver->var_lit[flipvar]; (c=q->clause_num)>=0; q++)
+	int*  occ_c = lssolver->var_clause+lssolver->var_beg[flipvar];
+	char* occ_s = lssolver->var_sense+lssolver->var_beg[flipvar];
+	for(; (c=*occ_c)>=0; occ_c++, occ_s++)
 	{
-		clause_c = lssolver->clause_lit[c];
-		if(lssolver->cur_soln[flipvar] == q->sense)
+		clause_v = lssolver->clause_var+lssolver->clause_beg[c];
+		clause_s = lssolver->clause_sense+lssolver->clause_beg[c];
+		if(lssolver->cur_soln[flipvar] == *occ_s)
 		{
 			++lssolver->sat_count[c];
 			
@@ -554,7 +659,7 @@ void flip(FPS *lssolver, int flipvar)
 			else if (lssolver->sat_count[c] == 1) // sat_count from 0 to 1
 			{
 				lssolver->sat_var[c] = flipvar;//record the only true lit's var
-				for(lit* p=clause_c; (v=p->var_num)!=0; p++) 
+				for(int* p=clause_v; (v=*p)!=0; p++) 
 				{
 					lssolver->score[v] -= lssolver->clause_weight[c];
 					lssolver->cscc[v] = 1;
@@ -568,9 +673,9 @@ void flip(FPS *lssolver, int flipvar)
 			--lssolver->sat_count[c];
 			if (lssolver->sat_count[c] == 1) //sat_count from 2 to 1
 			{
-				for(lit* p=clause_c; (v=p->var_num)!=0; p++) 
+				for(int k=0; (v=clause_v[k])!=0; k++) 
 				{
-					if(p->sense == lssolver->cur_soln[v] )
+					if(clause_s[k] == lssolver->cur_soln[v] )
 					{
 						lssolver->score[v] -= lssolver->clause_weight[c];
 						lssolver->sat_var[c] = v;
@@ -580,7 +685,7 @@ void flip(FPS *lssolver, int flipvar)
 			}
 			else if (lssolver->sat_count[c] == 0) //sat_count from 1 to 0
 			{
-				for(lit* p=clause_c; (v=p->var_num)!=0; p++) 
+				for(int* p=clause_v; (v=*p)!=0; p++) 
 				{
 					lssolver->score[v] += lssolver->clause_weight[c];
 					lssolver->cscc[v] = 1;
@@ -636,7 +741,8 @@ void flip2(FPS *lssolver, int flipvar)
 	int i;
 	int v,c;
 
-	lit* clause_c;
+	int*  clause_v;
+	char* clause_s;
 	
 	int org_flipvar_score = lssolver->score[flipvar];
 	
@@ -648,10 +754,13 @@ void flip2(FPS *lssolver, int flipvar)
   
 	//update related clauses and neighbor vars
 	lssolver->mems_left-=lssolver->var_lit_count[flipvar];
-	for(lit *q = lssolver->var_lit[flipvar]; (c=q->clause_num)>=0; q++)
+	int*  occ_c = lssolver->var_clause+lssolver->var_beg[flipvar];
+	char* occ_s = lssolver->var_sense+lssolver->var_beg[flipvar];
+	for(; (c=*occ_c)>=0; occ_c++, occ_s++)
 	{
-		clause_c = lssolver->clause_lit[c];
-		if(lssolver->cur_soln[flipvar] == q->sense)
+		clause_v = lssolver->clause_var+lssolver->clause_beg[c];
+		clause_s = lssolver->clause_sense+lssolver->clause_beg[c];
+		if(lssolver->cur_soln[flipvar] == *occ_s)
 		{
 			//++lssolver->sat_count[c];
 			int sc = lssolver->sat_count[c] + 1;
@@ -681,7 +790,7 @@ void flip2(FPS *lssolver, int flipvar)
 			else if (sc == 1) // sat_count from 0 to 1
 			{
 				//lssolver->sat_var[c] = flipvar;//record the only true lit's var
-				for(lit* p=clause_c; (v=p->var_num)!=0; p++) 
+				for(int* p=clause_v; (v=*p)!=0; p++) 
 				{
           vtemp = v;
           if (lssolver->selected[vtemp]){
@@ -707,9 +816,9 @@ void flip2(FPS *lssolver, int flipvar)
       int sc = lssolver->sat_count[c] - 1;
 			if (sc == 1) //sat_count from 2 to 1
 			{
-				for(lit* p=clause_c; (v=p->var_num)!=0; p++) 
+				for(int k=0; (v=clause_v[k])!=0; k++) 
 				{
-					if(p->sense == lssolver->cur_soln[v] )
+					if(clause_s[k] == lssolver->cur_soln[v] )
 					{
             vtemp = v;
             if (lssolver->selected[vtemp]){
@@ -730,7 +839,7 @@ void flip2(FPS *lssolver, int flipvar)
 			}
 			else if (sc == 0) //sat_count from 1 to 0
 			{
-				for(lit* p=clause_c; (v=p->var_num)!=0; p++) 
+				for(int* p=clause_v; (v=*p)!=0; p++) 
 				{
           vtemp = v;
           if (lssolver->selected[vtemp]){
@@ -812,31 +921,72 @@ void flip2(FPS *lssolver, int flipvar)
  */
 }
 
-void update_after_build(FPS *lssolver){
-	int i,c,v;
-	lssolver->avg_clause_len = (double)(lssolver->formula_len+0.0)/lssolver->num_clauses;
-	
-	//creat var literal arrays
+//rebuild the occurrence lists (var_beg/var_clause/var_sense) from the live clauses
+void build_var_lit(FPS *lssolver){
+	int i,c,v,pos,beg;
+	int delete_clause_count=0;
+	int fix_var_count=0;
+	int formula_len=0;
+
 	for (v=1; v<=lssolver->num_vars; ++v)
+		lssolver->var_lit_count[v] = 0;
+
+	lssolver->max_clause_len = 0;
+	lssolver->min_clause_len = lssolver->num_vars;
+	for (c = 0; c < lssolver->num_clauses; ++c)
 	{
-		lssolver->var_lit[v] = (lit*)malloc(sizeof(lit)*(lssolver->var_lit_count[v]+1));
+		if(lssolver->clause_delete[c]==1) {
+			delete_clause_count++;
+			continue;
+		}
+
+		beg = lssolver->clause_beg[c];
+		for(i=0; i<lssolver->clause_lit_count[c]; ++i)
+			++lssolver->var_lit_count[lssolver->clause_var[beg+i]];
+		lssolver->clause_var[beg+i]=0; //clause boundary
+
+		formula_len += lssolver->clause_lit_count[c];
+		if(lssolver->clause_lit_count[c] > lssolver->max_clause_len)
+			lssolver->max_clause_len = lssolver->clause_lit_count[c];
+		if(lssolver->clause_lit_count[c] < lssolver->min_clause_len)
+			lssolver->min_clause_len = lssolver->clause_lit_count[c];
+	}
+	lssolver->formula_len = formula_len;
+	lssolver->avg_clause_len = (double)(formula_len+0.0)/lssolver->num_clauses;
+
+	grow_occ_memory(lssolver,formula_len+lssolver->num_vars+1);
+	for (v=1, pos=0; v<=lssolver->num_vars; ++v)
+	{
+		lssolver->var_beg[v] = pos;
+		pos += lssolver->var_lit_count[v]+1;
 		lssolver->var_lit_count[v] = 0;	//reset to 0, for build up the array
+		if(lssolver->fix[v]==1) fix_var_count++;
 	}
-	//scan all clauses to build up var literal arrays
-	for (c = 0; c < lssolver->num_clauses; ++c) 
+	for (c = 0; c < lssolver->num_clauses; ++c)
 	{
+		if(lssolver->clause_delete[c]==1) continue;
+		beg = lssolver->clause_beg[c];
 		for(i=0; i<lssolver->clause_lit_count[c]; ++i)
 		{
-			v = lssolver->clause_lit[c][i].var_num;
-			lssolver->var_lit[v][lssolver->var_lit_count[v]] = lssolver->clause_lit[c][i];
-			++lssolver->var_lit_count[v];
+			v = lssolver->clause_var[beg+i];
+			pos = lssolver->var_beg[v]+lssolver->var_lit_count[v]++;
+			lssolver->var_clause[pos] = c;
+			lssolver->var_sense[pos] = lssolver->clause_sense[beg+i];
 		}
 	}
 	for (v=1; v<=lssolver->num_vars; ++v) //set boundary
-		lssolver->var_lit[v][lssolver->var_lit_count[v]].clause_num=-1;
-	
-	if(lssolver->unitclause_queue_end_pointer>0) preprocess(lssolver);
+		lssolver->var_clause[lssolver->var_beg[v]+lssolver->var_lit_count[v]]=-1;
+
+	lssolver->fix_var_ct = fix_var_count;
+	lssolver->del_cls_ct = delete_clause_count;
+}
 
+//bring the occurrence lists up to date with the clauses added/deleted since the last call
+//and propagate the pending units.
+void update_after_build(FPS *lssolver){
+	if(lssolver->occ_dirty || lssolver->unitclause_queue_end_pointer>0) build_var_lit(lssolver);
+	if(lssolver->unitclause_queue_end_pointer>0) preprocess(lssolver);
+	lssolver->occ_dirty = false;
 }
 
 
@@ -864,7 +1014,7 @@ void smooth_clause_weights(FPS *lssolver)
 		{
 			for(j=0; j<lssolver->clause_lit_count[c]; ++j)
 			{
-				lssolver->score[lssolver->clause_lit[c][j].var_num] += lssolver->clause_weight[c];
+				lssolver->score[lssolver->clause_var[lssolver->clause_beg[c]+j]] += lssolver->clause_weight[c];
 			}
 		}
 		else  if(lssolver->sat_count[c]==1)
@@ -933,7 +1083,7 @@ void unit_propagation(FPS *lssolver)
     int uc_var;
     bool uc_sense;
     
-    int c;
+    int c,beg;
     int i,j;
     lit cur;
     
@@ -952,27 +1102,25 @@ void unit_propagation(FPS *lssolver)
         
         for(i = 0; i<lssolver->var_lit_count[uc_var]; ++i)
         {
-            cur = lssolver->var_lit[uc_var][i];
-            c = cur.clause_num;
+            c = lssolver->var_clause[lssolver->var_beg[uc_var]+i];
+            cur.sense = lssolver->var_sense[lssolver->var_beg[uc_var]+i];
             
             if(lssolver->clause_delete[c]==1) continue;
             
-            if(cur.sense == uc_sense)//then remove the clause from var's var_lit[] array
+            if(cur.sense == uc_sense)//then remove the clause from var's occurrence list
             {
                 lssolver->clause_delete[c]=1;
             }
             else
             {
+                beg = lssolver->clause_beg[c];
                 if(lssolver->clause_lit_count[c]==2)
                 {
-                    if(lssolver->clause_lit[c][0].var_num == uc_var)
-                    {
-                        lssolver->unitclause_queue[lssolver->unitclause_queue_end_pointer++] = lssolver->clause_lit[c][1];
-                    }
-                    else
-                    {
-                        lssolver->unitclause_queue[lssolver->unitclause_queue_end_pointer++] = lssolver->clause_lit[c][0];
-                    }
+                    j = lssolver->clause_var[beg] == uc_var ? 1 : 0;
+                    cur.clause_num = c;
+                    cur.var_num = lssolver->clause_var[beg+j];
+                    cur.sense = lssolver->clause_sense[beg+j];
+                    push_unit(lssolver,cur);
                     
                     lssolver->clause_delete[c]=1;
                 }
@@ -980,9 +1128,10 @@ void unit_propagation(FPS *lssolver)
                 {
                     for(j=0; j<lssolver->clause_lit_count[c]; ++j)
                     {
-                        if(lssolver->clause_lit[c][j].var_num == uc_var)
+                        if(lssolver->clause_var[beg+j] == uc_var)
                         {
-                            lssolver->clause_lit[c][j]=lssolver->clause_lit[c][lssolver->clause_lit_count[c]-1];
+                            lssolver->clause_var[beg+j]=lssolver->clause_var[beg+lssolver->clause_lit_count[c]-1];
+                            lssolver->clause_sense[beg+j]=lssolver->clause_sense[beg+lssolver->clause_lit_count[c]-1];
     
                             lssolver->clause_lit_count[c]--;
                             
@@ -993,63 +1142,18 @@ void unit_propagation(FPS *lssolver)
             }   
         }   
     }
-    
+    //every queued unit is now recorded in fix[]
+    lssolver->unitclause_queue_beg_pointer = 0;
+    lssolver->unitclause_queue_end_pointer = 0;
 }
 
 void preprocess(FPS *lssolver)
 {
-    int c,v,i;
-    int delete_clause_count=0;
-    int fix_var_count=0;
-    
     unit_propagation(lssolver);
     
     //rescan all clauses to build up var literal arrays
-    for (v=1; v<=lssolver->num_vars; ++v) 
-        lssolver->var_lit_count[v] = 0;
-    
-    lssolver->max_clause_len = 0;
-	lssolver->min_clause_len = lssolver->num_vars;
-    int    formula_len=0;
-    
-    for (c = 0; c < lssolver->num_clauses; ++c) 
-    {
-        if(lssolver->clause_delete[c]==1) {
-            delete_clause_count++;
-            continue;
-        }
-        
-        for(i=0; i<lssolver->clause_lit_count[c]; ++i)
-        {
-            v = lssolver->clause_lit[c][i].var_num;
-            lssolver->var_lit[v][lssolver->var_lit_count[v]] = lssolver->clause_lit[c][i];
-            ++lssolver->var_lit_count[v];
-        }
-        lssolver->clause_lit[c][i].var_num=0; //new clause boundary
-        lssolver->clause_lit[c][i].clause_num = -1;
-        
-        //about clause length
-        formula_len += lssolver->clause_lit_count[c];
-        
-        if(lssolver->clause_lit_count[c] > lssolver->max_clause_len)
-            lssolver->max_clause_len = lssolver->clause_lit_count[c];
-        else if(lssolver->clause_lit_count[c] < lssolver->min_clause_len)
-            lssolver->min_clause_len = lssolver->clause_lit_count[c];
-    }
-    
-    lssolver->avg_clause_len = (double)(formula_len+0.0)/lssolver->num_clauses;
-    
-    for (v=1; v<=lssolver->num_vars; ++v) 
-    {
-    	if(lssolver->fix[v]==1)
-    	{
-    		fix_var_count++;
-    	}
-        lssolver->var_lit[v][lssolver->var_lit_count[v]].clause_num=-1;//new var_lit boundary
-    }
-	lssolver->fix_var_ct = fix_var_count;
-	lssolver->del_cls_ct = delete_clause_count;
-    // printf("c unit propagation fixes %d variables, and deletes %d clauses\n",fix_var_count,delete_clause_count);
+    build_var_lit(lssolver);
+    // printf("c unit propagation fixes %d variables, and deletes %d clauses\n",lssolver->fix_var_ct,lssolver->del_cls_ct);
     
 }
 
@@ -1107,15 +1211,20 @@ int fps_Mersenne_next(fps_randgen* randgen, int bound){
 }
 
 
-void init_FPS(FPS* lssolver){
-	int seed = 1;
-	fps_merseene_init(lssolver,seed);
-	default_initialize(lssolver);
+void init_FPS(FPS* lssolver, int num_vars){
+	lssolver->num_vars = num_vars;
+	lssolver->num_clauses = 0;
+	alloc_memory(lssolver);
+	fps_clear_formula(lssolver);
+	reinit_FPS(lssolver);
 }
 
+//the formula is kept, only the search state is reset
 void reinit_FPS(FPS *lssolver){
-	free_memory(lssolver);
-	init_FPS(lssolver);
+	int seed = 1;
+	fps_merseene_init(lssolver,seed);
+	default_initialize(lssolver);
+	for(int i=1;i<=lssolver->num_vars;++i) lssolver->conflict_ct[i]=0;
 }
 
 void confl_trans(FPS* lssolver){
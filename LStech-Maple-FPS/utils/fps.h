@@ -5,6 +5,7 @@
 #include <stdlib.h>
 #include <math.h>
 #include <stdbool.h>
+#include <atomic>
 #include <sys/times.h> //these two h files are for linux
 #include <unistd.h>
 
@@ -46,6 +47,7 @@ struct FPS{
     int		scale_ave;//scale_ave==ave_weight*q_scale
     int 	q_init;
     long long  mems_left;
+    std::atomic<bool> interrupted;  //set from another thread to stop local_search early
     //cutoff
     int		max_tries;
     int		tries;
@@ -54,11 +56,15 @@ struct FPS{
     int* 	score_inc_vars;
     int* 	score_inc_flag;
     int 	score_inc_count;
-    /* literal arrays */				
-    lit**	var_lit;				//var_lit[i][j] means the j'th literal of var i.
-    int*	var_lit_count;          //amount of literals of each var
-    lit**	clause_lit;		        //clause_lit[i][j] means the j'th literal of clause i.
+    /* literal arrays, CSR layout with separate var/sense arrays */
+    int*	clause_beg;             //literals of clause i are clause_var/clause_sense[clause_beg[i]...], closed by var 0
+    int*	clause_var;
+    char*	clause_sense;           //is 1 for true literals, 0 for false literals.
     int*	clause_lit_count; 	    // amount of literals in each clause		
+    int*	var_beg;                //occurrences of var i are var_clause/var_sense[var_beg[i]...], closed by clause -1
+    int*	var_clause;
+    char*	var_sense;
+    int*	var_lit_count;          //amount of literals of each var
 
     int*	cscc2;
     int   tabu_step;
@@ -126,8 +132,20 @@ struct FPS{
     lit*	unitclause_queue;		
     int		unitclause_queue_beg_pointer;
     int     unitclause_queue_end_pointer;
+    int     unitclause_queue_cap;
     int*    clause_delete;
 
+    /* memory pools, kept between calls: the formula is updated incrementally */
+    char*   var_pool;               //every per-variable array
+    char*   clause_pool;            //every per-clause array
+    int     clause_cap;
+    char*   lit_pool;               //clause_var and clause_sense
+    int     lit_size;
+    int     lit_cap;
+    char*   occ_pool;               //var_clause and var_sense
+    int     occ_cap;
+    bool    occ_dirty;              //the occurrence lists are out of date w.r.t. the clauses
+
     /* Information about solution */
     char*    cur_soln;	//the current solution, with 1's for True variables, and 0's for False variables
     fps_randgen randgen;
@@ -144,10 +162,16 @@ struct FPS{
 };
 
 
-void 	init_FPS(FPS*);
+void 	init_FPS(FPS*,int num_vars);
 void 	reinit_FPS(FPS*);
 void 	confl_trans(FPS*);
 
+// incremental formula
+int     fps_add_clause(FPS*,const int* lits,int size);
+void    fps_delete_clause(FPS*,int c);
+void    fps_add_unit(FPS*,int lit);
+void    fps_clear_formula(FPS*);
+
 
 bool    local_search(FPS*);
 int     build_instance(FPS*,char *filename);
@@ -873,8 +873,10 @@ void Internal::otfs_strengthen_clause (Clause *c, int lit, int new_size,
 }
 
   void Internal::analyze ( ){
-    disable_dip_computation_if_appropriate( );
-    if (opts.diplearning) analyze_dip();
+    if (json_file and opts.jsoninterval and not (stats.conflicts % opts.jsoninterval))
+      json_sample();
+    bool suspended = disable_dip_computation_if_appropriate( );
+    if (opts.diplearning and not suspended) analyze_dip();
     else analyze_1UIP();
   }
   
@@ -1323,12 +1325,16 @@ void Internal::iterate () {
   assert (lrat_chain.empty ());
 
   //cout << "Analyze conflict " << stats.conflicts << endl;
-  vector<int> main_clause, secondary_clause, analyzed_lits;
+  vector<int>& main_clause = dip_buffers.main; // reused between conflicts
+  vector<int>& secondary_clause = dip_buffers.secondary;
+  vector<int>& analyzed_lits = dip_buffers.analyzed;
+  main_clause.clear(), secondary_clause.clear(), analyzed_lits.clear();
   // Secondary clause is ignored for the moment
   bool dip_possible = try_dip_analysis(main_clause,secondary_clause,analyzed_lits);
   //cout << "DIP_possible " << dip_possible << endl;
 
   if (dip_possible) ++stats.dip_conflicts;
+  if (dip_possible and !secondary_clause.empty ()) queue_uip2dip(secondary_clause);
   assert(check_all_literals_cleared());
   assert(check_all_levels_cleared());
   assert(analyzed.empty());
@@ -1339,6 +1345,8 @@ void Internal::iterate () {
   // for (int x : main_clause) cout << x << "(val " << int(val(x)) << ", lev " << var(x).level << ") ";
   // cout << endl;
   int uip = -main_clause[0]; // try_dip_analysis guarantees that
+
+  if (opts.diplearninglevels) dip_lower_levels(main_clause);
   
   // Update glue and learned (1st UIP literals) statistics.
   //
@@ -1348,12 +1356,15 @@ void Internal::iterate () {
   
   int size = (int) clause.size ();
 
-    // We now have levels clear so we neet to recompute glue
-  set<int> tmp_levels;
-  for (int l : clause) {
-    if (val(l)) tmp_levels.insert(var(l).level);
-  }
-  const int glue = (int) tmp_levels.size() - 1;
+  // We now have levels clear so we need to recompute the glue of the clause
+  // which is learned.  Its first literal counts for the conflict level, even
+  // if it is the unassigned extended literal of a DIP clause, which is
+  // implied on this level ('diplearningglue').
+#ifndef NDEBUG
+  for (int i = 1; i < size; ++i) assert(val(clause[i]) < 0);
+#endif
+  int glue = dip_clause_glue(clause) - 1;
+  if (glue and !val(clause[0]) and !opts.diplearningglue) --glue;
 
   assert(check_all_literals_cleared());
   LOG (clause, "1st UIP size %d and glue %d clause", size, glue);
@@ -1424,7 +1435,7 @@ void Internal::iterate () {
   // flipped 1st UIP literal.
   //
   int jump;
-  clause = main_clause;
+  assert(clause[0] == -uip); // substitution keeps the UIP in front
 
   Clause *driving_clause = new_driving_clause (glue, jump); // this sorts so that watch is ok
                                                             // it assumes lit at pos 0 is correctly placed (watched)
@@ -0,0 +1,349 @@
+#include "internal.hpp"
+
+namespace CaDiCaL {
+
+/*------------------------------------------------------------------------*/
+
+// Bounded variable addition as preprocessing.  If for a set of literals
+// 'L = {l1, ..., lm}' and a set of clauses '{C1, ..., Ck}' all the 'm * k'
+// irredundant clauses '(li | Cj)' exist, then these are replaced by the 'k'
+// clauses '(a | Cj)' for the extended variable 'a <-> l1 & ... & lm'.  Its
+// definition needs 'm + 1' more clauses.  This compresses for instance
+// pairwise at-most-one constraints to linear size.
+//
+// The definition is introduced through 'add_extended_and' and thus shared
+// with DIP learning.  Unlike DIP definitions it is used by irredundant
+// clauses and is therefore kept in 'remove_extended'.  As in 'SimpleBVA'
+// the set 'L' is grown greedily starting with the literal popped from a
+// heap ordered by the number of occurrences, as long as the reduction in
+// the number of clauses increases.
+
+/*------------------------------------------------------------------------*/
+
+inline bool bva_more_noccs::operator() (unsigned a, unsigned b) {
+  const int64_t s = internal->noccs (internal->u2i (a));
+  const int64_t t = internal->noccs (internal->u2i (b));
+  if (s < t)
+    return true;
+  if (s > t)
+    return false;
+  return a > b;
+}
+
+struct bva_match_smaller {
+  bool operator() (const BVAMatch &a, const BVAMatch &b) const {
+    return a.other < b.other;
+  }
+};
+
+/*------------------------------------------------------------------------*/
+
+// Only irredundant clauses without assigned literals are considered.  In
+// particular the definitions of extended variables are never replaced.
+
+bool Internal::bva_candidate (Clause *c) {
+  if (c->garbage || c->redundant || c->extended)
+    return false;
+  for (const auto &lit : *c)
+    if (val (lit))
+      return false;
+  return true;
+}
+
+void Internal::bva_connect (VariableAdder &adder, Clause *c) {
+  for (const auto &lit : *c) {
+    occs (lit).push_back (c);
+    noccs (lit)++;
+    const unsigned u = vlit (lit);
+    if (adder.schedule.contains (u))
+      adder.schedule.update (u);
+    else
+      adder.schedule.push_back (u);
+  }
+}
+
+void Internal::bva_remove (VariableAdder &adder, Clause *c) {
+  LOG (c, "bva removing");
+  for (const auto &lit : *c) {
+    assert (noccs (lit) > 0);
+    noccs (lit)--;
+    const unsigned u = vlit (lit);
+    if (adder.schedule.contains (u))
+      adder.schedule.update (u);
+  }
+  mark_garbage (c);
+}
+
+/*------------------------------------------------------------------------*/
+
+// Find all pairs of clauses '(lit | C)' and '(other | C)'.  The second
+// clause is searched in the occurrences of the literal in 'C' with the
+// fewest occurrences.
+
+void Internal::bva_find_matches (VariableAdder &adder, int lit) {
+  adder.candidates.clear ();
+  adder.matches.clear ();
+  for (const auto &c : occs (lit)) {
+    if (adder.steps < 0)
+      break;
+    if (c->garbage)
+      continue;
+    adder.steps--;
+    const unsigned idx = adder.candidates.size ();
+    adder.candidates.push_back (c);
+    int min = 0;
+    for (const auto &tmp : *c) {
+      if (tmp == lit)
+        continue;
+      mark (tmp);
+      if (!min || noccs (tmp) < noccs (min))
+        min = tmp;
+    }
+    assert (min);
+    adder.others.clear ();
+    for (const auto &d : occs (min)) {
+      if (d == c || d->garbage || d->size != c->size)
+        continue;
+      adder.steps--;
+      int other = 0;
+      bool match = true;
+      for (const auto &tmp : *d) {
+        if (marked (tmp) > 0)
+          continue;
+        if (other) {
+          match = false;
+          break;
+        }
+        other = tmp;
+      }
+      if (!match || !other || vidx (other) == vidx (lit))
+        continue;
+      const auto begin = adder.others.begin ();
+      const auto end = adder.others.end ();
+      if (find (begin, end, other) != end)
+        continue;
+      adder.others.push_back (other);
+      adder.matches.push_back ({other, idx, d});
+    }
+    for (const auto &tmp : *c)
+      if (tmp != lit)
+        unmark (tmp);
+  }
+}
+
+// Number of clauses saved by replacing the literals in 'lits' in 'matched'
+// clauses.  Reusing an existing definition saves its 'm + 1' clauses.  A
+// removed DIP definition can not be reused though, which is signalled by
+// a negative result.
+
+int64_t Internal::bva_reduction (VariableAdder &adder, int64_t matched) {
+  const int64_t m = adder.lits.size ();
+  const int a = find_extended_and (adder.lits);
+  if (a && is_var_actively_deleted (abs (a)))
+    return -1;
+  const int64_t cost = a ? 0 : m + 1;
+  return m * matched - matched - cost;
+}
+
+// Try to replace clauses with 'lit' and the set of partner literals with
+// the largest reduction.  Returns 'true' if clauses were replaced.
+
+bool Internal::bva_lit (VariableAdder &adder, int lit) {
+
+  if (val (lit))
+    return false;
+
+  bva_find_matches (adder, lit);
+  auto &matches = adder.matches;
+  if (matches.empty ())
+    return false;
+
+  stable_sort (matches.begin (), matches.end (), bva_match_smaller ());
+
+  auto &current = adder.current;
+  current.assign (adder.candidates.size (), true);
+  auto &lits = adder.lits;
+  lits.clear ();
+  lits.push_back (lit);
+  int64_t reduction = 0;
+
+  // Greedily add the partner literal matching most of the current clauses.
+
+  for (;;) {
+    adder.steps -= matches.size ();
+    int best = 0;
+    int64_t best_size = 0;
+    for (size_t i = 0, j; i < matches.size (); i = j) {
+      const int other = matches[i].other;
+      int64_t size = 0;
+      for (j = i; j < matches.size () && matches[j].other == other; j++)
+        size += current[matches[j].idx];
+      if (size <= best_size)
+        continue;
+      bool fresh = true;
+      for (const auto &tmp : lits)
+        if (vidx (tmp) == vidx (other))
+          fresh = false;
+      if (fresh)
+        best = other, best_size = size;
+    }
+    if (!best)
+      break;
+    lits.push_back (best);
+    const int64_t new_reduction = bva_reduction (adder, best_size);
+    if (new_reduction <= reduction) {
+      lits.pop_back ();
+      break;
+    }
+    reduction = new_reduction;
+    auto &matched_by_best = adder.matched;
+    matched_by_best.assign (current.size (), false);
+    for (const auto &m : matches)
+      if (m.other == best)
+        matched_by_best[m.idx] = true;
+    for (size_t i = 0; i < current.size (); i++)
+      if (!matched_by_best[i])
+        current[i] = false;
+  }
+
+  if (lits.size () < 2)
+    return false;
+
+  // Candidates with a clause removed in the meantime are skipped.
+
+  for (const auto &m : matches)
+    if (current[m.idx] && m.d->garbage &&
+        find (lits.begin () + 1, lits.end (), m.other) != lits.end ())
+      current[m.idx] = false;
+  for (size_t i = 0; i < current.size (); i++)
+    if (adder.candidates[i]->garbage)
+      current[i] = false;
+
+  const bool old = find_extended_and (lits);
+  const int a = add_extended_and (lits);
+  er_manager.keep_definition (-a);
+  if (!old)
+    stats.bva.vars++;
+  LOG ("bva replacing %zd literals by %d with reduction %" PRId64,
+       lits.size (), a, reduction);
+
+  init_occs ();
+  if (ntab.size () < 2 * vsize)
+    ntab.resize (2 * vsize, 0);
+
+  for (const auto &m : matches)
+    if (current[m.idx] &&
+        find (lits.begin () + 1, lits.end (), m.other) != lits.end () &&
+        !m.d->garbage) {
+      bva_remove (adder, m.d);
+      stats.bva.removed++;
+    }
+
+  for (size_t i = 0; i < current.size (); i++) {
+    if (!current[i])
+      continue;
+    Clause *c = adder.candidates[i];
+    assert (clause.empty ());
+    clause.push_back (a);
+    for (const auto &tmp : *c)
+      if (tmp != lit)
+        clause.push_back (tmp);
+    Clause *e = new_derived_clause (false);
+    clause.clear ();
+    bva_connect (adder, e);
+    bva_remove (adder, c);
+    stats.bva.added++;
+    stats.bva.removed++;
+  }
+
+  const unsigned u = vlit (lit);
+  if (!adder.schedule.contains (u))
+    adder.schedule.push_back (u);
+
+  return true;
+}
+
+/*------------------------------------------------------------------------*/
+
+void Internal::bva () {
+
+  if (unsat)
+    return;
+  if (lrat || opts.check)
+    return;
+
+  if (level)
+    backtrack ();
+  if (!propagate ()) {
+    learn_empty_clause ();
+    return;
+  }
+
+  START (bva);
+  stats.bva.count++;
+
+  // Limit the number of occurrence list traversal steps as in 'ternary'.
+  //
+  int64_t steps_limit = stats.propagations.search;
+  steps_limit *= 1e-3 * opts.bvareleff;
+  if (steps_limit < opts.bvamineff)
+    steps_limit = opts.bvamineff;
+  if (steps_limit > opts.bvamaxeff)
+    steps_limit = opts.bvamaxeff;
+
+  PHASE ("bva", stats.bva.count, "limited to %" PRId64 " steps",
+         steps_limit);
+
+  const int64_t vars_before = stats.bva.vars;
+  const int64_t added_before = stats.bva.added;
+  const int64_t removed_before = stats.bva.removed;
+
+  VariableAdder adder (this);
+  adder.steps = steps_limit;
+
+  init_occs ();
+  init_noccs ();
+
+  for (const auto &c : clauses)
+    if (bva_candidate (c))
+      bva_connect (adder, c);
+
+  // Without a literal with at least two occurrences nothing can be
+  // matched, and literals are popped with most occurrences first.
+
+  while (!adder.schedule.empty () && adder.steps >= 0) {
+    if (terminated_asynchronously ())
+      break;
+    const int lit = u2i (adder.schedule.pop_front ());
+    if (noccs (lit) < 2)
+      break;
+    bva_lit (adder, lit);
+  }
+
+  adder.erase ();
+  reset_noccs ();
+  reset_occs ();
+
+  const int64_t vars = stats.bva.vars - vars_before;
+  const int64_t added = stats.bva.added - added_before;
+  const int64_t removed = stats.bva.removed - removed_before;
+
+  PHASE ("bva", stats.bva.count,
+         "added %" PRId64 " variables and replaced %" PRId64
+         " by %" PRId64 " clauses",
+         vars, removed, added);
+
+  // The added variables are never removed and thus should not count
+  // towards the number of extended variables triggering 'remove_extended'.
+
+  lim.delete_ext += vars;
+
+  STOP (bva);
+
+  if (removed)
+    garbage_collection ();
+
+  report ('A', !opts.reportall && !removed);
+}
+
+} // namespace CaDiCaL
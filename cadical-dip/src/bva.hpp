@@ -0,0 +1,55 @@
+#ifndef _bva_hpp_INCLUDED
+#define _bva_hpp_INCLUDED
+
+#include "heap.hpp" // Alphabetically after 'bva.hpp'.
+
+namespace CaDiCaL {
+
+struct Internal;
+
+struct bva_more_noccs {
+  Internal *internal;
+  bva_more_noccs (Internal *i) : internal (i) {}
+  bool operator() (unsigned a, unsigned b);
+};
+
+typedef heap<bva_more_noccs> BVASchedule;
+
+// Two irredundant clauses '(lit | C)' and '(other | C)' found for 'lit',
+// where '(lit | C)' is 'candidates[idx]'.
+
+struct BVAMatch {
+  int other;
+  unsigned idx;
+  struct Clause *d;
+};
+
+class VariableAdder {
+
+  friend struct Internal;
+
+  BVASchedule schedule;       // literals with most occurrences first
+  vector<Clause *> candidates; // clauses with the currently tried literal
+  vector<bool> current;        // candidates matched by all of 'lits'
+  vector<bool> matched;        // candidates matched by the next literal
+  vector<BVAMatch> matches;    // of the currently tried literal
+  vector<int> others;          // already matched for the current clause
+  vector<int> lits;            // replaced literals
+  int64_t steps;               // occurrence list traversal limit
+
+  VariableAdder (Internal *i) : schedule (bva_more_noccs (i)), steps (0) {}
+
+  void erase () {
+    erase_vector (candidates);
+    erase_vector (current);
+    erase_vector (matched);
+    erase_vector (matches);
+    erase_vector (others);
+    erase_vector (lits);
+    schedule.erase ();
+  }
+};
+
+} // namespace CaDiCaL
+
+#endif
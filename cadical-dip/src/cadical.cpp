@@ -146,6 +146,7 @@ void App::print_usage (bool all) {
         "\n"
         "  -o <output>    write simplified CNF in DIMACS format to file\n"
         "  -e <extend>    write reconstruction/extension stack to file\n"
+        "  -j <json>      write statistics as JSON lines to file\n"
 #ifdef LOGGING
         "  -l             enable logging messages (same as '--log')\n"
 #endif
@@ -370,7 +371,7 @@ int App::main (int argc, char **argv) {
   const char *dimacs_path = 0, *proof_path = 0;
   bool proof_specified = false, dimacs_specified = false;
   int optimize = 0, preprocessing = 0, localsearch = 0;
-  const char *output_path = 0, *extension_path = 0;
+  const char *output_path = 0, *extension_path = 0, *json_path = 0;
   int conflict_limit = -1, decision_limit = -1;
   const char *conflict_limit_specified = 0;
   const char *decision_limit_specified = 0;
@@ -435,6 +436,16 @@ int App::main (int argc, char **argv) {
         APPERR ("extension file '%s' not writable", argv[i]);
       else
         extension_path = argv[i];
+    } else if (!strcmp (argv[i], "-j")) {
+      if (++i == argc)
+        APPERR ("argument to '-j' missing");
+      else if (json_path)
+        APPERR ("multiple JSON file options '-j %s' and '-j %s'",
+                json_path, argv[i]);
+      else if (!File::writable (argv[i]))
+        APPERR ("JSON file '%s' not writable", argv[i]);
+      else
+        json_path = argv[i];
     } else if (is_color_option (argv[i])) {
       tout.force_colors ();
       terr.force_colors ();
@@ -681,6 +692,12 @@ int App::main (int argc, char **argv) {
                        tout.green_code (), proof_path, tout.normal_code ());
   } else
     solver->verbose (1, "will not generate nor write DRAT proof");
+  if (json_path) {
+    if (!solver->json_statistics (json_path))
+      APPERR ("can not open and write JSON statistics to '%s'", json_path);
+    solver->message ("writing JSON statistics to %s'%s'%s",
+                     tout.green_code (), json_path, tout.normal_code ());
+  }
   solver->section ("parsing input");
   dimacs_name = dimacs_path ? dimacs_path : "<stdin>";
   string help;
@@ -972,10 +989,12 @@ void App::catch_signal (int sig) {
     solver->resources ();
     solver->message ();
     signal_message ("raising", sig);
+    return;
   }
 #else
   (void) sig;
 #endif
+  solver->statistics (); // only writes JSON statistics if quiet
 }
 
 void App::catch_alarm () {
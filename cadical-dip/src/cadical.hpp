@@ -521,6 +521,28 @@ public:
   //
   void reserve (int min_max_var);
 
+  //------------------------------------------------------------------------
+  // Extension definitions.  Declares the gate 'l1 | ... | lk' respectively
+  // 'l1 & ... & lk' over at least two valid literals on different variables
+  // and returns a literal equivalent to it.  Usually this is a new variable
+  // (the next one after 'vars ()'), or the one returned before for the same
+  // gate.  If literals are already fixed the gate is simplified first and
+  // one of the given literals might be returned instead.
+  //
+  // The variable is handled like the extended variables of DIP learning and
+  // bounded variable addition: its definition clauses are added as derived
+  // extension clauses (in DRAT proofs), it is substituted into learned
+  // clauses and it is garbage collected again if it turns out useless.  A
+  // definition is kept as soon as its literal is used in a clause, an
+  // assumption or a constraint.  Not supported with LRAT proofs and
+  // internal proof checking ('check').
+  //
+  //   require (READY)
+  //   ensure (STEADY )
+  //
+  int define_or (const std::vector<int> &lits);
+  int define_and (const std::vector<int> &lits);
+
 #ifndef NTRACING
   //------------------------------------------------------------------------
   // This function can be used to write API calls to a file.  The same
@@ -819,6 +841,16 @@ public:
   //   ensure (!DELETING)
   //
   void statistics (); // print statistics
+
+  // Write statistics as JSON objects, one per line, to the given file and
+  // return 'true' if it could be opened.  A 'sample' is written every
+  // 'jsoninterval' conflicts (if non-zero) and a 'summary' on each call to
+  // 'statistics'.
+  //
+  //   require (VALID)
+  //   ensure (VALID)
+  //
+  bool json_statistics (const char *path);
   void resources ();  // print resource usage (time and memory)
 
   //   require (VALID)
@@ -972,6 +1004,7 @@ private:
 #endif
 
   void transition_to_steady_state ();
+  void require_valid_definition (const std::vector<int> &);
 
   //------------------------------------------------------------------------
   // Used in the stand alone solver application 'App' and the model based
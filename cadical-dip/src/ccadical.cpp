@@ -111,6 +111,16 @@ int ccadical_simplify (CCaDiCaL *wrapper) {
   return ((Wrapper *) wrapper)->solver->simplify ();
 }
 
+int ccadical_define_or (CCaDiCaL *wrapper, const int *lits, int size) {
+  std::vector<int> def (lits, lits + size);
+  return ((Wrapper *) wrapper)->solver->define_or (def);
+}
+
+int ccadical_define_and (CCaDiCaL *wrapper, const int *lits, int size) {
+  std::vector<int> def (lits, lits + size);
+  return ((Wrapper *) wrapper)->solver->define_and (def);
+}
+
 int ccadical_val (CCaDiCaL *wrapper, int lit) {
   return ((Wrapper *) wrapper)->solver->val (lit);
 }
@@ -52,6 +52,11 @@ int ccadical_frozen (CCaDiCaL *, int lit);
 void ccadical_melt (CCaDiCaL *, int lit);
 int ccadical_simplify (CCaDiCaL *);
 
+// Extension definitions over 'size' literals (see 'Solver::define_or').
+
+int ccadical_define_or (CCaDiCaL *, const int *lits, int size);
+int ccadical_define_and (CCaDiCaL *, const int *lits, int size);
+
 /*------------------------------------------------------------------------*/
 
 // Support legacy names used before moving to more IPASIR conforming names.
@@ -513,7 +513,7 @@ Clause *Internal::new_learned_redundant_clause (int glue) {
 
 // Add definition clause during extended variable addition
 Clause *Internal::new_extended_definition_clause ( ) {
-  assert(clause.size() == 2 or clause.size() == 3);
+  assert(clause.size() >= 2);
   Clause *res = new_clause (false,INT_MAX);
   res->extended = true;
   if (proof) 
@@ -548,6 +548,21 @@ Clause *Internal::new_hyper_ternary_resolved_clause (bool red) {
   return res;
 }
 
+// Add derived and watched clause, e.g., irredundant clauses replacing two
+// clauses during 'bva', binary clauses of XOR constraints in 'xorext' and
+// queued UIP to DIP clauses flushed at level zero.
+//
+Clause *Internal::new_derived_clause (bool red, int glue) {
+  external->check_learned_clause ();
+  Clause *res = new_clause (red, glue);
+  if (proof) {
+    proof->add_derived_clause (res, lrat_chain);
+  }
+  assert (watching ());
+  watch_clause (res);
+  return res;
+}
+
 // Add a new clause with same glue and redundancy as 'orig' but literals are
 // assumed to be in 'clause' in 'decompose' and 'vivify'.
 //
@@ -28,7 +28,18 @@ namespace CaDiCaL {
     out << endl;
   }
 
-  void Internal::writeDIPComputationInfo (TwoVertexBottlenecks& info, DIPGraphEncoder& encoder, const vector<int>& predecessors, const vector<int>& predecessorsLits, const vector<int>& predIndex, const vector<int>& literalsInAnalysis, bool foundDIP, const vector<int>& pathA, const vector<int>& pathB) {
+  // One graph per record in the format read by 'test/dip/dipgraph.hpp':
+  // 'p dip <N> <M>' followed by the N entries of 'predIndex' and the M
+  // entries of 'predecessors'.
+  void Internal::dump_dip_graph (const vector<int>& predecessors, const vector<int>& predIndex) {
+    fprintf(dip_dump, "p dip %zd %zd\n", predIndex.size(), predecessors.size());
+    for (int x : predIndex) fprintf(dip_dump, "%d ", x);
+    fputc('\n', dip_dump);
+    for (int x : predecessors) fprintf(dip_dump, "%d ", x);
+    fputc('\n', dip_dump);
+  }
+
+  void Internal::writeDIPComputationInfo (TwoVertexBottlenecks& info, DIPGraphEncoder& encoder, const vector<int>& predecessors, const vector<int>& predecessorsLits, const vector<int>& predIndex, const vector<int>& literalsInAnalysis, bool foundDIP) {
     cout << endl;
     cout << endl;
     cout << string(60,'=') << endl;
@@ -50,15 +61,15 @@ namespace CaDiCaL {
 
     cout << "Found DIP: " << (foundDIP?"true":"false") << endl;
     
-    vector<TwoVertexBottlenecks::VertPairInfo> listA = info.GetVertListA();
-    vector<TwoVertexBottlenecks::VertPairInfo> listB = info.GetVertListB();
+    const vector<TwoVertexBottlenecks::VertPairInfo>& listA = info.GetVertListA();
+    const vector<TwoVertexBottlenecks::VertPairInfo>& listB = info.GetVertListB();
     
     cout << string(30,'-') << endl;
     cout << "pathA: ";
-    for (int x : pathA) cout << x << " ";
+    for (int x : info.GetPathA()) cout << x << " ";
     cout << endl;
     cout << "pathB: ";
-    for (int x : pathB) cout << x << " ";
+    for (int x : info.GetPathB()) cout << x << " ";
     cout << endl << endl;
     
     cout << "List A: " << endl;
@@ -83,6 +94,15 @@ namespace CaDiCaL {
   Internal::DIPGraphEncoder::DIPGraphEncoder (int nVars ):
     nextVertex(0), _solver2sam(nVars+2,DIP_ENCODER_UNDEF) { }
 
+  // Only the entries of the encoded vertices are reset, so the cost is
+  // linear in the size of the last graph and not in the number of variables.
+  void Internal::DIPGraphEncoder::reset (int nVars) {
+    for (int lit : _sam2solver) _solver2sam[abs(lit)] = DIP_ENCODER_UNDEF;
+    _sam2solver.clear();
+    nextVertex = 0;
+    if ((int) _solver2sam.size() < nVars+2) _solver2sam.resize(nVars+2,DIP_ENCODER_UNDEF);
+  }
+
   inline int Internal::DIPGraphEncoder::numVertices ( )      const { return nextVertex; }
   inline int Internal::DIPGraphEncoder::Sam2Solver (int var) const { return _sam2solver[var]; };
   inline int Internal::DIPGraphEncoder::Solver2Sam (int lit)       {
@@ -153,8 +173,6 @@ namespace CaDiCaL {
     // Stuff for writing the conflict graph (useful for debugging/understanding)
     // Currently the writing is interleaved with the 1UIP computation
     // It might be cleaner to do it separately (but I think that is not a problem for efficiency)
-    string filename1 = "graph-"+to_string(stats.conflicts) + ".dot"; //conflict graph
-    string filename2 = "graph-current-"+to_string(stats.conflicts) + ".dot"; // conflict graph with only last-DL lits
     ofstream outAll;
     ofstream outCurrent;
     set<int> currentNodes;
@@ -164,6 +182,8 @@ namespace CaDiCaL {
     // bool write = stats.conflicts == 6730533; // To write conflict graph only of a concrete conflict
 #define write 0// quicker for release mode
     if (write) {
+      string filename1 = "graph-"+to_string(stats.conflicts) + ".dot"; //conflict graph
+      string filename2 = "graph-current-"+to_string(stats.conflicts) + ".dot"; // conflict graph with only last-DL lits
       outAll.open(filename1.c_str(),fstream::out);
       outCurrent.open(filename2.c_str(),fstream::out);
       outAll << "digraph D {" << endl;
@@ -171,10 +191,13 @@ namespace CaDiCaL {
     }
 
     // Data structure for generating correct input for DIP-detection algorithm
-    DIPGraphEncoder encoder(max_var);
-    vector<int> predecessorsLits; // only needed for DIP-detection algorithm
-    vector<int> predIndex; // only needed for DIP-detection algorithm
-    vector<int> literalsInAnalysis; // only needed for DIP-detection algorithm
+    // (all of them are reused between conflicts, see 'dip_buffers')
+    DIPGraphEncoder& encoder = dip_encoder;
+    encoder.reset(max_var);
+    vector<int>& predecessorsLits = dip_buffers.pred_lits; // only needed for DIP-detection algorithm
+    vector<int>& predIndex = dip_buffers.pred_index; // only needed for DIP-detection algorithm
+    vector<int>& literalsInAnalysis = dip_buffers.analysis; // only needed for DIP-detection algorithm
+    predecessorsLits.clear(), predIndex.clear(), literalsInAnalysis.clear();
     // The latter stores the literals as they have appeared in the analysis (inverse topological order)
     // This will allow us to assign numbers respecting the order (the algorithm needs this)
     // Remember that conflict node is the sink (node 0), and the 1UIP is the source (node with largest N)
@@ -276,7 +299,8 @@ namespace CaDiCaL {
     }
 
     
-    vector<int> UIP_clause = clause;
+    vector<int>& UIP_clause = dip_buffers.uip_clause;
+    UIP_clause = clause;
     analyzed_lits = analyzed;
     
     if (write) {
@@ -297,18 +321,19 @@ namespace CaDiCaL {
     // 1UIP clause has been computed and is now stored in UIP_clase
     // We now start the DIP computation
     
-    vector<int> predecessors;
+    vector<int>& predecessors = dip_buffers.predecessors;
+    predecessors.clear();
     for (auto lit : literalsInAnalysis) encoder.Solver2Sam(lit); // encode in topological order
     for (auto lit : predecessorsLits) predecessors.push_back(encoder.Solver2Sam(lit)); // map vector<int> to vec<int>
 
-    TwoVertexBottlenecks dip;
-    vector<int> pathA, pathB; // the two disjoint paths
-    int res = dip.CalcBottlenecks(predecessors,predIndex,pathA,pathB);
+    if (dip_dump) dump_dip_graph(predecessors,predIndex);
+    TwoVertexBottlenecks& dip = dip_bottlenecks; // reused, keeps its buffers between conflicts
+    int res = dip.CalcBottlenecks(predecessors,predIndex);
     
     bool foundDIP =  (res > 0);
     if (foundDIP) ++stats.dip_exists;
       
-    //if (write) writeDIPComputationInfo(dip,encoder,predecessors,predecessorsLits,predIndex,literalsInAnalysis,foundDIP,pathA,pathB);
+    //if (write) writeDIPComputationInfo(dip,encoder,predecessors,predecessorsLits,predIndex,literalsInAnalysis,foundDIP);
 
     if (foundDIP) {
       res -=4;
@@ -316,14 +341,25 @@ namespace CaDiCaL {
       res/=2;
       int a = res;     
       
-      vector<int> lits_to_bump;
+      vector<int>& lits_to_bump = dip_buffers.lits_to_bump;
 
       // So far we are ignoring clause uip2dip
-      bool ok = computeDIPClauses(a,b,conflict,dip,encoder,dip2conflict,uip2dip,uip,pathA, pathB, lits_to_bump);
+      bool ok = computeDIPClauses(a,b,conflict,dip,encoder,dip2conflict,uip2dip,uip,lits_to_bump);
+
+      // Reward the adaptive strategy by the glue saved by the DIP clause
+      if (dip_control.bandit.pending) {
+	double reward = 0;
+	if (ok) {
+	  const int uip_glue = dip_clause_glue(UIP_clause);
+	  const int dip_glue = dip_clause_glue(dip2conflict);
+	  reward = min(1.0, max(0.0, double(uip_glue - dip_glue + 1)/(uip_glue + 1)));
+	}
+	dip_control.bandit.update(reward);
+      }
       assert(check_all_literals_cleared());
       assert(check_all_levels_cleared());
       if (ok) {
-	analyzed_lits = lits_to_bump;
+	swap(analyzed_lits,lits_to_bump);
 	return true;
       }
       else {
@@ -341,7 +377,7 @@ namespace CaDiCaL {
   }
 
 
-  bool Internal::computeClosestDIPToConflict (int a, int b, TwoVertexBottlenecks& info, const DIPGraphEncoder& encoder, int& x, int& y) {
+  bool Internal::computeClosestDIPToConflict (int a, int b, const TwoVertexBottlenecks& info, const DIPGraphEncoder& encoder, int& x, int& y) {
     const vector<TwoVertexBottlenecks::VertPairInfo>& listA = info.GetVertListA();
     
     // a == 1 if the first element of VertPairListA is an immediate ancestor of the conflict node
@@ -374,22 +410,23 @@ namespace CaDiCaL {
     return true;
   }
 
-  bool Internal::computeRandomDIP (int a, int b, TwoVertexBottlenecks& info, const DIPGraphEncoder& encoder, int& x, int& y) {
+  bool Internal::computeRandomDIP (int a, int b, const TwoVertexBottlenecks& info, const DIPGraphEncoder& encoder, int& x, int& y) {
     // a == 1 if the first element of VertPairListA is an immediate ancestor of the conflict node
     // b == 1 if the first element of VertPairListB is an immediate ancestor of the conflict node
     
-    vector<TwoVertexBottlenecks::VertPairInfo> listA = info.GetVertListA();
+    const vector<TwoVertexBottlenecks::VertPairInfo>& listA = info.GetVertListA();
     int idxA;
     if (a == 1) {
       if (listA.size() == 1) return false;
-      else idxA = rand()%(listA.size()-1) + 1;
+      else idxA = dip_control.pick(listA.size()-1) + 1;
     }
-    else idxA = rand()%listA.size();
+    else idxA = dip_control.pick(listA.size());
     
     x = encoder.Sam2Solver(listA[idxA].vertNum);
     
-    vector<TwoVertexBottlenecks::VertPairInfo> listB = info.GetVertListB();  
-    vector<int> candidatesY;
+    const vector<TwoVertexBottlenecks::VertPairInfo>& listB = info.GetVertListB();  
+    vector<int>& candidatesY = dip_buffers.candidates_y;
+    candidatesY.clear();
     for (uint i = 0; i < listB.size(); ++i){
       if (b == 1 and i == 0) continue;
       if (listA[idxA].minPair <= listB[i].vertNum and
@@ -403,13 +440,15 @@ namespace CaDiCaL {
     }
     
     if (candidatesY.size() == 0) return false;
-    y = candidatesY[rand()%candidatesY.size()];
+    y = candidatesY[dip_control.pick(candidatesY.size())];
     
     return true;
   }
   
-  bool Internal::computeBestMiddleDIP (const TwoVertexBottlenecks& info, const DIPGraphEncoder& encoder, const vector<int>& pathA, const vector<int>& pathB, int& x, int& y) {
+  bool Internal::computeBestMiddleDIP (const TwoVertexBottlenecks& info, const DIPGraphEncoder& encoder, int& x, int& y) {
     
+    const vector<int>& pathA = info.GetPathA();
+    const vector<int>& pathB = info.GetPathB();
     if (pathA.size() <= 3 and pathB.size() <= 3) return false; // does not seem interesting
   
     
@@ -429,37 +468,19 @@ namespace CaDiCaL {
     const vector<TwoVertexBottlenecks::VertPairInfo>& longestList = (pathA.size() > pathB.size() ? listA : listB);
     const vector<TwoVertexBottlenecks::VertPairInfo>& shortestList = (pathA.size() > pathB.size() ? listB : listA);
     
-    // First we compute the position in the path of each vertex of the lists (which are the DIP candidates)
-    // For every k, posInLongestPath[k] = p  iff vertex longestList[k].vertNum appears in longestPath[p]
-    // similarly for shortest
-    vector<int> posInLongestPath(longestList.size());
-    vector<int> posInShortestPath(shortestList.size());
-    
-    // Remember that pathA, pathB both start with the 1UIP (largest vertex) and finish with the conflict (vertex 0).
-    // We know that both paths are strictly ordered from large to small
-    // However, note that longest/shortest List are ordered strictly from smaller to larger
-    for (uint i = 0, j = longestPath.size() - 1; i < longestList.size(); ++i) {
-      while (longestPath[j] != longestList[i].vertNum) --j;
-      posInLongestPath[i] = j;
-      //cout << "Pos of " << longestList[i].vertNum << " in longestPath is " << j << endl;
-    }
-    
-    for (uint i = 0, j = shortestPath.size() - 1; i < shortestList.size(); ++i) {
-      while (shortestPath[j] != shortestList[i].vertNum) --j;
-      posInShortestPath[i] = j;
-      //cout << "Pos of " << shortestList[i].vertNum << " in shortestPath is " << j << endl;
-    }
+    // The position of each DIP candidate in its path is given by pathPos
+    // (paths start with the 1UIP and finish with the conflict, vertex 0).
     
     int medianLongest = longestPath.size()/2;
     int medianShortest = shortestPath.size()/2;
     
     // We know that the longest path has size >= 3 (we have returned false otherwise)  
     int idxLongest = 0;
-    int longestDistToMedian  = abs(medianLongest - posInLongestPath[0]);
+    int longestDistToMedian  = abs(medianLongest - longestList[0].pathPos);
     // Look for the one closest to the middle (DIP_A in the description)
     uint k = 1;
-    while (k < posInLongestPath.size() and longestDistToMedian > 0) {
-      int dist = abs(medianLongest - posInLongestPath[k]);
+    while (k < longestList.size() and longestDistToMedian > 0) {
+      int dist = abs(medianLongest - longestList[k].pathPos);
       if (dist < longestDistToMedian) {
 	longestDistToMedian = dist;
 	idxLongest = k;
@@ -467,7 +488,7 @@ namespace CaDiCaL {
       ++k;
     }
     
-    //cout << "For longest we choose DIP " << longestList[idxLongest].vertNum << " at position " << posInLongestPath[idxLongest] << endl;
+    //cout << "For longest we choose DIP " << longestList[idxLongest].vertNum << " at position " << longestList[idxLongest].pathPos << endl;
     
     // minV and maxV tell that any number inside [minV, maxV] is DIP-compatible with DIP_A
     int minV = longestList[idxLongest].minPair;
@@ -477,9 +498,9 @@ namespace CaDiCaL {
     int shortestDistToMedian = 1e9;
     
     k = 0;
-    while (k < posInShortestPath.size() and shortestDistToMedian > 0) {
+    while (k < shortestList.size() and shortestDistToMedian > 0) {
       if (shortestList[k].vertNum < minV or shortestList[k].vertNum > maxV) {++k; continue;}
-      int dist = abs(medianShortest - posInShortestPath[k]);
+      int dist = abs(medianShortest - shortestList[k].pathPos);
       if (dist < shortestDistToMedian) {
 	shortestDistToMedian = dist;
 	idxShortest = k;
@@ -492,11 +513,11 @@ namespace CaDiCaL {
     //   return false; 
     // }
     
-    //cout << "For shortest we choose DIP " << shortestList[idxShortest].vertNum << " at position " << posInShortestPath[idxShortest] << endl;
+    //cout << "For shortest we choose DIP " << shortestList[idxShortest].vertNum << " at position " << shortestList[idxShortest].pathPos << endl;
     
     
-    if (posInShortestPath[idxShortest] == int(shortestPath.size()) - 2 and
-	posInLongestPath[idxLongest] == int(longestPath.size()) - 2)
+    if (shortestList[idxShortest].sinkDist == 1 and
+	longestList[idxLongest].sinkDist == 1)
       {
 	//cout << "TWO IMMEDIATE ANCESTORS" << endl;
 	return false;}
@@ -509,7 +530,15 @@ namespace CaDiCaL {
     
   }
 
-  bool Internal::computeDIPClauses (int a, int b, Clause* confl, TwoVertexBottlenecks& info, const DIPGraphEncoder& encoder, vector<int>& clause_to_learn, vector<int>& clause_to_learn2, int uip, vector<int>& pathA, vector<int>& pathB, vector<int>& lits_to_bump) {
+  bool Internal::select_DIP (int dip_type, int a, int b, const TwoVertexBottlenecks& info, const DIPGraphEncoder& encoder, int& x, int& y) {
+    if (dip_type == DIPController::MIDDLE) return computeBestMiddleDIP(info,encoder,x,y);
+    else if (dip_type == DIPController::CLOSEST) return computeClosestDIPToConflict(a,b,info,encoder,x,y);
+    else if (dip_type == DIPController::RANDOM) return computeRandomDIP(a,b,info,encoder,x,y);
+    assert(false);
+    return false;
+  }
+
+  bool Internal::computeDIPClauses (int a, int b, Clause* confl, const TwoVertexBottlenecks& info, const DIPGraphEncoder& encoder, vector<int>& clause_to_learn, vector<int>& clause_to_learn2, int uip, vector<int>& lits_to_bump) {
     assert(clause.empty());
     assert(check_all_levels_cleared());
     assert(check_all_literals_cleared());
@@ -520,21 +549,11 @@ namespace CaDiCaL {
     int x, y; // {x,y} are a DIP
     // 3 DIP computations: random, closest to conflict, the one in the middle
 
-    bool dip_found = false;
-    static const int MIDDLE_DIP = 1;
-    static const int CLOSEST_TO_CONFLICT = 2;
-    static const int RANDOM_DIP = 3;
-
-    int dip_type = MIDDLE_DIP;
-    //int dip_type = CLOSEST_TO_CONFLICT;
-    // int dip_type = RANDOM_DIP;
+    int dip_type = opts.diplearningtype;
+    if (dip_type == DIPController::ADAPTIVE)
+      dip_type = DIPController::MIDDLE + dip_control.bandit.choose();
   
-    if (dip_type == MIDDLE_DIP) dip_found = computeBestMiddleDIP(info,encoder,pathA,pathB,x,y);
-    else if (dip_type == CLOSEST_TO_CONFLICT) dip_found = computeClosestDIPToConflict(a,b,info,encoder,x,y);
-    else if (dip_type == RANDOM_DIP) dip_found = computeRandomDIP(a,b,info,encoder,x,y);
-    else assert(false);
-
-    if (not dip_found) return false;
+    if (not select_DIP(dip_type,a,b,info,encoder,x,y)) return false;
     
     // cout << endl << endl;
     if (write) {
@@ -546,7 +565,7 @@ namespace CaDiCaL {
 
     //cout << "DIP: " << x << " " << y << endl;
     
-    if (occurrences_DIP(x,y) < 20) return false;
+    if (occurrences_DIP(x,y) < (unsigned) opts.diplearningmin) return false;
 
     int ext_var = er_manager.find_definition(-x,-y);
 
@@ -660,10 +679,10 @@ namespace CaDiCaL {
     //   solver.proofLogger.addClause(ERClause);
     // }
 
-    return true;
-
-    // This part is not (100%) ready yet. However, the best result in xMapleLCM did not include this,
-    // so this is not urgent to incoporate
+    // The best result in xMapleLCM did not include the second clause, so it
+    // is only computed with 'diplearninguip2dip' (and then added in batches
+    // at the next restart, see 'flush_uip2dip').
+    if (not opts.diplearninguip2dip or lrat) return true;
     
     // 3) UIP ^ before --> DIP
     // This is done as standard 1UIP but starting with the two DIP lits being marked
@@ -698,6 +717,7 @@ namespace CaDiCaL {
       reason = var(p).reason;
       assert (reason != external_reason);      
     }
+    assert(p == uip);
 
     clause_to_learn2 = clause;
     clause_to_learn2[0] = -uip; // UIP
@@ -718,102 +738,347 @@ namespace CaDiCaL {
     return true;
   }
 
+  // Replaces the literals l1, ..., lk of a definition z <--> l1 v ... v lk
+  // by z if all of them occur in 'clause' after the UIP and z is false at
+  // a previous level.  If z is already in the clause the literals are just
+  // removed.  Literals of 'clause' are marked.  A true z is possible if the
+  // clause z -> l1 v ... v lk was removed and would make the learned clause
+  // non-falsified.
+  bool Internal::substitute_definition_in_clause (int def) {
+    const vector<int>& lits = er_manager.expand_definition(def);
+    if (lits.empty()) return false; // definition deleted
+    if (val(def) >= 0) return false;
+    if (var(def).level == level) return false;
+    if (marked(def) < 0) return false; // tautology
+    for (int l : lits)
+      if (l == clause[0] or marked(l) <= 0) return false;
+    // def is defined at some previous level
+
+    for (int l : lits) {
+      assert(val(l) < 0);
+      unmark(l);
+    }
+    const bool def_found = marked(def) > 0;
+    uint j = 1;
+    for (uint i = 1; i < clause.size(); ++i)
+      if (marked(clause[i]) > 0) clause[j++] = clause[i];
+    clause.resize(j);
+    if (not def_found) {
+      clause.push_back(def);
+      mark(def);
+    }
+    stats.dip_substituted += lits.size() - !def_found;
+    return true;
+  }
+
   void Internal::substitute_definitions_in_clause ( ){
     // PRE: UIP is in the first position
-    
-    for (uint i = 1; i < clause.size(); ++i) {
-      if (not er_manager.part_of_definition(clause[i])) continue;
-      for (uint j = i + 1; j < clause.size(); ++j) {
-	if (not er_manager.part_of_definition(clause[j])) continue;
-	int def = er_manager.find_definition(clause[i], clause[j]);
-	if (def != 0){
-	  assert(val(clause[i]) < 0);
-	  assert(val(clause[j]) < 0);
-	  if (val(def) == 0) continue;
-	  if (var(def).level == level) continue;
-	  // def is defined at some previous level
-	  
-	   // cout << "Found at level " << level << " -- " << clause[i] << "(pos " << i << ") and " << clause[j] << "(pos " << j << ") that are part of definition " << er_manager.find_definition(clause[i],clause[j]) << endl;
-	   // cout << "Clause is: ";
-	   // for (int x : clause) 
-	   //   cout << x << "(val " << int(val(x)) << ", lev " << var(x).level << ") ";
-	   // cout << endl;
-
-
-	   bool tautology = false;
-	   int  def_found = -1;
-	   for (uint k = 0; k < clause.size(); ++k){
-	     int x = clause[k];
-	     if (x == -def) tautology = true;
-	     if (x == def) def_found = k;
-	   }
-	   
-	   if (tautology) continue;
-	   
-	   vector<int> orig_clause = clause;
-      
-	     
-	   if (def_found != -1) { // Remove positions i and j
-	     clause[i] = clause.back(); clause.pop_back();
-	     clause[j] = clause.back(); clause.pop_back();
-	   }
-	   else {
-	     clause[i] = def;	 
-	     clause[j] = clause.back();
-	     clause.pop_back();
-	   }
-	   
+
+    for (int l : clause) mark(l);
+    bool changed = true;
+    while (changed) {
+      changed = false;
+      for (uint i = 1; not changed and i < clause.size(); ++i) {
+	if (not er_manager.part_of_definition(clause[i])) continue;
+	for (int def : er_manager.definitions_with(clause[i]))
+	  if (substitute_definition_in_clause(def)) { changed = true; break; }
+      }
+    }
+    for (int l : clause) unmark(l);
+
 #ifndef NDEBUG
-	   set<int> lits;
-	   for (int x : clause) {
-	     if (lits.count(x) != 0) {
-	       cout << "Repetit " << x << ": ";
-	       for (int y : clause) cout << y << " ";
-	       cout << endl;
-	       assert(false);
-	     }
-	     lits.insert(x);
-	   }
+    set<int> lits;
+    for (int x : clause) {
+      assert(lits.count(x) == 0 and lits.count(-x) == 0);
+      lits.insert(x);
+    }
 #endif
-	   // cout << "After substitution (level " << level << "): ";
-	   // for (int x : clause) cout << x << "(val " << int(val(x)) << ", lev " << var(x).level << ") ";
-	   // cout << endl << endl;
-	   
-	   // if (val(def) >= 0) {
-	   //   cout << "We are at DL " << level << endl;
-	   //   for (auto c : clauses){
-	   //     for (auto it = c->begin(); it != c->end(); ++it)
-	   // 	cout << *it << " (val " << int(val(*it)) << ", lev " << var(*it).level << ") ";
-	   //     cout << endl;
-	   //   }
-	   // }
-	   
-	   //clause = orig_clause;
-	   //return;
-	}
+  }
+
+  // Multi-level DIP learning ('diplearninglevels').  The literals of the
+  // learned clause 'c' on a lower level L are the sinks of the implication
+  // graph of level L, whose source is the first UIP of that level.  If
+  // this graph has a DIP {x,y}, the literals on level L are resolved back
+  // to -x and -y, which are then replaced by z <--> -x v -y.  As in
+  // shrinking, this is only done if no new level is added to the clause
+  // and the clause gets shorter.  Since x and y are true, z is false at
+  // level L (or below).  A new z is assigned out-of-order on level L and
+  // thus this requires chronological backtracking.
+
+  void Internal::dip_lower_levels (vector<int>& c) {
+    assert(levels.empty());
+    for (uint i = 1; i < c.size(); ++i) {
+      const int lvl = var(c[i]).level;
+      assert(lvl < level);
+      if (!control[lvl].seen.count++) levels.push_back(lvl);
+    }
+
+    // The levels with most literals in the clause first.
+    vector<pair<int,int>>& candidates = dip_buffers.candidates;
+    candidates.clear();
+    for (int lvl : levels)
+      if (control[lvl].seen.count >= 3) candidates.push_back({control[lvl].seen.count,lvl});
+    sort(candidates.rbegin(), candidates.rend());
+    if ((int) candidates.size() > opts.diplearninglevels)
+      candidates.resize(opts.diplearninglevels);
+
+    for (auto cand : candidates)
+      if (dip_lower_level(c,cand.second)) ++stats.dip_levels;
+
+    clear_analyzed_levels();
+  }
+
+  bool Internal::dip_lower_level (vector<int>& c, int L) {
+    assert(clause.empty());
+    assert(analyzed.empty());
+
+    // 1) Implication graph of level L as in 'try_dip_analysis' but with the
+    // literals of 'c' on level L as predecessors of the sink.
+
+    vector<int>& predecessorsLits = dip_buffers.pred_lits;
+    vector<int>& predIndex = dip_buffers.pred_index;
+    vector<int>& literalsInAnalysis = dip_buffers.analysis;
+    predecessorsLits.clear(), predIndex.clear(), literalsInAnalysis.clear();
+    literalsInAnalysis.push_back(max_var + 1); // Fake literal corresponding to sink
+    predIndex.push_back(0);
+    int open = 0;
+    int i = 0;
+    for (uint k = 1; k < c.size(); ++k) {
+      const int lit = c[k];
+      if (var(lit).level != L) continue;
+      flags(lit).seen = true;
+      analyzed.push_back(lit);
+      predecessorsLits.push_back(-lit);
+      i = max(i, var(lit).trail + 1);
+      ++open;
+    }
+    const int sinks = open;
+    assert(sinks >= 3);
+
+    bool ok = true;
+    for (;;) {
+      int uip = 0;
+      while (!uip) {
+	assert (i > 0);
+	const int lit = trail[--i];
+	if (flags(lit).seen and var(lit).level == L) uip = lit;
       }
-      
+      literalsInAnalysis.push_back(uip);
+      predIndex.push_back(predecessorsLits.size());
+      if (!--open) break;
+      if ((int) literalsInAnalysis.size() > opts.diplearninglevelsize) { ok = false; break; }
+      Clause* reason = var(uip).reason;
+      assert(reason and reason != external_reason);
+      for (int other : *reason) {
+	if (other == uip or var(other).level != L) continue;
+	predecessorsLits.push_back(-other);
+	if (flags(other).seen) continue;
+	flags(other).seen = true;
+	analyzed.push_back(other);
+	++open;
+      }
+    }
+    clear_analyzed_literals();
+    if (not ok) return false;
+
+    DIPGraphEncoder& encoder = dip_encoder;
+    encoder.reset(max_var);
+    vector<int>& predecessors = dip_buffers.predecessors;
+    predecessors.clear();
+    for (auto lit : literalsInAnalysis) encoder.Solver2Sam(lit); // encode in topological order
+    for (auto lit : predecessorsLits) predecessors.push_back(encoder.Solver2Sam(lit));
+
+    TwoVertexBottlenecks& dip = dip_bottlenecks;
+    int res = dip.CalcBottlenecks(predecessors,predIndex);
+    if (res <= 0) return false;
+    res -= 4;
+    int b = res%2;
+    res /= 2;
+    int a = res;
+
+    int dip_type = opts.diplearningtype;
+    if (dip_type == DIPController::ADAPTIVE) dip_type = DIPController::MIDDLE; // bandit only rewards the current level
+    int x, y;
+    if (not select_DIP(dip_type,a,b,dip,encoder,x,y)) return false;
+    assert(val(x) > 0 and var(x).level == L);
+    assert(val(y) > 0 and var(y).level == L);
+
+    notify_DIP(x,y);
+    if (occurrences_DIP(x,y) < (unsigned) opts.diplearningmin) return false;
+
+    int z = er_manager.find_definition(-x,-y);
+    if (z) {
+      if (is_var_actively_deleted(z) or val(z) > 0) return false;
+      if (val(z) < 0 and var(z).level > L) return false;
+      if (val(z) < 0 and var(z).level < L and
+	  !control[var(z).level].seen.count) return false; // new level
+    }
+    if ((not z or not val(z)) and not opts.chrono) return false;
+
+    // 2) Resolve the literals on level L back to -x and -y.  Literals on
+    // lower levels are collected in 'clause'.
+
+    for (uint k = 1; k < c.size(); ++k) {
+      const int lit = c[k];
+      flags(lit).seen = true;
+      analyzed.push_back(lit);
+      if (var(lit).level == L) {
+	i = max(i, var(lit).trail + 1);
+	++open;
+      }
+    }
+    int reached = 0;
+    while (ok and open) {
+      int p = 0;
+      while (!p) {
+	assert (i > 0);
+	const int lit = trail[--i];
+	if (flags(lit).seen and var(lit).level == L) p = lit;
+      }
+      --open;
+      if (p == x or p == y) { ++reached; continue; }
+      Clause* reason = var(p).reason;
+      if (not reason) { ok = false; break; }
+      assert(reason != external_reason);
+      for (int other : *reason) {
+	if (other == p) continue;
+	const Var& v = var(other);
+	if (!v.level or flags(other).seen) continue;
+	flags(other).seen = true;
+	analyzed.push_back(other);
+	if (v.level == L) ++open;
+	else if (!control[v.level].seen.count) { ok = false; break; } // new level
+	else clause.push_back(other);
+      }
+      if (int(clause.size()) + 1 >= sinks) ok = false; // not shorter
     }
+    clear_analyzed_literals();
+    vector<int>& added = dip_buffers.added;
+    added.clear();
+    swap(added,clause);
+    if (not ok or reached != 2) return false;
+
+    // 3) Replace the literals on level L by z.
+
+    if (not z) z = add_extended_var(-x,-y);
+    if (not val(z)) {
+      Clause* reason = find_long_extended_clause({-z,-x,-y});
+      if (not reason) return false;
+      search_assign_driving(-z,reason); // out-of-order on level L
+    }
+    assert(val(z) < 0 and var(z).level <= L);
+
+    uint j = 1;
+    for (uint k = 1; k < c.size(); ++k)
+      if (var(c[k]).level != L) c[j++] = c[k];
+    c.resize(j);
+    control[L].seen.count = 0;
+    if (find(c.begin() + 1, c.end(), z) == c.end()) {
+      c.push_back(z);
+      ++control[var(z).level].seen.count;
+    }
+    for (int lit : added) {
+      c.push_back(lit);
+      ++control[var(lit).level].seen.count;
+    }
+    return true;
   }
 
-  void Internal::disable_dip_computation_if_appropriate ( ) {
-    static bool some_very_high = false;
-    static bool some_evaluation = false;
-    static vector<double> window;  
-    if (opts.diplearning and not some_very_high) {
-      if (stats.conflicts%10000 == 9999) {
-	window.push_back(double(stats.dip_decision)/stats.decisions*100);
-	if ((not some_evaluation and window.size() == 20) or (some_evaluation and window.size() == 10)) {
-	  some_evaluation = true;
-	  /*cout << "Window full" << endl;*/
-	  if (window.back() >= 5) {/*cout << "Some very high" << endl;*/ some_very_high = true;}
-	  if (some_very_high or
-	      (window.back() - window[0] > 0)) {/*cout << "Continue" << endl;*/}
-	  else {/*cout << "Deactivate" << endl;*/ opts.diplearning = false;}
-	  window.clear();
-	}
+  // UIP -> DIP clauses are not needed for the current conflict.  Instead of
+  // allocating and watching them during conflict analysis they are queued
+  // and added together at the next restart or reduction.  The clause is added to the
+  // proof right away, since its derivation might depend on clauses which
+  // are deleted until then.
+
+  void Internal::queue_uip2dip (const vector<int>& c) {
+    assert(c.size() >= 2);
+    uint64_t id = 0;
+    if (proof) {
+      id = ++clause_id;
+      proof->add_derived_clause(id,true,c,lrat_chain);
+    }
+    dip_uip2dip_queue.push_back({id,dip_clause_glue(c,2)});
+    dip_uip2dip.insert(dip_uip2dip.end(),c.begin(),c.end());
+    dip_uip2dip.push_back(0);
+    ++stats.dip_uip2dip;
+  }
+
+  // The queued clauses are added at level zero.  Clauses with eliminated
+  // variables or removed extended variables are dropped, and so are
+  // satisfied ones, while units are assigned and an empty clause makes the
+  // formula unsatisfiable.  Afterwards the decisions of the first 'reuse'
+  // levels are replayed as long as they are unassigned, which keeps the
+  // trail reused by 'restart' and the trail during 'reduce'.
+
+  void Internal::flush_uip2dip (int reuse) {
+    assert(reuse <= level);
+    vector<int>& decisions = dip_uip2dip_decisions;
+    decisions.clear();
+    for (int l = 1; l <= reuse; ++l) decisions.push_back(control[l].decision);
+    backtrack();
+    assert(clause.empty());
+    auto q = dip_uip2dip_queue.begin();
+    auto end = dip_uip2dip.end();
+    for (auto i = dip_uip2dip.begin(); i != end; ++i, ++q) {
+      assert(q != dip_uip2dip_queue.end());
+      auto j = i;
+      bool keep = true;
+      for (; *j; ++j) {
+	const int lit = *j;
+	const signed char tmp = val(lit);
+	if (tmp > 0) keep = false;
+	else if (tmp < 0) continue;
+	else if (not flags(lit).active()) keep = false;
+	else if (is_extended_var(lit) and is_var_actively_deleted(abs(lit))) keep = false;
+	else clause.push_back(lit);
+      }
+      if (keep and !unsat) {
+	if (clause.empty()) learn_empty_clause();
+	else if (clause.size() == 1) assign_unit(clause[0]);
+	else new_derived_clause(true,q->glue);
+	++stats.dip_uip2dip_added;
       }
-    }    
+      clause.clear();
+      if (proof) proof->delete_clause(q->id,true,vector<int>(i,j));
+      i = j;
+    }
+    dip_uip2dip.clear();
+    dip_uip2dip_queue.clear();
+    if (unsat) return;
+
+    // Conflicts while replaying are analyzed as any other conflict.
+    bool ok = propagate();
+    for (auto i = decisions.begin(); ok and i != decisions.end(); ++i) {
+      const int lit = *i;
+      if (!lit or val(lit)) break; // pseudo decision or implied now
+      search_assume_decision(lit);
+      ok = propagate();
+    }
+    if (ok) return;
+    do analyze(); while (!unsat and !propagate());
+  }
+
+  // Number of distinct decision levels of the literals c[first..], plus one for
+  // the literals before (the UIP or the extended variable, all at the current level).
+  int Internal::dip_clause_glue (const vector<int>& c, uint first) {
+    vector<int>& lvls = dip_buffers.levels;
+    lvls.clear();
+    for (uint i = first; i < c.size(); ++i) lvls.push_back(var(c[i]).level);
+    sort(lvls.begin(), lvls.end());
+    return 1 + int(unique(lvls.begin(), lvls.end()) - lvls.begin());
+  }
+
+  // Returns true if DIP computation should be skipped for this conflict
+  // (see 'DIPController::suspended' for the suspension policy).
+  bool Internal::disable_dip_computation_if_appropriate ( ) {
+    if (!opts.diplearning) return false;
+    return dip_control.suspended(stats.conflicts, stats.decisions, stats.dip_decision);
+  }
+
+  // Called at the start of every 'solve', so that an incremental call can
+  // use DIP learning again even if it was suspended in the previous one.
+  void Internal::reset_dip_control ( ) {
+    dip_control.reset(opts.seed, stats.decisions, stats.dip_decision);
   }
   
 } // namespace CaDiCaL
@@ -0,0 +1,62 @@
+#ifndef _dipbandit_hpp_INCLUDED
+#define _dipbandit_hpp_INCLUDED
+
+// Multi-armed bandit used by '--diplearningtype=4' to choose online which
+// pair of a two-vertex bottleneck is used for DIP learning.  The arms are
+// the three selection strategies of 'computeDIPClauses' (middle, closest
+// to the conflict, random).  We use UCB1 on discounted statistics: after
+// every update all rewards and counts are multiplied by 'decay', which
+// lets the choice follow changes of the search instead of averaging over
+// the whole run.  Rewards are expected to be in '[0,1]'.
+
+namespace CaDiCaL {
+
+  struct DIPBandit {
+
+    static const unsigned arms = 3;
+    static constexpr double decay = 0.999;
+
+    double reward[arms]; // discounted sum of rewards
+    double count[arms];  // discounted number of plays
+    double total;        // sum of 'count'
+    unsigned last;       // arm of the last 'choose'
+    bool pending;        // 'choose' called but not yet 'update'd
+
+    DIPBandit () { reset (); }
+
+    void reset () {
+      for (unsigned a = 0; a < arms; a++)
+        reward[a] = count[a] = 0;
+      total = 0;
+      last = 0;
+      pending = false;
+    }
+
+    unsigned choose () {
+      unsigned best = 0;
+      double best_score = -1;
+      for (unsigned a = 0; a < arms; a++) {
+        if (!count[a]) { best = a; break; }
+        const double score = reward[a] / count[a] +
+                             sqrt (2 * log (total) / count[a]);
+        if (score > best_score) best = a, best_score = score;
+      }
+      pending = true;
+      return last = best;
+    }
+
+    void update (double r) {
+      assert (pending);
+      assert (0 <= r && r <= 1);
+      for (unsigned a = 0; a < arms; a++)
+        reward[a] *= decay, count[a] *= decay;
+      total = total * decay + 1;
+      reward[last] += r;
+      count[last] += 1;
+      pending = false;
+    }
+  };
+
+} // namespace CaDiCaL
+
+#endif
@@ -0,0 +1,82 @@
+#ifndef _dipcontrol_hpp_INCLUDED
+#define _dipcontrol_hpp_INCLUDED
+
+#include "dipbandit.hpp" // Alphabetically before 'dipcontrol.hpp'.
+#include "random.hpp"    // Alphabetically after 'dipcontrol.hpp'.
+
+// Per-solver state deciding how and whether DIP learning is applied.  It
+// used to live in function-level 'static' variables, which were shared by
+// all solver instances of a process (and thus raced between threads) and
+// never reset between incremental calls.  Now every 'Internal' owns one
+// controller which is reset at the start of each 'solve' call.
+
+namespace CaDiCaL {
+
+  struct DIPController {
+
+    // Values of '--diplearningtype'.
+    enum Type { MIDDLE = 1, CLOSEST = 2, RANDOM = 3, ADAPTIVE = 4 };
+
+    // Every 'period' conflicts the percentage of decisions on extended
+    // variables is sampled into 'window'.  DIP learning is suspended if
+    // this percentage did not grow over a full window, first for 'initial'
+    // conflicts and then twice as long after every further suspension.
+    // Once it reaches 'very_high' percent DIP learning is never suspended.
+
+    static const int64_t period = 10000;
+    static const int64_t initial = 100000;
+    static constexpr double very_high = 5;
+
+    DIPBandit bandit;          // selection strategy for 'ADAPTIVE'
+    Random random;             // used by the 'RANDOM' strategy
+
+    bool some_very_high;       // extended decisions reached 'very_high'
+    bool some_evaluation;      // first (longer) window completed
+    vector<double> window;     // sampled percentage of extended decisions
+    int64_t suspended_until;   // no DIP learning before this conflict
+    int64_t suspension;        // length of the next suspension
+
+    int64_t decisions;         // 'stats.decisions' at 'reset'
+    int64_t dip_decisions;     // 'stats.dip_decision' at 'reset'
+
+    DIPController () : random (0) { reset (0, 0, 0); }
+
+    void reset (uint64_t seed, int64_t d, int64_t dd) {
+      bandit.reset ();
+      random = seed;
+      some_very_high = some_evaluation = false;
+      window.clear ();
+      suspended_until = 0;
+      suspension = initial;
+      decisions = d;
+      dip_decisions = dd;
+    }
+
+    // Called once per conflict with the current statistics.  Returns
+    // 'true' while DIP learning is suspended.
+    bool suspended (int64_t c, int64_t d, int64_t dd) {
+      if (some_very_high) return false;
+      if (c < suspended_until) return true;
+      if (c % period == period - 1) {
+        d -= decisions, dd -= dip_decisions;
+        window.push_back (d ? double (dd) / d * 100 : 0);
+        if (window.size () == (some_evaluation ? 10u : 20u)) {
+          some_evaluation = true;
+          if (window.back () >= very_high) some_very_high = true;
+          else if (window.back () <= window[0]) {
+            suspended_until = c + suspension;
+            suspension *= 2;
+          }
+          window.clear ();
+        }
+      }
+      return c < suspended_until;
+    }
+
+    // Uniform random number in '[0,n)'.
+    unsigned pick (unsigned n) { return random.generate () % n; }
+  };
+
+} // namespace CaDiCaL
+
+#endif
@@ -0,0 +1,79 @@
+#ifndef _dipsketch_hpp_INCLUDED
+#define _dipsketch_hpp_INCLUDED
+
+// Approximate counts of how often a DIP pair {x,y} has been found, used to
+// decide when the pair is frequent enough to get an extended variable.
+//
+// This is a count-min sketch with conservative update: 'depth' rows of
+// '2^log_width' counters, each row indexed by its own hash of the pair.
+// Memory is fixed, notifying and querying are O(depth), and counts can only
+// be over-estimated (by collisions), never under-estimated.  Every 'decay'
+// notifications all counters are halved, so that pairs which were frequent
+// long ago but are not seen anymore stop being promoted.
+
+namespace CaDiCaL {
+
+  struct DIPSketch {
+
+    static const unsigned depth = 4;
+
+    vector<unsigned> counts; // 'depth' rows of '1 << log_width' counters
+    unsigned log_width;
+    int64_t decay;           // halve counters after so many notifications (0 = never)
+    int64_t notified;        // notifications since the last decay
+
+    DIPSketch () : log_width (0), decay (0), notified (0) {}
+
+    bool initialized () const { return !counts.empty (); }
+
+    void init (unsigned lw, int64_t d) {
+      log_width = lw;
+      decay = d;
+      notified = 0;
+      counts.assign ((size_t) depth << log_width, 0);
+    }
+
+    size_t bucket (unsigned row, int x, int y) const {
+      static const uint64_t multipliers[depth] = {
+        0x9e3779b97f4a7c15ull, 0xc2b2ae3d27d4eb4full,
+        0x165667b19e3779f9ull, 0xd6e8feb86659fd93ull };
+      uint64_t h = ((uint64_t) (uint32_t) x << 32) | (uint32_t) y;
+      h ^= h >> 31;
+      h *= multipliers[row];
+      return ((size_t) row << log_width) + (size_t) (h >> (64 - log_width));
+    }
+
+    // Estimated number of occurrences of the (ordered) pair {x,y}.
+    unsigned occurrences (int x, int y) const {
+      assert (initialized ());
+      unsigned res = UINT_MAX;
+      for (unsigned row = 0; row < depth; row++)
+        res = min (res, counts[bucket (row, x, y)]);
+      return res;
+    }
+
+    // Count one more occurrence of {x,y}.  Only the counters which are at
+    // the current minimum are incremented (conservative update).
+    void notify (int x, int y) {
+      assert (initialized ());
+      size_t idx[depth];
+      unsigned low = UINT_MAX;
+      for (unsigned row = 0; row < depth; row++) {
+        idx[row] = bucket (row, x, y);
+        low = min (low, counts[idx[row]]);
+      }
+      if (low < UINT_MAX)
+        for (unsigned row = 0; row < depth; row++)
+          if (counts[idx[row]] == low)
+            counts[idx[row]]++;
+      if (decay && ++notified >= decay) {
+        for (auto &c : counts)
+          c >>= 1;
+        notified = 0;
+      }
+    }
+  };
+
+} // namespace CaDiCaL
+
+#endif
@@ -3,8 +3,13 @@
 namespace CaDiCaL {
   // return z such that z <--> x v y
   int Internal::add_extended_var (int x, int y) {
+    return add_extended_var(vector<int>{x,y});
+  }
+
+  // return z such that z <--> l1 v ... v lk
+  int Internal::add_extended_var (vector<int> lits) {
     // First add extended variable
-    int z = er_manager.add_extended_var(x,y,max_var+1);
+    int z = er_manager.add_extended_var(lits,max_var+1);
     if (z == max_var + 1) {
       // This is a new variable and we should add clauses
       //      cout << "Create new definition for " << z << endl;
@@ -13,77 +18,118 @@ namespace CaDiCaL {
       mark_var_actively_deleted(z,false);
       
       assert (flags(z).status == Flags::ACTIVE);
-      
-      assert(val(x) < 0);
-      assert(val(y) < 0);
 
-      //cout << -z << " " << x << " " << y << endl;
-      
-      clause = {-z,x,y};  new_extended_definition_clause();
+#ifndef NDEBUG
+      for (int l : lits)
+        assert(val(l) <= 0); // falsified in DIP learning, unassigned in 'bva'
+#endif
+
+      add_extended_definition_clauses(z,lits);
 
       // assert(val(z) <= 0);
       // if (val(z) == 0)
       //   search_assign(-z,new_clause); // This is not necessary in DIP extended variables because we will immediately BT
       //                                 // and hence z will be unassigned
 
-      //cout << z << " " << -x << endl;
-      clause = {z,-x};   new_extended_definition_clause();
-      //cout << z << " " << -y << endl;
-      clause = {z,-y};   new_extended_definition_clause();
-      clause.clear();
-      
       assert(wtab.size() > 0);
-      //cout << "Add " << z << " <-> " << x << " v " << y << " with clauses " << c1 << " " << c2 << " " << c3 << endl;
 	    
     }
-    else { // Variable has been created
-      if (is_var_actively_deleted(z) or find_definition_clauses(z).size() == 0) { // Should create clauses
+    else if (is_var_actively_deleted(z) or find_definition_clauses(z).empty()) {
+      // The definition clauses are gone, e.g., if 'remove_extended' did not
+      // find them.  They are added again if 'z' is still unassigned and
+      // active, and otherwise the definition gets a new variable.
+      if (val(z) or not flags(z).active()) {
+	LOG ("definition of %d can not be restored", z);
+	mark_var_actively_deleted(z,true);
+	er_manager.delete_definition(z);
+	return add_extended_var(lits);
+      }
+      LOG ("restoring definition clauses of %d", z);
+      add_extended_definition_clauses(z,lits);
+      mark_var_actively_deleted(z,false);
+    }
+    return z;
+  }
 
-	
-	cout << "Var " << z << " already existed but clauses removed " << endl;	
-	cout << z << "(val " << int(val(z)) << ", lev " << var(z).level << ") <--> ";
-	cout << x << "(val " << int(val(x)) << ", lev " << var(x).level << ")  OR ";
-	cout << y << "(val " << int(val(y)) << ", lev " << var(y).level << ")" << endl;
+  // return a such that a <--> l1 & ... & lk, i.e., -a <--> -l1 v ... v -lk
+  int Internal::add_extended_and (vector<int> lits) {
+    for (int& l : lits) l = -l;
+    return -add_extended_var(lits);
+  }
 
-	// if (max_var >= 493) {
-	//   Clause* tmp = find_binary_extended_clause_in_DB(493,209);	
-	//   if (tmp == NULL)
-	//     cout << "Clause not found before crashing" << endl; 
-	//   else cout << "Found before crashing (garbage " << tmp->garbage << ")" << endl;
-	// }
+  // return a such that a <--> l1 & ... & lk if it exists and 0 otherwise
+  int Internal::find_extended_and (const vector<int>& lits) {
+    vector<int> negated;
+    for (int l : lits) negated.push_back(-l);
+    return -er_manager.find_definition(negated);
+  }
 
-	cout << endl << endl;
-	for (auto c : clauses){
-	  for (int l : *c) cout << l << " ";
-	  cout << endl;
-	}
-	exit(1);
-	if (!flags(z).active() and flags(z).unused()) mark_active(z);
+  // Definition z <--> l1 v ... v lk declared by the user between solve
+  // calls.  The definition clauses are watched right away, so literals
+  // fixed at the root level are simplified away first.  Returns a literal
+  // equivalent to the disjunction, which is not necessarily extended.  The
+  // definition is kept, since the user may rely on it without using it.
+  int Internal::define_extended_var (vector<int> lits) {
+    assert(lits.size() >= 2);
+    if (unsat) return lits[0];
+    if (level) backtrack();
+    if (!propagate()) {
+      learn_empty_clause();
+      return lits[0];
+    }
+    int falsified = 0;
+    size_t j = 0;
+    for (int l : lits) {
+      const signed char tmp = val(l);
+      if (tmp > 0) return l;                // gate is true
+      else if (tmp < 0) falsified = l;
+      else lits[j++] = l;
+    }
+    lits.resize(j);
+    if (lits.empty()) return falsified;     // gate is false
+    if (lits.size() == 1) return lits[0];
+    const int z = add_extended_var(lits);
+    er_manager.keep_definition(z);
+    return z;
+  }
 
-	clause = {-z,x,y}; new_extended_definition_clause();
-	clause = {z,-x};   new_extended_definition_clause();
-	clause = {z,-y};   new_extended_definition_clause();
-	clause.clear();
+  // Definitions of extended variables in clauses, assumptions or
+  // constraints of the user are kept as well.
+  void Internal::keep_extended_var (int lit) {
+    const int v = abs(lit);
+    if (er_manager.defines(v)) er_manager.keep_definition(v);
+  }
 
-	mark_var_actively_deleted(z,false);
-      }
-      
+  // Clauses -z v l1 v ... v lk and z v -li for every i.
+  void Internal::add_extended_definition_clauses (int z, const vector<int>& lits) {
+    clause = {-z};
+    clause.insert(clause.end(), lits.begin(), lits.end());
+    new_extended_definition_clause();
+    for (int l : lits) {
+      clause = {z,-l};
+      new_extended_definition_clause();
     }
-    return z;
+    clause.clear();
   }
 
+  // Variables introduced during the current solve call and those with a
+  // definition from an earlier call or from the user ('define_or').
   bool Internal::is_extended_var (int v) {
-    return abs(v) > orig_max_var and abs(v) <= max_var;
+    v = abs(v);
+    return (v > orig_max_var and v <= max_var) or er_manager.defines(v);
   }
   
   void Internal::notify_DIP (int x, int y) {
+    if (!dip_sketch.initialized())
+      dip_sketch.init(opts.diplearningsketch, opts.diplearningdecay);
     er_manager.order_pair(x,y);
-    ++dip2times[{x,y}];
+    dip_sketch.notify(x,y);
   }
 
-  int Internal::occurrences_DIP(int x, int y) {
+  unsigned Internal::occurrences_DIP(int x, int y) {
+    if (!dip_sketch.initialized()) return 0;
     er_manager.order_pair(x,y);
-    return dip2times[{x,y}];
+    return dip_sketch.occurrences(x,y);
   }
 
   bool Internal::removing_extended ( ) {
@@ -97,17 +143,19 @@ namespace CaDiCaL {
   }
   
   void Internal::remove_extended ( ) {
-    cout << "REMOVE EXTENDED (should improve to not remove the last ones, and keep a reasonable number of extended vars" << endl;
-    cout << "Currently active should be " << max_var - orig_max_var - num_extended_vars_actively_deleted << endl;
     assert(level == 0);
-    cout << "Use scores: " << use_scores() << endl;
+    stats.dip_removals++;
+    PHASE ("removext", stats.dip_removals,
+	   "%d extended variables active, using %s",
+	   max_var - orig_max_var - num_extended_vars_actively_deleted,
+	   use_scores () ? "scores" : "queue");
     //lim.delete_ext += 300;
     lim.delete_ext += 2000;
     //lim.delete_ext += 100000;
     vector<pair<double,int>> candidates;
-    for (int v = orig_max_var + 1; v <= max_var-30; ++v)  // do not remove last 30
-      if (er_manager.is_deletable(v) and not is_var_actively_deleted(v)) candidates.push_back({score(v),v});
-    cout << "Candidates " << candidates.size() << endl;
+    for (int v = 1; v <= max_var-30; ++v)  // do not remove last 30
+      if (is_extended_var(v) and not is_var_actively_deleted(v) and er_manager.is_deletable(v)) candidates.push_back({score(v),v});
+    VERBOSE (3, "found %zd candidates for removal", candidates.size ());
   // for (auto x : candidates) cout << x.second << " ";
     // cout << endl;
     
@@ -117,6 +165,7 @@ namespace CaDiCaL {
 
     // TO DO: if we are not using VSDIS but QUEUE then the scores are not very up to date.....
     
+    vector<int> removed;
     int rem = 0;
     int skip = 0;
     for (int k = 0; k < first_kept; ++k) {
@@ -133,20 +182,45 @@ namespace CaDiCaL {
       
       //      cout << "Remove definition for " << v << endl;
       
-      unwatch_and_mark_for_deletion(cls[0]);
-      unwatch_and_mark_for_deletion(cls[1]);
-      unwatch_and_mark_for_deletion(cls[2]);
+      for (Clause* c : cls) unwatch_and_mark_for_deletion(c);
       er_manager.delete_definition(v);
       mark_var_actively_deleted(v,true);
       //cout << "Delete " << v << endl;
+      removed.push_back(v);
       ++rem;
     }
+    flush_removed_extended_clauses(removed);
 
-    cout << "Removed " << rem << " out of " << rem+skip << "(" << 100*double(rem)/(rem+skip) << " %)" << endl;
-    cout << "Currently active is now " << max_var - orig_max_var - num_extended_vars_actively_deleted << endl;
+    stats.dip_removed += rem;
+    PHASE ("removext", stats.dip_removals,
+	   "removed %d out of %d definitions (%.0f%%), %d extended variables active",
+	   rem, rem + skip, percent (rem, rem + skip),
+	   max_var - orig_max_var - num_extended_vars_actively_deleted);
     //if (rem > 0) exit(1);
   }
 
+  // Learned clauses with removed extended variables are not useful anymore,
+  // since the variables are unconstrained without their definitions.  With
+  // 'diplearningflush=1' they are demoted, i.e., reduced first unless used
+  // again, and with 'diplearningflush=2' flushed with the definitions.
+
+  void Internal::flush_removed_extended_clauses (const vector<int>& removed) {
+    if (!opts.diplearningflush or removed.empty()) return;
+    assert(!level);
+    for (int v : removed) mark(v);
+    for (const auto &c : clauses) {
+      if (!c->redundant or c->garbage) continue;
+      bool on_removed = false;
+      for (int lit : *c)
+	if (marked(lit)) { on_removed = true; break; }
+      if (!on_removed) continue;
+      if (opts.diplearningflush > 1) unwatch_and_mark_for_deletion(c);
+      else c->keep = false, c->used = 0, c->glue = c->size;
+      ++stats.dip_flushed;
+    }
+    for (int v : removed) unmark(v);
+  }
+
     Clause* Internal::find_binary_extended_clause (int x, int y) {
       //      cout << x << " and idx " << vlit(x) << " and size " << wtab.size() << endl;
       const auto end = watches(x).end();
@@ -173,54 +247,24 @@ namespace CaDiCaL {
     }
 
   
-    Clause* Internal::find_ternary_extended_clause (int x, int y, int z) { // TO BE IMPROVED
-      set<int> expected = {x,y,z};
-      // cout << "Expected: ";
-      // for (auto m : expected) cout << m << " ";
-      // cout << endl;
-      const auto endx = watches(x).end();      
-      auto i = watches(x).begin();
-      while (i != endx) {
-	if (i->size == 3 and i->clause->extended and not i->clause->garbage) {
-	  auto it = i->clause->begin();
-	  set<int> found = {*it,*(it+1),*(it+2)};
-	  if (found == expected) return i->clause;
-	}
-	++i;
-      }
-
-      //      cout << "First" << endl;
-      const auto endy = watches(y).end();      
-      i = watches(y).begin();
-      while (i != endy) {
-	if (i->size == 3 and i->clause->extended and not i->clause->garbage) {
-	  auto it = i->clause->begin();
-	  set<int> found = {*it,*(it+1),*(it+2)};
-	  if (found == expected) return i->clause;
-	}
-	++i;
-      }
-
-      //      cout << "Second" << endl;
-      const auto endz = watches(z).end();      
-      i = watches(z).begin();
-      while (i != endz) {
-	if (i->size == 3 and i->clause->extended and not i->clause->garbage) {
-	  auto it = i->clause->begin();
-	  set<int> found = {*it,*(it+1),*(it+2)};
-	  if (found == expected) return i->clause;
+    // Long extended clause with exactly the literals in 'lits'.  It is
+    // watched by two of them, so we go through the watches of all of them.
+    Clause* Internal::find_long_extended_clause (const vector<int>& lits) {
+      for (int l : lits) mark(l);
+      Clause* res = NULL;
+      for (int w : lits) {
+	for (const auto& i : watches(w)) {
+	  if (i.binary() or i.size != int(lits.size())) continue;
+	  Clause* c = i.clause;
+	  if (not c->extended or c->garbage) continue;
+	  bool same = true;
+	  for (int l : *c) if (marked(l) <= 0) { same = false; break; }
+	  if (same) { res = c; break; }
 	}
-	++i;
+	if (res) break;
       }
-
-      //      cout << "Final" << endl;
-      // for (auto cla : clauses) {
-      // 	for (auto it = cla->begin(); it != cla->end(); ++it)
-      // 	  cout << *it << " ";
-      // 	cout << endl;
-      // }
-      // exit(1);
-      return NULL;
+      for (int l : lits) unmark(l);
+      return res;
     }
 
   void Internal::write_all_clauses ( ) {
@@ -233,42 +277,27 @@ namespace CaDiCaL {
     vector<Clause*> Internal::find_definition_clauses(int z) {
       assert(z > 0);
       assert(is_extended_var(z));
-      pair<int,int> def = er_manager.expand_definition(z);
-      int x = def.first; int y = def.second; // z <--> x v y
-
-
+      const vector<int>& def = er_manager.expand_definition(z); // z <--> l1 v ... v lk
+      if (def.empty()) return {};
 
-      //cout << "Find definition " << z << "(val " << int(val(z)) << ") <--> " << x << "(val " << int(val(x)) << ") v " << y << "(val " << int(val(y)) << ")" << endl;
+      //cout << "Find definition " << z << "(val " << int(val(z)) << ")" << endl;
 
-            
-      // -x v z
+      vector<Clause*> res;
+      // -li v z
+      for (int l : def) {
+	Clause* c = find_binary_extended_clause(z,-l);
+	if (c == NULL) return {};
+	res.push_back(c);
+      }
 
-      //cout << "Look for " << z << " " << -x << endl;	    
-      Clause* c1 = find_binary_extended_clause(z,-x);
-      if (c1 == NULL)  return {};
-      //assert(c1 != NULL);
-      // for (auto it = c1->begin(); it != c1->end(); ++it)
-      // 	cout << *it << " ";
-      // cout << endl;
-      
-      // -y v z
-      //cout << "Look for " << z << " " << -y << endl;	    
-      Clause* c2 = find_binary_extended_clause(z,-y);
-      if (c2 == NULL) return {};
-      //assert(c2 != NULL);
-      // for (auto it = c2->begin(); it != c2->end(); ++it)
-      // 	cout << *it << " ";
-      // cout << endl;
+      // -z v l1 v ... v lk
+      vector<int> lits = {-z};
+      lits.insert(lits.end(), def.begin(), def.end());
+      Clause* c = find_long_extended_clause(lits);
+      if (c == NULL) return {};
+      res.push_back(c);
 
-      
-      // -z v x v y
-      //cout << "Look for " << -z << " " << x << " " << y << endl;
-      Clause* c3 = find_ternary_extended_clause(-z,x,y);
-      if (c3 == NULL) return {};
-      //cout << c3 << endl;
-
-      
-      return {c1,c2,c3};
+      return res;
     }
 
   void Internal::mark_var_actively_deleted (int v, bool b){
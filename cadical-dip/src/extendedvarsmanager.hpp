@@ -7,15 +7,21 @@
 // For that purpose, we can construct a graph such that for every definition x <-> y v z
 // we add two edges x->y and x->z. We will be able to delete a variable if it is extended
 // and has indegree zero
+//
+// Definitions are k-ary disjunctions z <-> l1 v ... v lk (k >= 2), keyed by
+// their literals sorted by variable index.  A conjunction z <-> l1 & ... & lk
+// is stored as -z <-> -l1 v ... v -lk (see 'Internal::add_extended_and').
 
 namespace CaDiCaL {
 
   struct ExtendedVarsManager {
 
-    map<pair<int,int>,int> pair2lit;
-    vector<pair<int,int>> var2pair;
-    
+    map<vector<int>,int> lits2var;
+    vector<vector<int>> var2lits;  // var2lits[z] are the literals defining z
+    vector<vector<int>> lit2vars;  // lit2vars[lit2idx(l)] are the definitions containing l
+
     vector<int> indegree; // indegree[vlit(l)] is the indegree of literal l
+    vector<int> pair_key; // scratch key of 'find_definition (x, y)'
     
     int max_ext_var;
 
@@ -33,54 +39,88 @@ namespace CaDiCaL {
       if (abs(x) > abs(y)) swap(x,y);
     }
 
+    static bool smaller_var (int x, int y) {
+      return abs(x) < abs(y) or (abs(x) == abs(y) and x < y);
+    }
+
+    void sort_definition (vector<int>& lits) {
+      sort(lits.begin(), lits.end(), smaller_var);
+    }
+
     bool exists_extended_var (int x, int y) {
-      order_pair(x,y);
-      auto it = pair2lit.find({x,y});
-      return it != pair2lit.end();
+      return find_definition(x,y) != 0;
     }
 
+    int find_definition (vector<int> lits) {
+      sort_definition(lits);
+      auto it = lits2var.find(lits);
+      if (it == lits2var.end()) return 0;
+      else return it->second;
+    }
 
+    // Called for every DIP, thus the key is not allocated for each call.
     int find_definition (int x, int y) {
       if (abs(x) == abs(y)) {cout << "ERROR: " << x << " " << y << endl; exit(1);}
       order_pair(x,y);
-      auto it = pair2lit.find({x,y});
-      if (it == pair2lit.end()) return 0;
+      pair_key.resize(2);
+      pair_key[0] = x, pair_key[1] = y;
+      auto it = lits2var.find(pair_key);
+      if (it == lits2var.end()) return 0;
       else return it->second;
     }
     
-    pair<int,int> expand_definition (int v) {
+    // Empty if the definition of 'v' has been deleted.
+    const vector<int>& expand_definition (int v) {
       assert( v > 0);
-      assert(v < int(var2pair.size()));
-      return var2pair[v];
+      assert(v < int(var2lits.size()));
+      return var2lits[v];
     }
 
-    int add_extended_var(int x, int y, int z) {
-      order_pair(x,y);
-      auto it = pair2lit.find({x,y});
-      if (it != pair2lit.end()) return it->second;
+    // True if 'v' has a definition which has not been deleted.
+    bool defines (int v) {
+      assert(v > 0);
+      return v < int(var2lits.size()) and not var2lits[v].empty();
+    }
+
+    // Extended variables whose definition contains the literal 'l'.
+    const vector<int>& definitions_with (int l) {
+      assert(part_of_definition(l));
+      return lit2vars[lit2idx(l)];
+    }
+
+    int add_extended_var(vector<int> lits, int z) {
+      assert(lits.size() >= 2);
+      sort_definition(lits);
+#ifndef NDEBUG
+      for (uint i = 1; i < lits.size(); ++i) assert(abs(lits[i-1]) != abs(lits[i]));
+#endif
+      auto it = lits2var.find(lits);
+      if (it != lits2var.end()) return it->second;
       else {
 	max_ext_var = max(max_ext_var, z);
+	for (int l : lits) max_ext_var = max(max_ext_var, abs(l));
 	if (indegree.size() <= max_lit_idx()) {
 	  indegree.resize( max_lit_idx() + 1, 0);
-	  var2pair.resize( max_ext_var + 1, {0,0});
+	  lit2vars.resize( max_lit_idx() + 1);
+	  var2lits.resize( max_ext_var + 1);
 	}
-	pair2lit.insert({{x,y},z});
-	var2pair[z] = {x,y};
+	lits2var.insert({lits,z});
 	
-	// We are adding z <-> x v y. That is, edges z->x and z->y
-	assert(lit2idx(x) < indegree.size());
-	assert(lit2idx(y) < indegree.size());
-	++indegree[lit2idx(x)];
-	++indegree[lit2idx(y)];
-	//	cout << "Adding " << z << " <--> " << x << " v " << y << endl;
-	// cout << "in(" << x << ") = " << indegree[lit2idx(x)] << endl;
-	// cout << "in(" << y << ") = " << indegree[lit2idx(y)] << endl;
-	// cout << z << " is extended " << is_extended[abs(z)] << endl;
-	// cout << endl;
+	// We are adding z <-> l1 v ... v lk. That is, edges z->li
+	for (int l : lits) {
+	  assert(lit2idx(l) < indegree.size());
+	  ++indegree[lit2idx(l)];
+	  lit2vars[lit2idx(l)].push_back(z);
+	}
+	var2lits[z] = std::move(lits);
 	return z;
       }      
     }
 
+    int add_extended_var(int x, int y, int z) {
+      return add_extended_var(vector<int>{x,y}, z);
+    }
+
     bool is_deletable (int v) {
       assert(v > 0);
       assert(lit2idx(v) < indegree.size());  assert(lit2idx(-v) < indegree.size());
@@ -90,20 +130,33 @@ namespace CaDiCaL {
     void delete_definition (int v) {
       //      cout << "Delete definition " << v << endl;
       assert(v > 0);
-      assert(v < int(var2pair.size()));
-      pair<int,int> def = var2pair[v];
-      assert(def.first and def.second);
-      var2pair[v] = {0,0};
-      pair2lit.erase(def);
-      int x = def.first, y = def.second;
-      assert(indegree[lit2idx(x)] > 0); assert(indegree[lit2idx(y)] > 0);
-      assert(lit2idx(x) < indegree.size());
-      assert(lit2idx(y) < indegree.size());
-      --indegree[lit2idx(x)]; --indegree[lit2idx(y)];
+      assert(v < int(var2lits.size()));
+      vector<int> def;
+      swap(def, var2lits[v]);
+      assert(def.size() >= 2);
+      lits2var.erase(def);
+      for (int l : def) {
+	assert(lit2idx(l) < indegree.size());
+	assert(indegree[lit2idx(l)] > 0);
+	--indegree[lit2idx(l)];
+	vector<int>& vars = lit2vars[lit2idx(l)];
+	auto pos = find(vars.begin(), vars.end(), v);
+	assert(pos != vars.end());
+	*pos = vars.back(); vars.pop_back();
+      }
       
       // we do not modify max_ext_var. This is not too precise, but since we are not reusing vars this is ok
     }
     
+    // Definitions used in irredundant clauses (introduced by 'bva') have to
+    // be kept.  We count such a use as an incoming edge of 'v', which makes
+    // 'v' non-deletable.
+    void keep_definition (int v) {
+      assert(v > 0);
+      assert(lit2idx(v) < indegree.size());
+      ++indegree[lit2idx(v)];
+    }
+
     ExtendedVarsManager ( ) : max_ext_var(0) { }
 
   };
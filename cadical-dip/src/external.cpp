@@ -75,6 +75,17 @@ void External::init (int new_max_var) {
   max_var = new_max_var;
 }
 
+void External::reserve_er (int new_max_var) {
+  if (new_max_var <= max_var)
+    return;
+  const size_t size = 1 + (size_t) new_max_var;
+  e2i.reserve (size);
+  ext_units.reserve (2 * size);
+  ext_flags.reserve (size);
+  is_observed.reserve (size);
+  internal->i2e.reserve (internal->vsize);
+}
+
 void External::init_er (int new_max_var) {
   assert (!extended);
   if (new_max_var <= max_var)
@@ -226,8 +237,10 @@ void External::add (int elit) {
     }
   }
 
-  if (elit)
+  if (elit) {
     LOG ("adding external %d as internal %d", elit, ilit);
+    internal->keep_extended_var (ilit);
+  }
   internal->add_original_lit (ilit);
 
   // Clean-up saved external literals once proof line is printed
@@ -244,6 +257,7 @@ void External::assume (int elit) {
   const int ilit = internalize (elit);
   assert (ilit);
   LOG ("assuming external %d as internal %d", elit, ilit);
+  internal->keep_extended_var (ilit);
   internal->assume (ilit);
 }
 
@@ -305,15 +319,34 @@ void External::constrain (int elit) {
   reset_extended ();
   const int ilit = internalize (elit);
   assert (!elit == !ilit);
-  if (elit)
+  if (elit) {
     LOG ("adding external %d as internal %d to constraint", elit, ilit);
-  else if (!elit && internal->proof) {
+    internal->keep_extended_var (ilit);
+  } else if (!elit && internal->proof) {
     internal->proof->add_constraint (constraint);
   }
   constraint.push_back (elit);
   internal->constrain (ilit);
 }
 
+int External::define (const vector<int> &elits, bool conjunction) {
+  assert (elits.size () >= 2);
+  reset_extended ();
+  vector<int> ilits;
+  for (const auto &elit : elits) {
+    const int ilit = internalize (elit);
+    LOG ("defining with external %d as internal %d", elit, ilit);
+    ilits.push_back (conjunction ? -ilit : ilit);
+  }
+  // A conjunction 'a' is defined as '-a <-> -l1 | ... | -lk'.
+  int ilit = internal->define_extended_var (ilits);
+  if (conjunction)
+    ilit = -ilit;
+  const int elit = internal->externalize (ilit);
+  LOG ("defined external %d as internal %d", elit, ilit);
+  return elit;
+}
+
 bool External::failed_constraint () {
   return internal->failed_constraint ();
 }
@@ -245,6 +245,7 @@ struct External {
   void enlarge (int new_max_var); // Enlarge allocated 'vsize'.
   void init (int new_max_var);    // Initialize up-to 'new_max_var'.
   void init_er (int new_max_var);    // Initialize up-to 'new_max_var' for extended resolution
+  void reserve_er (int new_max_var); // Reserve space for 'init_er' up-to 'new_max_var'
 
   int internalize (int); // Translate external to internal literal.
 
@@ -321,6 +322,11 @@ struct External {
   //
   void constrain (int elit);
 
+  // Declare 'l1 | ... | lk' respectively 'l1 & ... & lk' as extension
+  // definition and return the literal equivalent to it (see 'define_or').
+  //
+  int define (const vector<int> &elits, bool conjunction);
+
   // Returns true if 'solve' returned 20 because of the constraint.
   //
   bool failed_constraint ();
@@ -625,6 +625,38 @@ Clause *Internal::find_clause (const vector<int> &lits) {
   return 0;
 }
 
+// Find the other '2^(n-1) - 1' clauses of the XOR constraint over the
+// variables of the 'n' literals in 'lits', which are assumed to form a
+// clause already, and add them to 'xors'.  Returns 'false' if one of them
+// is missing.  This flips the signs of the literals in 'lits'.
+
+bool Internal::find_xor_clauses (vector<int> &lits,
+                                 vector<Clause *> &xors) {
+  const int size = lits.size ();
+  assert (size > 0);
+  assert (size < 32);
+  unsigned needed = (1u << (size - 1)) - 1; // additional clauses
+  unsigned signs = 0;                       // literals to negate
+  if (!needed)
+    return true;
+  do {
+    const unsigned prev = signs;
+    while (parity (++signs))
+      ;
+    for (int j = 0; j < size; j++) {
+      const unsigned bit = 1u << j;
+      int lit = lits[j];
+      if ((prev & bit) != (signs & bit))
+        lits[j] = lit = -lit;
+    }
+    Clause *e = find_clause (lits);
+    if (!e)
+      break;
+    xors.push_back (e);
+  } while (--needed);
+  return !needed;
+}
+
 void Internal::find_xor_gate (Eliminator &eliminator, int pivot) {
 
   if (!opts.elimxors)
@@ -656,26 +688,7 @@ void Internal::find_xor_gate (Eliminator &eliminator, int pivot) {
 
     assert (eliminator.gates.empty ());
 
-    unsigned needed = (1u << arity) - 1; // additional clauses
-    unsigned signs = 0;                  // literals to negate
-
-    do {
-      const unsigned prev = signs;
-      while (parity (++signs))
-        ;
-      for (int j = 0; j < size; j++) {
-        const unsigned bit = 1u << j;
-        int lit = lits[j];
-        if ((prev & bit) != (signs & bit))
-          lits[j] = lit = -lit;
-      }
-      Clause *e = find_clause (lits);
-      if (!e)
-        break;
-      eliminator.gates.push_back (e);
-    } while (--needed);
-
-    if (needed) {
+    if (!find_xor_clauses (lits, eliminator.gates)) {
       eliminator.gates.clear ();
       continue;
     }
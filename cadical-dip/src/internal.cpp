@@ -44,10 +44,23 @@ namespace CaDiCaL {
     dummy_binary = (Clause *) new char[bytes];
     memset (dummy_binary, 0, bytes);
     dummy_binary->size = 2;
+
+    // Conflict graphs given to 'TwoVertexBottlenecks' are written to this
+    // file to be replayed by the benchmark in 'test/dip'.
+
+    const char *path = getenv ("CADICAL_DIP_DUMP");
+    if (path && !(dip_dump = fopen (path, "w")))
+      FATAL ("failed to open file '%s' to dump DIP graphs "
+             "using environment variable 'CADICAL_DIP_DUMP'",
+             path);
   }
 
   Internal::~Internal () {
     delete[](char *) dummy_binary;
+    if (dip_dump)
+      fclose (dip_dump);
+    if (json_file)
+      fclose (json_file);
     for (const auto &c : clauses)
       delete_clause (c);
     if (proof)
@@ -152,10 +165,19 @@ namespace CaDiCaL {
     vsize = new_vsize;
   }
 
+  // Extended variables are introduced during conflict analysis.  If they do
+  // not fit into the allocated tables, these are doubled as in 'enlarge'.
+  // This should be rare, since 'reserve_er' keeps a slab of free entries.
+
   void Internal::enlarge_er (int new_max_var) {
     size_t new_vsize = vsize ? 2 * vsize : 1 + (size_t) new_max_var;
     while (new_vsize <= (size_t) new_max_var)
       new_vsize *= 2;
+    resize_er (new_vsize);
+  }
+
+  void Internal::resize_er (size_t new_vsize) {
+    assert (new_vsize > vsize);
     LOG ("enlarge internal size from %zd to new size %zd", vsize, new_vsize);
     // Ordered in the size of allocated memory (larger block first).
     enlarge_zero (unit_clauses, 2 * new_vsize);
@@ -183,6 +205,25 @@ namespace CaDiCaL {
     vsize = new_vsize;
   }
 
+  // Called at the start of solving and at restarts.  Makes sure that at
+  // least half a slab of 'diplearningreserve' percent of the original
+  // variables is allocated beyond 'max_var', and otherwise grows the tables
+  // by exactly one slab.  Thus new extended variables only have to
+  // initialize already allocated entries in 'init_vars_er'.
+
+  void Internal::reserve_er () {
+    if (!opts.diplearning || !opts.diplearningreserve)
+      return;
+    const size_t slab =
+      max ((size_t) 1, (size_t) orig_max_var * opts.diplearningreserve / 100);
+    const size_t new_vsize = (size_t) max_var + 1 + slab;
+    if ((size_t) max_var + 1 + slab / 2 <= vsize)
+      return;
+    LOG ("reserving %zd extended variables", slab);
+    resize_er (new_vsize);
+    external->reserve_er (external->max_var + (int) slab);
+  }
+
   void Internal::init_vars (int new_max_var) {
     if (new_max_var <= max_var)
       return;
@@ -359,6 +400,9 @@ namespace CaDiCaL {
       else if (false and conditioning ()){
 	condition (); // globally blocked clauses
       }
+      else if (xoring ()){
+	xorext (); // XOR elimination
+      }
       else if (removing_extended()){
 	remove_extended();
       }
@@ -467,6 +511,17 @@ namespace CaDiCaL {
 
     /*----------------------------------------------------------------------*/
 
+    if (incremental)
+      mode = "keeping";
+    else {
+      lim.xorext = stats.conflicts + opts.xorextint;
+      mode = "initial";
+    }
+    LOG ("%s xorext limit %" PRId64 " increment %" PRId64, mode,
+	 lim.xorext, lim.xorext - stats.conflicts);
+
+    /*----------------------------------------------------------------------*/
+
     // Initial preprocessing rounds.
 
     if (inc.preprocessing <= 0) {
@@ -651,6 +706,10 @@ namespace CaDiCaL {
   }
 
   int Internal::preprocess () {
+    if (opts.xorext)
+      xorext ();
+    if (opts.bva)
+      bva ();
     for (int i = 0; i < lim.preprocessing; i++)
       if (!preprocess_round (i))
 	break;
@@ -786,6 +845,8 @@ namespace CaDiCaL {
     assert (clause.empty ());
     START (solve);
     orig_max_var = max_var;
+    reserve_er ();
+    reset_dip_control ();
     if (proof)
       proof->solve_query ();
     if (opts.ilb) {
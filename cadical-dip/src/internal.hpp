@@ -54,6 +54,7 @@ extern "C" {
 #include "averages.hpp"
 #include "bins.hpp"
 #include "block.hpp"
+#include "bva.hpp"
 #include "cadical.hpp"
 #include "checker.hpp"
 #include "clause.hpp"
@@ -61,6 +62,8 @@ extern "C" {
 #include "contract.hpp"
 #include "cover.hpp"
 #include "decompose.hpp"
+#include "dipcontrol.hpp"
+#include "dipsketch.hpp"
 #include "drattracer.hpp"
 #include "elim.hpp"
 #include "ema.hpp"
@@ -106,6 +109,7 @@ extern "C" {
 #include "version.hpp"
 #include "vivify.hpp"
 #include "watch.hpp"
+#include "xorext.hpp"
 
 /*------------------------------------------------------------------------*/
 
@@ -253,9 +257,30 @@ struct Internal {
   Reap reap;                 // radix heap for shrink
 
   ExtendedVarsManager er_manager; // manager for extended variables
-  map<pair<int,int>,int> dip2times; // num times a dip occurs
+  DIPSketch dip_sketch; // approximate num times a dip occurs
+  DIPController dip_control; // per-solve DIP selection and suspension state
+  TwoVertexBottlenecks dip_bottlenecks; // reused across conflicts by try_dip_analysis
+  struct DIPBuffers {          // scratch of DIP analysis, cleared not reallocated
+    vector<int> pred_lits;     // predecessors on the conflict level
+    vector<int> pred_index;    // start of predecessors of each vertex
+    vector<int> analysis;      // vertices in inverse topological order
+    vector<int> predecessors;  // 'pred_lits' encoded for 'dip_bottlenecks'
+    vector<int> uip_clause;    // first UIP clause of 'try_dip_analysis'
+    vector<int> lits_to_bump;  // analyzed literals of the DIP clause
+    vector<int> candidates_y;  // DIP partners in 'computeRandomDIP'
+    vector<int> main, secondary, analyzed; // results of 'try_dip_analysis'
+    vector<int> added;         // literals added in 'dip_lower_level'
+    vector<int> levels;        // levels of a clause for its glue
+    vector<pair<int,int>> candidates; // levels in 'dip_lower_levels'
+  } dip_buffers;
+  FILE *dip_dump = 0; // conflict graphs dumped for 'test/dip' (CADICAL_DIP_DUMP)
+  FILE *json_file = 0; // JSON statistics (see 'json.cpp')
+  vector<int> dip_uip2dip; // queued UIP -> DIP clauses, each terminated by 0
+  struct DIPQueued { uint64_t id; int glue; };
+  vector<DIPQueued> dip_uip2dip_queue; // proof id and glue of queued clauses
+  vector<int> dip_uip2dip_decisions; // decisions replayed after 'flush_uip2dip'
   vector<int> is_extended_actively_deleted;
-  int num_extended_vars_actively_deleted;
+  int num_extended_vars_actively_deleted = 0;
   
   size_t num_assigned; // check for satisfied
 
@@ -332,6 +357,8 @@ struct Internal {
   void enlarge_vals (size_t new_vsize);
   void enlarge    (int new_max_var);
   void enlarge_er (int new_max_var);
+  void resize_er  (size_t new_vsize);
+  void reserve_er ();
 
   // A variable is 'active' if it is not eliminated nor fixed.
   //
@@ -614,6 +641,7 @@ struct Internal {
   void add_new_original_clause (uint64_t);
   Clause *new_learned_redundant_clause (int glue);
   Clause *new_hyper_binary_resolved_clause (bool red, int glue);
+  Clause *new_derived_clause (bool red, int glue = 0);
   Clause *new_clause_as (const Clause *orig);
   Clause *new_resolved_irredundant_clause ();
 
@@ -1013,6 +1041,7 @@ struct Internal {
   bool get_clause (Clause *, vector<int> &);
   bool is_clause (Clause *, const vector<int> &);
   Clause *find_clause (const vector<int> &);
+  bool find_xor_clauses (vector<int> &, vector<Clause *> &);
   void find_xor_gate (Eliminator &, int pivot);
 
   void find_if_then_else (Eliminator &, int pivot);
@@ -1064,6 +1093,34 @@ struct Internal {
   bool ternary_round (int64_t &steps, int64_t &htrs);
   bool ternary ();
 
+  // Bounded variable addition in 'bva.cpp'.
+  //
+  bool bva_candidate (Clause *);
+  void bva_connect (VariableAdder &, Clause *);
+  void bva_remove (VariableAdder &, Clause *);
+  void bva_find_matches (VariableAdder &, int lit);
+  int64_t bva_reduction (VariableAdder &, int64_t matched);
+  bool bva_lit (VariableAdder &, int lit);
+  void bva ();
+
+  // Gaussian elimination of XOR constraints in 'xorext.cpp'.
+  //
+  void xorext_find (XorExtender &);
+  void xorext_add_row (XorExtender &, XorRow &);
+  void xorext_remove_row (XorExtender &, unsigned);
+  void xorext_delete (XorProof &);
+  uint64_t xorext_lemma (const vector<int> &split, size_t);
+  void xorext_derive (const Xor &, const vector<const Xor *> &, XorProof &);
+  int xorext_new_var (XorExtender &);
+  void xorext_define (XorExtender &, XorRow &, int lit, Xor &);
+  bool xorext_step (const XorRow &, size_t, Xor &);
+  void xorext_trace (XorExtender &, XorRow &);
+  void xorext_add (XorExtender &, XorRow &, XorRow &, XorRow &);
+  void xorext_export (const XorRow &);
+  void xorext_eliminate (XorExtender &, int);
+  bool xoring ();
+  void xorext ();
+
   // Probing in 'probe.cpp'.
   //
   bool probing ();
@@ -1182,12 +1239,15 @@ struct Internal {
     
   public:
     int numVertices ( ) const;
-    DIPGraphEncoder (int nVars );
+    DIPGraphEncoder (int nVars = 0);
+    void reset (int nVars); // forget all vertices, keeping the memory
     int Sam2Solver (int var) const;
     int Solver2Sam (int lit);
   };
+  DIPGraphEncoder dip_encoder; // reused across conflicts
 
-  void writeDIPComputationInfo (TwoVertexBottlenecks& info, DIPGraphEncoder& encoder, const vector<int>& predecessors, const vector<int>& predecessorsLits, const vector<int>& predIndex, const vector<int>& literalsInAnalysis, bool foundDIP, const vector<int>& pathA, const vector<int>& pathB);
+  void writeDIPComputationInfo (TwoVertexBottlenecks& info, DIPGraphEncoder& encoder, const vector<int>& predecessors, const vector<int>& predecessorsLits, const vector<int>& predIndex, const vector<int>& literalsInAnalysis, bool foundDIP);
+  void dump_dip_graph (const vector<int>& predecessors, const vector<int>& predIndex);
       
   void analyze_literal_dip (int lit, int &open);
   void analyze_reason_dip  (int lit, Clause *reason, int &open);
@@ -1196,25 +1256,39 @@ struct Internal {
   // away during conflict analysis so that its activity score is bumped
   bool try_dip_analysis ( vector<int>& dip2conflict, vector<int>& uip2dip, vector<int>& analyzed_lits);
   void analyze_dip ();
-  bool computeDIPClauses (int a, int b, Clause* confl, TwoVertexBottlenecks& info, const DIPGraphEncoder& encoder, vector<int>& clause_to_learn, vector<int>& clause_to_learn2, int UIP, vector<int>& pathA, vector<int>& pathB, vector<int>& lits_to_bump);
-
-  bool computeRandomDIP (int a, int b, TwoVertexBottlenecks& info, const DIPGraphEncoder& encoder, int& x, int& y);
-  bool computeBestMiddleDIP (const TwoVertexBottlenecks& info, const DIPGraphEncoder& encoder, const vector<int>& pathA, const vector<int>& pathB, int& x, int& y);
-  bool computeClosestDIPToConflict (int a, int b, TwoVertexBottlenecks& info, const DIPGraphEncoder& encoder, int& x, int& y); 
-
+  bool computeDIPClauses (int a, int b, Clause* confl, const TwoVertexBottlenecks& info, const DIPGraphEncoder& encoder, vector<int>& clause_to_learn, vector<int>& clause_to_learn2, int UIP, vector<int>& lits_to_bump);
+
+  bool computeRandomDIP (int a, int b, const TwoVertexBottlenecks& info, const DIPGraphEncoder& encoder, int& x, int& y);
+  bool computeBestMiddleDIP (const TwoVertexBottlenecks& info, const DIPGraphEncoder& encoder, int& x, int& y);
+  bool computeClosestDIPToConflict (int a, int b, const TwoVertexBottlenecks& info, const DIPGraphEncoder& encoder, int& x, int& y); 
+  bool select_DIP (int dip_type, int a, int b, const TwoVertexBottlenecks& info, const DIPGraphEncoder& encoder, int& x, int& y);
+  void dip_lower_levels (vector<int>& c); // multi-level DIP learning
+  bool dip_lower_level (vector<int>& c, int L);
+
+  int  dip_clause_glue (const vector<int>& c, uint first = 1);
+  void queue_uip2dip (const vector<int>& c);
+  void flush_uip2dip (int reuse);
   void substitute_definitions_in_clause ( );
-  void disable_dip_computation_if_appropriate ( );
+  bool substitute_definition_in_clause (int def);
+  bool disable_dip_computation_if_appropriate ( );
+  void reset_dip_control ( );
     
   // END DIP -----------
 
   // Extended variables management in extendedvars.cpp
 
   int add_extended_var (int x, int y);  // returns z such that z <--> x v y
+  int add_extended_var (vector<int> lits);  // returns z such that z <--> l1 v ... v lk
+  int add_extended_and (vector<int> lits);  // returns a such that a <--> l1 & ... & lk
+  int find_extended_and (const vector<int>& lits); // same but 0 if it does not exist
+  int define_extended_var (vector<int> lits); // user definition through 'Solver::define_or'
+  void keep_extended_var (int lit); // keep definition of user literal
+  void add_extended_definition_clauses (int z, const vector<int>& lits);
   Clause* new_extended_definition_clause ( ); // clause is stored in "clause"
   bool is_extended_var(int v);
 
   void notify_DIP (int x, int y);
-  int occurrences_DIP(int x, int y);
+  unsigned occurrences_DIP(int x, int y);
 
   void write_all_clauses(); // DEBUG
   // ---- End of Extended variables management
@@ -1222,8 +1296,9 @@ struct Internal {
   // Deleting extended variables
   bool removing_extended ( );
   void remove_extended ( );
+  void flush_removed_extended_clauses (const vector<int>& removed);
   vector<Clause*> find_definition_clauses (int v);
-  Clause* find_ternary_extended_clause (int x, int y, int z);
+  Clause* find_long_extended_clause (const vector<int>& lits);
   Clause* find_binary_extended_clause (int x, int y);
   Clause* find_binary_extended_clause_in_DB (int x, int y); // DEBUG
   void unwatch_and_mark_for_deletion (Clause *c);
@@ -1458,6 +1533,13 @@ struct Internal {
   void print_statistics ();
   void print_resource_usage ();
 
+  // Machine readable statistics in 'json.cpp'.
+  //
+  bool json_open (const char *path);
+  void json_record (const char *type);
+  void json_sample ();
+  void json_summary ();
+
   /*----------------------------------------------------------------------*/
 
 #ifndef QUIET
@@ -0,0 +1,113 @@
+#include "internal.hpp"
+
+namespace CaDiCaL {
+
+/*------------------------------------------------------------------------*/
+
+// Machine readable statistics for scripts and job schedulers.  Every
+// record is a JSON object on a single line written to the file opened by
+// 'Solver::json_statistics'.  During search a 'sample' is written every
+// 'jsoninterval' conflicts (if non-zero) and 'Solver::statistics' writes a
+// 'summary' which additionally contains the profiled time per phase.
+
+/*------------------------------------------------------------------------*/
+
+bool Internal::json_open (const char *path) {
+  if (json_file)
+    fclose (json_file);
+  json_file = fopen (path, "w");
+  return json_file != 0;
+}
+
+void Internal::json_record (const char *type) {
+  assert (json_file);
+  FILE *file = json_file;
+
+  int64_t propagations = 0;
+  propagations += stats.propagations.cover;
+  propagations += stats.propagations.probe;
+  propagations += stats.propagations.search;
+  propagations += stats.propagations.transred;
+  propagations += stats.propagations.vivify;
+  propagations += stats.propagations.walk;
+
+  // Learned clauses per tier as used by 'reduce' (see 'clause.hpp').
+
+  int64_t tier1 = 0, tier2 = 0, tier3 = 0;
+  for (const auto &c : clauses) {
+    if (!c->redundant || c->garbage)
+      continue;
+    if (c->glue <= opts.reducetier1glue)
+      tier1++;
+    else if (c->glue <= opts.reducetier2glue)
+      tier2++;
+    else
+      tier3++;
+  }
+
+  const int64_t ext_vars = max_var - orig_max_var;
+  const int64_t ext_deleted = num_extended_vars_actively_deleted;
+
+  fprintf (file, "{\"type\":\"%s\"", type);
+  fprintf (file, ",\"real\":%.3f,\"process\":%.3f", real_time (),
+           process_time ());
+  fprintf (file, ",\"rss_mb\":%.2f,\"max_rss_mb\":%.2f",
+           current_resident_set_size () / (double) (1l << 20),
+           maximum_resident_set_size () / (double) (1l << 20));
+  fprintf (file,
+           ",\"conflicts\":%" PRId64 ",\"decisions\":%" PRId64
+           ",\"propagations\":%" PRId64 ",\"restarts\":%" PRId64
+           ",\"reductions\":%" PRId64,
+           stats.conflicts, stats.decisions, propagations, stats.restarts,
+           stats.reductions);
+  fprintf (file,
+           ",\"clauses\":{\"irredundant\":%" PRId64
+           ",\"redundant\":%" PRId64 ",\"tier1\":%" PRId64
+           ",\"tier2\":%" PRId64 ",\"tier3\":%" PRId64 "}",
+           stats.current.irredundant, stats.current.redundant, tier1, tier2,
+           tier3);
+  fprintf (file,
+           ",\"dip\":{\"exists\":%" PRId64 ",\"conflicts\":%" PRId64
+           ",\"dangerous\":%" PRId64 ",\"decisions\":%" PRId64
+           ",\"substituted\":%" PRId64 ",\"levels\":%" PRId64
+           ",\"uip2dip\":%" PRId64 ",\"uip2dip_added\":%" PRId64
+           ",\"flushed\":%" PRId64 "}",
+           stats.dip_exists, stats.dip_conflicts, stats.dip_dangerous,
+           stats.dip_decision, stats.dip_substituted, stats.dip_levels,
+           stats.dip_uip2dip, stats.dip_uip2dip_added, stats.dip_flushed);
+  fprintf (file,
+           ",\"ext_vars\":{\"total\":%" PRId64 ",\"live\":%" PRId64
+           ",\"deleted\":%" PRId64 ",\"bva\":%" PRId64 "}",
+           ext_vars, ext_vars - ext_deleted, ext_deleted, stats.bva.vars);
+
+#ifndef QUIET
+  if (!strcmp (type, "summary")) {
+    update_profiles ();
+    fputs (",\"profile\":{", file);
+    const char *sep = "";
+#define PROFILE(NAME, LEVEL) \
+  do { \
+    if (LEVEL > opts.profile || !profiles.NAME.value) \
+      break; \
+    fprintf (file, "%s\"%s\":%.3f", sep, profiles.NAME.name, \
+             profiles.NAME.value); \
+    sep = ","; \
+  } while (0);
+    PROFILES
+#undef PROFILE
+    fputc ('}', file);
+  }
+#endif
+
+  fputs ("}\n", file);
+  fflush (file);
+}
+
+void Internal::json_sample () { json_record ("sample"); }
+
+void Internal::json_summary () {
+  if (json_file)
+    json_record ("summary");
+}
+
+} // namespace CaDiCaL
@@ -35,6 +35,10 @@ OPTION( blockocclim,     1e2,  1,2e9,2,0,1, "occurrence limit") \
 OPTION( bump,              1,  0,  1,0,0,1, "bump variables") \
 OPTION( bumpreason,        1,  0,  1,0,0,1, "bump reason literals too") \
 OPTION( bumpreasondepth,   1,  1,  3,0,0,1, "bump reason depth") \
+OPTION( bva,               0,  0,  1,0,1,1, "bounded variable addition") \
+OPTION( bvamaxeff,       1e8,  0,2e9,1,0,1, "maximum bva efficiency") \
+OPTION( bvamineff,       1e7,  0,2e9,1,0,1, "minimum bva efficiency") \
+OPTION( bvareleff,       100,  1,1e5,1,0,1, "relative efficiency per mille") \
 OPTION( check,             0,  0,  1,0,0,0, "enable internal checking") \
 OPTION( checkassumptions,  1,  0,  1,0,0,0, "check assumptions satisfied") \
 OPTION( checkconstraint,   1,  0,  1,0,0,0, "check constraint satisfied") \
@@ -66,6 +70,16 @@ OPTION( decompose,         0,  0,  1,0,1,1, "decompose BIG in SCCs and ELS") \
 OPTION( decomposerounds,   2,  1, 16,1,0,1, "number of decompose rounds") \
 OPTION( deduplicate,       1,  0,  1,0,1,1, "remove duplicated binaries") \
 OPTION( diplearning,       0,  0,  1,0,1,1, "use DIP-based learning")	\
+OPTION( diplearningdecay,1e6,  0,2e9,1,0,1, "halve DIP pair counts interval (0=never)") \
+OPTION( diplearningflush,  2,  0,  2,0,0,1, "clauses on removed extended variables 0=keep,1=demote,2=flush") \
+OPTION( diplearningglue,   1,  0,  1,0,0,1, "count extended literal of DIP clause on conflict level") \
+OPTION( diplearninglevels, 0,  0,1e3,0,0,1, "DIP learning on most contributing lower levels") \
+OPTION( diplearninglevelsize,1e3,10,1e6,0,0,1, "max implication graph size on lower levels") \
+OPTION( diplearningmin,   20,  1,1e6,0,0,1, "occurrences to extend a DIP pair") \
+OPTION( diplearningreserve,10, 0,1e3,0,0,1, "reserved extended variables in percent") \
+OPTION( diplearningsketch,16,  8, 24,0,0,1, "log2 of DIP pair sketch width") \
+OPTION( diplearningtype,   1,  1,  4,0,0,1, "1=middle,2=closest,3=random,4=adaptive") \
+OPTION( diplearninguip2dip,0,  0,  1,0,0,1, "learn UIP to DIP clauses at next restart or reduce") \
 OPTION( eagersubsume,      1,  0,  1,0,0,1, "subsume recently learned") \
 OPTION( eagersubsumelim,  20,  1,1e3,0,0,1, "limit on subsumed candidates") \
 OPTION( elim,              1,  0,  1,0,1,1, "bounded variable elimination") \
@@ -109,6 +123,7 @@ OPTION( instantiate,       0,  0,  1,0,1,1, "variable instantiation") \
 OPTION( instantiateclslim, 3,  2,2e9,0,0,1, "minimum clause size") \
 OPTION( instantiateocclim, 1,  1,2e9,2,0,1, "maximum occurrence limit") \
 OPTION( instantiateonce,   1,  0,  1,0,0,1, "instantiate each clause once") \
+OPTION( jsoninterval,      0,  0,2e9,0,0,1, "JSON statistics sample interval") \
 OPTION( lidrup,            0,  0,  1,0,0,1, "linear incremental proof format") \
 LOGOPT( log,               0,  0,  1,0,0,0, "enable logging") \
 LOGOPT( logsort,           0,  0,  1,0,0,0, "sort logged clauses") \
@@ -201,6 +216,10 @@ OPTION( walkmineff,      1e5,  0,1e7,1,0,1, "minimum efficiency") \
 OPTION( walknonstable,     1,  0,  1,0,0,1, "walk in non-stabilizing phase") \
 OPTION( walkredundant,     0,  0,  1,0,0,1, "walk redundant clauses too") \
 OPTION( walkreleff,       20,  1,1e5,1,0,1, "relative efficiency per mille") \
+OPTION( xorext,            0,  0,  1,0,1,1, "XOR elimination with extension") \
+OPTION( xorextint,       1e5,  1,2e9,0,0,1, "XOR elimination interval") \
+OPTION( xorextsize,        6,  3, 20,0,0,1, "maximum XOR constraint size") \
+OPTION( xorextticks,     1e7,  0,2e9,1,0,1, "XOR elimination ticks limit") \
 
 // Note, keep an empty line right before this line because of the last '\'!
 // Also keep those single spaces after 'OPTION(' for proper sorting.
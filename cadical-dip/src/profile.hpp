@@ -42,6 +42,7 @@ struct Internal;
   PROFILE (backward, 3) \
   PROFILE (block, 2) \
   PROFILE (bump, 4) \
+  PROFILE (bva, 2) \
   PROFILE (checking, 2) \
   PROFILE (cdcl, 1) \
   PROFILE (collect, 3) \
@@ -77,7 +78,8 @@ struct Internal;
   PROFILE (transred, 3) \
   PROFILE (unstable, 2) \
   PROFILE (vivify, 2) \
-  PROFILE (walk, 2)
+  PROFILE (walk, 2) \
+  PROFILE (xorext, 2)
 
 /*------------------------------------------------------------------------*/
 
@@ -212,7 +212,10 @@ void Internal::reduce () {
   if (flush)
     stats.flush.count++;
 
-  if (!propagate_out_of_order_units ())
+  if (!dip_uip2dip.empty ())
+    flush_uip2dip (level);
+
+  if (unsat || !propagate_out_of_order_units ())
     goto DONE;
 
   mark_satisfied_clauses_as_garbage ();
@@ -22,6 +22,7 @@ F  backtracked after flipping phases
 B  backtracked after resetting to best phases
 W  backtracked after local search improved phases
 b  blocked clause elimination
+A  bounded variable addition
 G  before garbage collection
 C  after garbage collection
 /  compacted internal literals and remapped external to internal
@@ -55,6 +56,7 @@ s  subsumed clause removal round
 t  transition reduction of binary implication graph
 w  vivified redundant and irredundant clauses
 v  vivified irredundant clauses
+x  XOR elimination round
 
 The order of the list follows the occurrences of 'report' in the source
 files, i.e., obtained from "grep 'report (' *.cpp".   Note that some of the
@@ -233,6 +235,8 @@ void Internal::report (char type, int verbose) {
     tout.blue (false);
     break;
   case 'd':
+  case 'x':
+  case 'A':
     tout.blue (true);
     break;
   case 'z':
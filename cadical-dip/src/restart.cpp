@@ -125,7 +125,11 @@ void Internal::restart () {
   if (stable)
     stats.restartstable++;
   LOG ("restart %" PRId64 "", stats.restarts);
-  backtrack (reuse_trail ());
+  if (dip_uip2dip.empty ())
+    backtrack (reuse_trail ());
+  else
+    flush_uip2dip (reuse_trail ());
+  reserve_er ();
 
   lim.restart = stats.conflicts + opts.restartint;
   LOG ("new restart limit at %" PRId64 " conflicts", lim.restart);
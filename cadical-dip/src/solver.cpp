@@ -410,6 +410,42 @@ void Solver::reserve (int min_max_var) {
   LOG_API_CALL_END ("reserve", min_max_var);
 }
 
+/*------------------------------------------------------------------------*/
+
+// Definitions are not traced since 'mobical' has no such API calls.
+
+void Solver::require_valid_definition (const std::vector<int> &lits) {
+  REQUIRE_READY_STATE ();
+  REQUIRE (!internal->lrat && !internal->opts.check,
+           "extension definitions not supported with LRAT or checking");
+  REQUIRE (lits.size () >= 2, "definition with less than two literals");
+  for (auto lit : lits)
+    REQUIRE_VALID_LIT (lit);
+  for (size_t i = 0; i < lits.size (); i++)
+    for (size_t j = i + 1; j < lits.size (); j++)
+      REQUIRE (abs (lits[i]) != abs (lits[j]),
+               "literals '%d' and '%d' on the same variable", lits[i],
+               lits[j]);
+}
+
+int Solver::define_or (const std::vector<int> &lits) {
+  LOG_API_CALL_BEGIN ("define_or");
+  require_valid_definition (lits);
+  transition_to_steady_state ();
+  int res = external->define (lits, false);
+  LOG_API_CALL_RETURNS ("define_or", res);
+  return res;
+}
+
+int Solver::define_and (const std::vector<int> &lits) {
+  LOG_API_CALL_BEGIN ("define_and");
+  require_valid_definition (lits);
+  transition_to_steady_state ();
+  int res = external->define (lits, true);
+  LOG_API_CALL_RETURNS ("define_and", res);
+  return res;
+}
+
 /*------------------------------------------------------------------------*/
 #ifndef NTRACING
 
@@ -1225,9 +1261,17 @@ void Solver::statistics () {
   TRACE ("stats");
   REQUIRE_VALID_OR_SOLVING_STATE ();
   internal->print_statistics ();
+  internal->json_summary ();
   LOG_API_CALL_END ("stats");
 }
 
+bool Solver::json_statistics (const char *path) {
+  REQUIRE_VALID_STATE ();
+  bool res = internal->json_open (path);
+  LOG_API_CALL_RETURNS ("json_statistics", path, res);
+  return res;
+}
+
 void Solver::resources () {
   if (state () == DELETING)
     return;
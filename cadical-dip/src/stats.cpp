@@ -73,6 +73,17 @@ void Stats::print (Internal *internal) {
     PRT ("  pureclauses:   %15" PRId64 "   %10.2f    per pure literal",
          stats.blockpured, relative (stats.blockpured, stats.all.pure));
   }
+  if (all || stats.bva.vars) {
+    PRT ("bva:             %15" PRId64 "   %10.2f %%  of all variables",
+         stats.bva.vars, percent (stats.bva.vars, stats.vars));
+    PRT ("  calls:         %15" PRId64 "   %10.2f    interval",
+         stats.bva.count, relative (stats.conflicts, stats.bva.count));
+    PRT ("  removed:       %15" PRId64 "   %10.2f %%  of irredundant clauses",
+         stats.bva.removed,
+         percent (stats.bva.removed, stats.added.irredundant));
+    PRT ("  added:         %15" PRId64 "   %10.2f %%  per removed",
+         stats.bva.added, percent (stats.bva.added, stats.bva.removed));
+  }
   if (all || stats.chrono)
     PRT ("chronological:   %15" PRId64 "   %10.2f %%  of conflicts",
          stats.chrono, percent (stats.chrono, stats.conflicts));
@@ -88,6 +99,16 @@ void Stats::print (Internal *internal) {
 	 stats.dip_exists, percent(stats.dip_exists, stats.conflicts) );
     PRT ("dip_dangerous:   %15" PRId64 "   %10.2f %% of all conflicts",
 	 stats.dip_dangerous, percent(stats.dip_dangerous, stats.conflicts) );
+    PRT ("dip_levels:      %15" PRId64 "   %10.2f    per conflict",
+	 stats.dip_levels, relative(stats.dip_levels, stats.conflicts) );
+    PRT ("dip_substituted: %15" PRId64 "   %10.2f    per conflict",
+	 stats.dip_substituted, relative(stats.dip_substituted, stats.conflicts) );
+    PRT ("dip_uip2dip:     %15" PRId64 "   %10.2f %% added",
+	 stats.dip_uip2dip, percent(stats.dip_uip2dip_added, stats.dip_uip2dip) );
+    PRT ("dip_flushed:     %15" PRId64 "   %10.2f %% of learned",
+	 stats.dip_flushed, percent(stats.dip_flushed, stats.learned.clauses) );
+    PRT ("dip_removed:     %15" PRId64 "   %10.2f    per removal",
+	 stats.dip_removed, relative(stats.dip_removed, stats.dip_removals) );
     PRT ("num_ext_vars:    %15" PRId64,
          internal->max_var - internal->orig_max_var);
     PRT ("  backtracked:   %15" PRId64 "   %10.2f %%  of conflicts",
@@ -549,6 +570,23 @@ void Stats::print (Internal *internal) {
     PRT ("  flipped:       %15" PRId64 "   %10.2f    per weakened",
          stats.extended, relative (stats.extended, stats.weakened));
   }
+  if (all || stats.xorext.rounds) {
+    PRT ("xorext:          %15" PRId64 "   %10.2f    interval",
+         stats.xorext.rounds,
+         relative (stats.conflicts, stats.xorext.rounds));
+    PRT ("  xors:          %15" PRId64 "   %10.2f    per round",
+         stats.xorext.xors,
+         relative (stats.xorext.xors, stats.xorext.rounds));
+    PRT ("  units:         %15" PRId64 "   %10.2f    per round",
+         stats.xorext.units,
+         relative (stats.xorext.units, stats.xorext.rounds));
+    PRT ("  equivs:        %15" PRId64 "   %10.2f    per round",
+         stats.xorext.equivs,
+         relative (stats.xorext.equivs, stats.xorext.rounds));
+    PRT ("  vars:          %15" PRId64 "   %10.2f    per round",
+         stats.xorext.vars,
+         relative (stats.xorext.vars, stats.xorext.rounds));
+  }
 
   LINE ();
   MSG ("%sseconds are measured in %s time for solving%s",
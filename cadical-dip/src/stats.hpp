@@ -237,6 +237,21 @@ struct Stats {
 
   int64_t preprocessings;
 
+  struct {
+    int64_t count;   // number of bounded variable addition calls
+    int64_t vars;    // added extended variables
+    int64_t added;   // added clauses
+    int64_t removed; // removed clauses
+  } bva;
+
+  struct {
+    int64_t rounds; // number of XOR elimination rounds
+    int64_t xors;   // XOR constraints found
+    int64_t units;  // units derived by XOR elimination
+    int64_t equivs; // binary XOR constraints derived
+    int64_t vars;   // extension variables for tracing the proof
+  } xorext;
+
   int64_t ilbtriggers;
   int64_t ilbsuccess;
   int64_t levelsreused;
@@ -264,6 +279,13 @@ struct Stats {
   int64_t dip_exists;    // conflicst where a DIP exists
   int64_t dip_decision;  // decisions on extendend variable
   int64_t dip_dangerous; // dangerous DIPs
+  int64_t dip_substituted; // literals removed by substituting definitions
+  int64_t dip_levels;    // lower levels where a DIP replaced literals
+  int64_t dip_uip2dip;   // queued UIP -> DIP clauses
+  int64_t dip_uip2dip_added; // of those added at restart
+  int64_t dip_flushed;   // learned clauses on removed extended variables
+  int64_t dip_removals;  // rounds of removing extended variables
+  int64_t dip_removed;   // removed definitions of extended variables
   Stats ();
 
   void print (Internal *);
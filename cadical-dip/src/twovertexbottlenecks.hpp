@@ -42,6 +42,10 @@
 //    There is an alternate interface that uses std:vector<int> objects
 //         instead of the integer arrays predecessors[] and predIndex[].  
 //         In this case, predIndex.size must be equal to N.
+//
+//    A TwoVertexBottlenecks object is meant to be reused across calls
+//         (e.g., once per conflict): all work arrays are kept as members
+//         and only cleared, so after warm-up no call allocates memory.
 //  
 // Output:
 //    Return code:  q > 0  if there is at least one two vertex bottleneck.
@@ -72,6 +76,10 @@
 //                              which can be paired with vertNum to make a bottleneck
 //          - int minAncestor - any vertex in the other VertList which is greater
 //                              this value is an ancestor of vertNum.
+//          - int pathPos  - index of vertNum in its path (GetPathA() for
+//                              VertListA entries, GetPathB() for VertListB entries).
+//          - int sinkDist - number of path edges from vertNum to the sink;
+//                              sinkDist == 1 iff vertNum is an immediate ancestor of the sink.
 //    Note that minPair and maxPair may not actually appear in the other VertList;
 //          they serve merely as lower and upper bounds. (!)
 //    The same holds for minAncestor.
@@ -83,6 +91,10 @@
 //          That is, the VertListA minPair and maxPair values allow a pairing 
 //          iff the VertListB values allow the pairing.
 //    The minAncestor information is not redundant however.
+//
+//    GetPathA() / GetPathB() - the two vertex-disjoint paths used in the
+//          computation, listed from the source (N-1) down to the sink (0).
+//          VertListA entries lie on path A, VertListB entries on path B.
 // 
 //              
 // *********************************************************
@@ -101,19 +113,22 @@ public:
 
 public:
 
-  int CalcBottlenecks( int N, const int predecessors[], const int predIndex[],  std::vector<int>& pathA, std::vector<int>& pathB);
-  int CalcBottlenecks(const std::vector<int> predecessors, const std::vector<int> predIndex,  std::vector<int>& pathA, std::vector<int>& pathB);
+  int CalcBottlenecks( int N, const int predecessors[], const int predIndex[]);
+  int CalcBottlenecks(const std::vector<int>& predecessors, const std::vector<int>& predIndex);
 
 public:
   class VertPairInfo {
   public:
-    VertPairInfo(int vert, int lowerBdPair, int upperBdPair, int minAncestorOther)
-      : vertNum(vert), minPair(lowerBdPair), maxPair(upperBdPair), minAncestor(minAncestorOther) {}
+    VertPairInfo(int vert, int lowerBdPair, int upperBdPair, int minAncestorOther, int posInPath, int distToSink)
+      : vertNum(vert), minPair(lowerBdPair), maxPair(upperBdPair), minAncestor(minAncestorOther),
+        pathPos(posInPath), sinkDist(distToSink) {}
 
     int vertNum;        // The index of a vertex as potential member of 2-vertex bottleneck
     int minPair;        // Lower bound on verts in the other VertPairInfo array which form a two vertex bottleneck;
     int maxPair;        // Upper bound on verts in teh other VertPairInfo array which form a two vertex bottleneck;
     int minAncestor;    // Lower bound on verts in the other VertPairInfo array which are ancestors
+    int pathPos;        // Position of vertNum in its path (index into GetPathA() or GetPathB())
+    int sinkDist;       // Number of edges on its path from vertNum to the sink
   };
 
 public:
@@ -121,18 +136,104 @@ public:
   const std::vector<VertPairInfo>& GetVertListB() const { return VertListB; }
 
   int LengthListA() const { return (int)VertListA.size(); }
-  int LengthListB() const { return (int)VertListA.size(); }
+  int LengthListB() const { return (int)VertListB.size(); }
   const VertPairInfo& GetListA(int n) const { return VertListA[n]; }
   const VertPairInfo& GetListB(int n) const { return VertListB[n]; }
 
+  // The two vertex-disjoint paths, from the source (N-1) down to the sink (0).
+  const std::vector<int>& GetPathA() const { return PathA; }
+  const std::vector<int>& GetPathB() const { return PathB; }
+
 public:    // If not 2-connected (return code -1), this is the single vertex bottleneck closest to the sink
   int SingleVertBottleneck;
 
 private:
   std::vector<VertPairInfo> VertListA;
   std::vector<VertPairInfo> VertListB;
+  std::vector<int> PathA;
+  std::vector<int> PathB;
+
+  void Clear() { VertListA.clear(); VertListB.clear(); PathA.clear(); PathB.clear(); }
+
+private:
+  // Internal data structures, see twovertexbottlenecks.cpp.
+
+  //   vertInfo-- uSed in Phases A, B, C
+  //   Tracks for each vertex: whether it is on a path
+  //           and whether it has been visited the depth first searches.
+  class vertInfo {
+  public:
+    int status = 0;     // Status
+    int succ = -1;      // Successor node, i.e, on the path towards the sink (vertex 0).
+    int pathPos = -1;   // Index in PathA or PathB, if on one of the paths.
+
+    // Handle membership on first path.  
+    bool TestOnFirst() const { return status & 0x01; }  // Test whether on first path.
+    void SetOnFirst() { status = status | 0x01; }       // Mark as on first path
+    void ResetOnFirst() { status = (status & ~0x01); }  // Mark as not on first path
+
+    bool TestOnSecond() const { return status & 0x02; } // Test whether on second path
+    void SetOnSecond() { status = status | 0x02; }      // Mark as on second path
+
+    // TestOnPath returns 0, 1, 2, 3 - If on neither path, path one, path two or both.
+    int TestOnPath() const { return (status & 0x03); }   
+    // Test if on path two (leftFlag==1) or on path 1 (leftFlag==0)
+    bool TestOnPath(int leftFlag) const { return status & (0x01 << leftFlag); } 
+
+    bool TestReachedPhaseB() const { return status & 0x04; }
+    // Mark as reached in Phase B.  Returns true is already was reached in Phase B
+    bool ReachedInPhaseB() {
+      bool ret = status & 0x04;
+      status = status | 0x04;
+      return ret;
+    }
+
+    // Mark as reached in Phase C.  Returns true is already was reached in Phase C
+    // leftFlag will be 0 or 1 for working on reachability 
+    //     from left path vertices or from right path vertices (respectively)
+    bool ReachedInPhaseC( int leftFlag ) {
+      bool ret = status & (0x08 << leftFlag);
+      status = status | (0x08 << leftFlag);
+      return ret;
+    }
+  };
+
+  class reachInfo {
+    // maxDirectReachOnPath - max. reachable node on the path.
+    // minAncestorOnPath - min reachable node on the path,
+    //                       allowing traversing vertices on the *other* path.
+  public:
+    reachInfo(int maxReach, int minAncestor)
+      : maxDirectReachOnPath(maxReach), minAncestorOnPath(minAncestor) {}
+    int maxDirectReachOnPath;
+    int minAncestorOnPath;
+  };
+
+  class pivotInfoPlus {
+    // In the array of pathJumpingInfoPlus objects:
+    //     First PivotVert 0. (Sink)   Last PivotVert is N-1. (Source)
+    //     MaxReachOtherPath may not be non-decreasing, but it
+    //         would be once points on the other path which are not pivots are skipped.
+    //     MinAncestorOtherPath is non-decreasing.
+    //     MaxReachOtherPath is initially used for the max reachable vertex on the same path,
+    //         but then is replaced with the max reachable vertex on the other path.
+  public:
+    pivotInfoPlus() { assert(false); }
+    pivotInfoPlus(int vert, int maxReach) 
+      : PivotVert(vert), MaxReachOtherPath(maxReach) {}
+
+    int PivotVert;
+    int MaxReachOtherPath;
+    int MinAncestorOtherPath;
+  };
 
-  void Clear() { VertListA.clear(); VertListB.clear(); }
+  // Work arrays, retained between calls of CalcBottlenecks.
+  std::vector<vertInfo> verts;
+  std::vector<int> vertsForDFS;           // Stack of vertices to explore for depth first search
+  std::vector<reachInfo> directReach1;
+  std::vector<reachInfo> directReach2;
+  std::vector<pivotInfoPlus> leftPathPivotsBis;
+  std::vector<pivotInfoPlus> rightPathPivotsBis;
 
 };
 
@@ -140,10 +241,10 @@ private:
 // Main routine for calculating the two-vertex bottlenecks
 //   This is just a wrapper to accept std::vector's as inputs.
 inline int TwoVertexBottlenecks::CalcBottlenecks(
-						 const std::vector<int> predecessors, const std::vector<int> predIndex,     std::vector<int>& pathA, std::vector<int>& pathB)
+						 const std::vector<int>& predecessors, const std::vector<int>& predIndex)
 {
   assert(int(predecessors.size()) == predIndex.back());
-  return CalcBottlenecks((int)predIndex.size(), predecessors.data(), predIndex.data(), pathA, pathB);
+  return CalcBottlenecks((int)predIndex.size(), predecessors.data(), predIndex.data());
 }
 
 #endif // TWO_VERTEX_BOTTLENECKS_H
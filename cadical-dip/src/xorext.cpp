@@ -0,0 +1,562 @@
+#include "internal.hpp"
+
+namespace CaDiCaL {
+
+/*------------------------------------------------------------------------*/
+
+// Gaussian elimination on the XOR constraints encoded in the formula.
+// Parity formulas (Tseitin formulas, random k-XOR) are hard for resolution
+// and thus for CDCL, but they have short extended resolution proofs.  We
+// recover the XOR constraints with the gate detection of 'gates.cpp',
+// eliminate variables from this XOR system in the order of fewest
+// occurrences and export derived units, binary XOR constraints and the
+// empty clause to the solver.
+//
+// XOR constraints with many variables have no small CNF encoding.  If a
+// proof is traced every row of the system is therefore represented in the
+// proof through extension variables for its partial sums (see 'XorRow').
+// Adding two rows walks over the variables of both in order and keeps
+// the invariant that the partial sum of the result is the sum of the
+// partial sums of the two rows, which is a constraint over at most four
+// variables and can be derived by reverse unit propagation at each step.
+// Extension variables of removed rows are reused within one round and
+// fixed at the end of the round, after all their clauses are deleted.
+//
+// Definitions of extension variables are only valid in DRAT proofs.  Thus
+// this is disabled for LRAT and for the internal proof checker, which both
+// do not support extension.
+
+/*------------------------------------------------------------------------*/
+
+bool Internal::xoring () {
+  if (!opts.xorext)
+    return false;
+  if (!opts.inprocessing)
+    return false;
+  return lim.xorext <= stats.conflicts;
+}
+
+/*------------------------------------------------------------------------*/
+
+// Find the XOR constraints of size at most 'xorextsize' among irredundant
+// clauses (ignoring root-level falsified literals).
+
+void Internal::xorext_find (XorExtender &xorext) {
+
+  const int limit = opts.xorextsize;
+
+  init_occs ();
+
+  vector<Clause *> candidates;
+  for (const auto &c : clauses) {
+    if (c->garbage || c->redundant)
+      continue;
+    bool satisfied = false;
+    int size = 0;
+    for (const auto &lit : *c) {
+      const signed char tmp = val (lit);
+      if (tmp > 0)
+        satisfied = true;
+      if (!tmp)
+        size++;
+    }
+    if (satisfied || size < 2 || size > limit)
+      continue;
+    for (const auto &lit : *c)
+      if (!val (lit))
+        occs (lit).push_back (c);
+    candidates.push_back (c);
+  }
+
+  vector<int> lits;
+  vector<Clause *> found;
+  for (const auto &c : candidates) {
+    if (c->gate)
+      continue;
+    get_clause (c, lits);
+    xorext.ticks += 1 + lits.size ();
+    XorRow row;
+    row.parity = true;
+    for (const auto &lit : lits) {
+      row.vars.push_back (abs (lit));
+      if (lit < 0)
+        row.parity = !row.parity;
+    }
+    found.clear ();
+    if (!find_xor_clauses (lits, found))
+      continue;
+    c->gate = true;
+    for (const auto &d : found)
+      d->gate = true;
+    sort (row.vars.begin (), row.vars.end ());
+    LOG (row.vars, "found arity %zd XOR constraint with parity %d",
+         row.vars.size (), (int) row.parity);
+    stats.xorext.xors++;
+    xorext_add_row (xorext, row);
+  }
+
+  for (const auto &c : candidates)
+    c->gate = false;
+
+  reset_occs ();
+}
+
+/*------------------------------------------------------------------------*/
+
+void Internal::xorext_add_row (XorExtender &xorext, XorRow &row) {
+  const unsigned idx = xorext.rows.size ();
+  for (const auto &v : row.vars) {
+    xorext.occs[v].push_back (idx);
+    xorext.count[v]++;
+    if (xorext.schedule.contains (v))
+      xorext.schedule.update (v);
+    else
+      xorext.schedule.push_back (v);
+  }
+  xorext.rows.push_back (XorRow ());
+  swap (xorext.rows.back (), row);
+}
+
+void Internal::xorext_remove_row (XorExtender &xorext, unsigned idx) {
+  XorRow &row = xorext.rows[idx];
+  assert (!row.removed);
+  row.removed = true;
+  for (const auto &v : row.vars) {
+    assert (xorext.count[v]);
+    xorext.count[v]--;
+    if (xorext.schedule.contains (v))
+      xorext.schedule.update (v);
+  }
+  if (row.traced) {
+    xorext_delete (row.proof);
+    for (size_t i = 1; i < row.chain.size (); i++)
+      xorext.unused.push_back (row.chain[i]);
+  }
+  erase_vector (row.vars);
+  erase_vector (row.chain);
+  erase_vector (row.proof.ids);
+  erase_vector (row.proof.lits);
+}
+
+/*------------------------------------------------------------------------*/
+
+// Proof tracing.
+
+void Internal::xorext_delete (XorProof &trace) {
+  auto p = trace.lits.begin ();
+  for (const auto &id : trace.ids) {
+    assert (clause.empty ());
+    while (*p)
+      clause.push_back (*p++);
+    p++;
+    proof->delete_clause (id, false, clause);
+    clause.clear ();
+  }
+  trace.clear ();
+}
+
+// Add the current 'clause' as lemma, with all literals in 'split' (from
+// position 'i' on) as case splits, which are derived first and resolved
+// away again.  Returns the clause identifier (zero for the empty clause).
+
+uint64_t Internal::xorext_lemma (const vector<int> &split, size_t i) {
+  uint64_t pos = 0, neg = 0;
+  int lit = 0;
+  if (i < split.size ()) {
+    lit = split[i];
+    clause.push_back (lit);
+    pos = xorext_lemma (split, i + 1);
+    clause.back () = -lit;
+    neg = xorext_lemma (split, i + 1);
+    clause.pop_back ();
+  }
+  uint64_t id = 0;
+  if (clause.empty ()) {
+    if (!unsat)
+      learn_empty_clause ();
+  } else {
+    id = ++clause_id;
+    proof->add_derived_clause (id, false, clause, lrat_chain);
+  }
+  if (lit) {
+    clause.push_back (lit);
+    proof->delete_clause (pos, false, clause);
+    clause.back () = -lit;
+    proof->delete_clause (neg, false, clause);
+    clause.pop_back ();
+  }
+  return id;
+}
+
+// Add the clauses of 'target' to the proof.  Each is implied by the
+// 'sources' (whose clauses have to be in the proof) through reverse unit
+// propagation after splitting on all but one of the variables which
+// cancel out in the sum of the sources: then every source is either
+// assigned completely or has only this variable left, and since the sum
+// of the sources is the target, one of them is falsified.  Without
+// 'sources' the clauses are added as they are, which for a definition of
+// a new variable (listed first) is a resolution asymmetric tautology.
+
+void Internal::xorext_derive (const Xor &target,
+                              const vector<const Xor *> &sources,
+                              XorProof &trace) {
+  vector<int> split;
+  for (const auto &source : sources)
+    for (const auto &v : source->vars) {
+      if (find (target.vars.begin (), target.vars.end (), v) !=
+          target.vars.end ())
+        continue;
+      if (find (split.begin (), split.end (), v) != split.end ())
+        continue;
+      split.push_back (v);
+    }
+  if (!split.empty ())
+    split.pop_back ();
+  const unsigned size = target.vars.size ();
+  assert (size < 32);
+  for (unsigned signs = 0; signs < (1u << size); signs++) {
+    if (parity (signs) == target.parity)
+      continue;
+    assert (clause.empty ());
+    for (unsigned i = 0; i < size; i++) {
+      const int v = target.vars[i];
+      clause.push_back ((signs & (1u << i)) ? -v : v);
+    }
+    const uint64_t id = xorext_lemma (split, 0);
+    if (id) {
+      trace.ids.push_back (id);
+      for (const auto &lit : clause)
+        trace.lits.push_back (lit);
+      trace.lits.push_back (0);
+    }
+    clause.clear ();
+  }
+}
+
+// Get an extension variable for a partial sum.
+
+int Internal::xorext_new_var (XorExtender &xorext) {
+  if (!xorext.unused.empty ()) {
+    const int idx = xorext.unused.back ();
+    xorext.unused.pop_back ();
+    return idx;
+  }
+  const int idx = max_var + 1;
+  external->init_er (idx);
+  assert (max_var == idx);
+  mark_active (idx);
+  mark_var_actively_deleted (idx, true); // not a DIP definition
+  xorext.extension.push_back (idx);
+  stats.xorext.vars++;
+  return idx;
+}
+
+// Add the partial sum 'chain.back () ^ lit' of 'row' and return its
+// definition (with the new variable first).
+
+void Internal::xorext_define (XorExtender &xorext, XorRow &row, int lit,
+                              Xor &def) {
+  const int idx = xorext_new_var (xorext);
+  def.vars = {idx, row.chain.back (), lit};
+  def.parity = false;
+  xorext_derive (def, vector<const Xor *> (), row.proof);
+  row.chain.push_back (idx);
+}
+
+// The constraint over the partial sums of 'row' introducing 'vars[i]'.
+
+bool Internal::xorext_step (const XorRow &row, size_t i, Xor &step) {
+  const size_t n = row.vars.size ();
+  const int v = row.vars[i];
+  if (n > 1 && !i)
+    return false;
+  step.vars.clear ();
+  if (i + 1 < n) {
+    step.vars = {row.chain[i], row.chain[i - 1], v};
+    step.parity = false;
+  } else {
+    if (n > 1)
+      step.vars.push_back (row.chain[n - 2]);
+    step.vars.push_back (v);
+    step.parity = row.parity;
+  }
+  return true;
+}
+
+static void xorext_sum_of (const vector<const Xor *> &sources, Xor &sum) {
+  sum.vars.clear ();
+  sum.parity = false;
+  for (const auto &source : sources) {
+    for (const auto &v : source->vars)
+      sum.vars.push_back (v);
+    sum.parity ^= source->parity;
+  }
+  sort (sum.vars.begin (), sum.vars.end ());
+  auto j = sum.vars.begin ();
+  for (auto i = j; i != sum.vars.end (); i++)
+    if (i + 1 != sum.vars.end () && *i == i[1])
+      i++;
+    else
+      *j++ = *i;
+  sum.vars.resize (j - sum.vars.begin ());
+}
+
+// Represent a row found in the formula by partial sums.
+
+void Internal::xorext_trace (XorExtender &xorext, XorRow &row) {
+  assert (!row.traced);
+  const size_t n = row.vars.size ();
+  Xor sum = row, next, def;
+  XorProof current, derived;
+  vector<const Xor *> sources;
+  row.chain.push_back (row.vars[0]);
+  for (size_t i = 1; i + 1 < n; i++) {
+    xorext_define (xorext, row, row.vars[i], def);
+    sources = {&sum, &def};
+    xorext_sum_of (sources, next);
+    xorext_derive (next, sources, derived);
+    xorext_delete (current);
+    swap (current, derived);
+    swap (sum, next);
+  }
+  if (n < 3) {
+    if (n < 2)
+      row.chain.clear ();
+    sources = {&sum};
+    xorext_derive (sum, sources, current);
+  }
+  row.proof.ids.insert (row.proof.ids.end (), current.ids.begin (),
+                        current.ids.end ());
+  row.proof.lits.insert (row.proof.lits.end (), current.lits.begin (),
+                         current.lits.end ());
+  row.traced = true;
+}
+
+/*------------------------------------------------------------------------*/
+
+// Compute 'res = a ^ b' and if a proof is traced its partial sums.
+
+void Internal::xorext_add (XorExtender &xorext, XorRow &a, XorRow &b,
+                           XorRow &res) {
+
+  const size_t n = a.vars.size (), m = b.vars.size ();
+  xorext.ticks += 1 + n + m;
+
+  res.vars.clear ();
+  res.parity = a.parity ^ b.parity;
+  {
+    size_t i = 0, j = 0;
+    while (i < n || j < m)
+      if (j == m || (i < n && a.vars[i] < b.vars[j]))
+        res.vars.push_back (a.vars[i++]);
+      else if (i == n || b.vars[j] < a.vars[i])
+        res.vars.push_back (b.vars[j++]);
+      else
+        i++, j++;
+  }
+
+  if (!proof)
+    return;
+
+  if (!a.traced)
+    xorext_trace (xorext, a);
+  if (!b.traced)
+    xorext_trace (xorext, b);
+
+  // The invariant 'sum' is that the partial sum of 'res' is the sum of the
+  // partial sums of 'a' and 'b' up to the current variable.  After the
+  // last variable of 'res' its partial sum is not introduced as variable,
+  // so that the final invariant is the tail of 'res'.
+
+  const size_t l = res.vars.size ();
+  Xor sum, next, sa, sb, def;
+  XorProof current, derived;
+  vector<const Xor *> sources;
+  size_t i = 0, j = 0, k = 0;
+  while (!unsat && (i < n || j < m)) {
+    const bool ina = i < n && (j == m || a.vars[i] <= b.vars[j]);
+    const bool inb = j < m && (i == n || b.vars[j] <= a.vars[i]);
+    const int v = ina ? a.vars[i] : b.vars[j];
+    sources.clear ();
+    if (!sum.vars.empty ())
+      sources.push_back (&sum);
+    if (ina && xorext_step (a, i, sa))
+      sources.push_back (&sa);
+    if (inb && xorext_step (b, j, sb))
+      sources.push_back (&sb);
+    if (!ina || !inb) {
+      assert (k < l), assert (res.vars[k] == v);
+      if (!k) {
+        if (l > 1)
+          res.chain.push_back (v);
+      } else if (k + 1 < l) {
+        xorext_define (xorext, res, v, def);
+        sources.push_back (&def);
+      }
+      k++;
+    }
+    i += ina, j += inb;
+    if (sources.size () == 1 && sources[0] == &sum)
+      continue;
+    xorext_sum_of (sources, next);
+    xorext_derive (next, sources, derived);
+    xorext_delete (current);
+    swap (current, derived);
+    swap (sum, next);
+    xorext.ticks += current.ids.size ();
+  }
+  assert (unsat || k == l);
+  res.proof.ids.insert (res.proof.ids.end (), current.ids.begin (),
+                        current.ids.end ());
+  res.proof.lits.insert (res.proof.lits.end (), current.lits.begin (),
+                         current.lits.end ());
+  res.traced = true;
+}
+
+/*------------------------------------------------------------------------*/
+
+// Export derived rows with at most two variables to the solver.
+
+void Internal::xorext_export (const XorRow &row) {
+  if (unsat)
+    return;
+  const size_t n = row.vars.size ();
+  if (!n) {
+    if (row.parity) {
+      LOG ("XOR elimination derived empty clause");
+      learn_empty_clause ();
+    }
+    return;
+  }
+  if (n == 1) {
+    const int lit = row.parity ? row.vars[0] : -row.vars[0];
+    const signed char tmp = val (lit);
+    if (tmp > 0)
+      return;
+    if (tmp < 0) {
+      LOG ("XOR elimination derived unit %d falsified", lit);
+      learn_empty_clause ();
+      return;
+    }
+    LOG ("XOR elimination derived unit %d", lit);
+    stats.xorext.units++;
+    assign_unit (lit);
+    return;
+  }
+  if (n > 2)
+    return;
+  const int a = row.vars[0], b = row.vars[1];
+  if (val (a) || val (b))
+    return;
+  LOG ("XOR elimination derived %d ^ %d = %d", a, b, (int) row.parity);
+  stats.xorext.equivs++;
+  const int s = row.parity ? 1 : -1;
+  assert (clause.empty ());
+  clause = {a, s * b};
+  new_derived_clause (false);
+  clause = {-a, -s * b};
+  new_derived_clause (false);
+  clause.clear ();
+}
+
+/*------------------------------------------------------------------------*/
+
+// Eliminate 'v' from the XOR system by adding the shortest row with 'v'
+// to all other rows with 'v' (or just drop the row if it is the only one).
+
+void Internal::xorext_eliminate (XorExtender &xorext, int v) {
+  vector<unsigned> live;
+  for (const auto &idx : xorext.occs[v])
+    if (!xorext.rows[idx].removed)
+      live.push_back (idx);
+  erase_vector (xorext.occs[v]);
+  if (live.empty ())
+    return;
+  unsigned pivot = live[0];
+  for (const auto &idx : live)
+    if (xorext.rows[idx].vars.size () < xorext.rows[pivot].vars.size ())
+      pivot = idx;
+  LOG ("eliminating %d from %zd XOR constraints", v, live.size ());
+  for (const auto &idx : live) {
+    if (idx == pivot)
+      continue;
+    XorRow res;
+    xorext_add (xorext, xorext.rows[pivot], xorext.rows[idx], res);
+    xorext_remove_row (xorext, idx);
+    xorext_export (res);
+    if (unsat)
+      return;
+    if (res.vars.empty ()) {
+      assert (!res.traced || res.proof.ids.empty ());
+      continue;
+    }
+    xorext_add_row (xorext, res);
+  }
+  xorext_remove_row (xorext, pivot);
+}
+
+/*------------------------------------------------------------------------*/
+
+void Internal::xorext () {
+
+  if (unsat)
+    return;
+  if (lrat || opts.check) {
+    lim.xorext = stats.conflicts + opts.xorextint;
+    return;
+  }
+
+  START (xorext);
+  stats.xorext.rounds++;
+
+  if (level)
+    backtrack ();
+  if (!propagate ()) {
+    learn_empty_clause ();
+    STOP (xorext);
+    return;
+  }
+
+  const int64_t units = stats.xorext.units;
+  const int64_t equivs = stats.xorext.equivs;
+
+  XorExtender xorext (max_var);
+  xorext_find (xorext);
+  PHASE ("xorext", stats.xorext.rounds,
+         "found %zd XOR constraints", xorext.rows.size ());
+
+  const int64_t limit = xorext.ticks + opts.xorextticks;
+  while (!unsat && !xorext.schedule.empty ()) {
+    if (xorext.ticks > limit || terminated_asynchronously ())
+      break;
+    const int v = xorext.schedule.pop_front ();
+    xorext_eliminate (xorext, v);
+  }
+
+  if (proof) {
+    for (auto &row : xorext.rows)
+      if (!row.removed && row.traced)
+        xorext_delete (row.proof);
+    for (const auto &idx : xorext.extension)
+      if (!unsat && !val (idx))
+        assign_unit (-idx);
+  }
+
+  if (!unsat && !propagate ()) {
+    LOG ("propagating XOR elimination units results in empty clause");
+    learn_empty_clause ();
+  }
+
+  const int64_t new_units = stats.xorext.units - units;
+  const int64_t new_equivs = stats.xorext.equivs - equivs;
+  PHASE ("xorext", stats.xorext.rounds,
+         "derived %" PRId64 " units and %" PRId64 " binary XORs",
+         new_units, new_equivs);
+
+  lim.xorext = stats.conflicts + opts.xorextint * (stats.xorext.rounds + 1);
+
+  STOP (xorext);
+  report ('x', !opts.reportall && !(new_units + new_equivs + unsat));
+}
+
+} // namespace CaDiCaL
@@ -0,0 +1,73 @@
+#ifndef _xorext_hpp_INCLUDED
+#define _xorext_hpp_INCLUDED
+
+#include "heap.hpp" // Alphabetically before 'xorext.hpp'.
+
+namespace CaDiCaL {
+
+// XOR constraint 'vars[0] ^ ... ^ vars[n-1] = parity' over variables.
+
+struct Xor {
+  vector<int> vars;
+  bool parity;
+  Xor () : parity (false) {}
+};
+
+// Clauses added to the proof by 'xorext' which have to be deleted again.
+
+struct XorProof {
+  vector<uint64_t> ids;
+  vector<int> lits; // zero terminated clauses
+  void clear () { ids.clear (), lits.clear (); }
+};
+
+// A row of the XOR system in 'xorext' with sorted variables.  If a proof
+// is traced, the row is represented in the proof by the definitions of
+// the partial sums 'chain[i] = chain[i-1] ^ vars[i]' for '0 < i < n-1',
+// where 'chain[0] = vars[0]', and the (binary) tail constraint
+// 'chain[n-2] ^ vars[n-1] = parity' (the unit 'vars[0] = parity' if
+// 'n = 1').  The variables 'chain[i]' for 'i > 0' are extension variables.
+
+struct XorRow : Xor {
+  bool removed;
+  bool traced;
+  vector<int> chain;
+  XorProof proof;
+  XorRow () : removed (false), traced (false) {}
+};
+
+struct xorext_more {
+  const vector<unsigned> *count;
+  xorext_more (const vector<unsigned> *c) : count (c) {}
+  bool operator() (unsigned a, unsigned b) {
+    const unsigned s = (*count)[a], t = (*count)[b];
+    if (s > t)
+      return true;
+    if (s < t)
+      return false;
+    return a > b;
+  }
+};
+
+typedef heap<xorext_more> XorSchedule;
+
+struct XorExtender {
+
+  vector<XorRow> rows;
+  vector<vector<unsigned>> occs; // rows containing a variable
+  vector<unsigned> count;        // number of live rows with a variable
+  XorSchedule schedule;          // variables with fewest rows first
+
+  vector<int> unused;    // extension variables to be reused by 'chain'
+  vector<int> extension; // all extension variables of this round
+
+  int64_t ticks;
+
+  XorExtender (int max_var)
+      : occs (max_var + 1), count (max_var + 1, 0),
+        schedule (xorext_more (&count)), ticks (0) {}
+};
+
+} // namespace CaDiCaL
+
+#endif
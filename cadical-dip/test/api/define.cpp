@@ -0,0 +1,108 @@
+#include "../../src/cadical.hpp"
+#ifdef NDEBUG
+#undef NDEBUG
+#endif
+#include <cassert>
+#include <cstdint>
+#include <vector>
+using namespace std;
+
+// User supplied extension definitions through 'define_or' and 'define_and'
+// before and between incremental calls, checked against the model.
+
+static bool holds (CaDiCaL::Solver &solver, int lit) {
+  return solver.val (lit) > 0;
+}
+
+static int pick (uint64_t &state, int vars) {
+  state = state * 6364136223846793005ul + 1442695040888963407ul;
+  const int idx = (int) ((state >> 33) % vars) + 1;
+  return (state >> 20) & 1 ? idx : -idx;
+}
+
+static void check (CaDiCaL::Solver &solver, int z, int a, int o) {
+  assert (holds (solver, z) == (holds (solver, 1) || holds (solver, 2)));
+  assert (holds (solver, a) == (holds (solver, 1) && holds (solver, -3)));
+  assert (holds (solver, o) ==
+          (holds (solver, z) || holds (solver, 3) || holds (solver, -4)));
+}
+
+int main () {
+  CaDiCaL::Solver solver;
+  solver.set ("diplearning", 1);
+
+  // Random 3-SAT formula over 60 variables with ratio 3.
+
+  const int vars = 60;
+  uint64_t state = 7;
+  for (int i = 0; i < 3 * vars; i++) {
+    for (int j = 0; j < 3; j++)
+      solver.add (pick (state, vars));
+    solver.add (0);
+  }
+
+  const int z = solver.define_or ({1, 2});
+  assert (z == vars + 1);
+  assert (solver.define_or ({2, 1}) == z);
+  const int a = solver.define_and ({1, -3});
+  assert (a == -(vars + 2)); // as '-a <-> -1 | 3'
+  const int o = solver.define_or ({z, 3, -4});
+  assert (o == vars + 3);
+
+  int res = solver.solve ();
+  assert (res == 10);
+  check (solver, z, a, o);
+
+  // Using the definitions keeps them.
+
+  for (int i = 0; i < 2; i++) {
+    solver.assume (i ? -z : z);
+    solver.assume (-1);
+    res = solver.solve ();
+    if (res == 10) {
+      check (solver, z, a, o);
+      assert (holds (solver, i ? -2 : 2));
+    } else
+      assert (res == 20);
+  }
+
+  solver.add (-a), solver.add (o), solver.add (0);
+  res = solver.solve ();
+  if (res == 10)
+    check (solver, z, a, o), assert (!holds (solver, a));
+
+  // Fixed literals are simplified away.
+
+  const int t = solver.vars () + 1;
+  solver.add (t), solver.add (0);
+  assert (solver.define_or ({t, t + 1}) == t);
+  assert (solver.define_and ({t, t + 2}) == t + 2);
+  assert (solver.define_and ({-t, t + 2}) == -t);
+
+  // Unused definitions are kept when 'remove_extended' deletes extended
+  // variables, which needs many DIP definitions, here on a random 3-SAT
+  // formula over 300 variables at the threshold.
+
+  CaDiCaL::Solver other;
+  other.set ("diplearning", 1);
+  other.set ("diplearningmin", 1);
+  for (int i = 0; i < 426 * 3; i++) {
+    for (int j = 0; j < 3; j++)
+      other.add (pick (state, 300));
+    other.add (0);
+  }
+  vector<int> defined;
+  for (int i = 1; i < 100; i++)
+    defined.push_back (other.define_or ({i, -(i + 1)}));
+  other.limit ("conflicts", 10000);
+  res = other.solve ();
+  assert (!res);
+  for (int i = 1; i < 100; i++) {
+    const int d = defined[i - 1];
+    assert (other.define_or ({-(i + 1), i}) == d);
+    other.assume (-d), other.assume (i);
+    assert (other.solve () == 20);
+  }
+
+  return 0;
+}
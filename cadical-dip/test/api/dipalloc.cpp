@@ -0,0 +1,69 @@
+#include "../../src/cadical.hpp"
+#ifdef NDEBUG
+#define RELEASE // same flags as the library
+#undef NDEBUG
+#endif
+#include <cassert>
+#include <cstdint>
+#include <cstdlib>
+#include <new>
+using namespace std;
+
+// DIP conflict analysis reuses its buffers and thus should not allocate
+// in steady state.  Count heap allocations with a replaced global
+// 'operator new' over a fixed number of conflicts after a warm-up phase.
+// What remains are the learned clauses themselves and the amortized growth
+// of watch lists and clause arenas (without reused buffers there were more
+// than 40 allocations per conflict).  Assertion checking code allocates
+// too, so the bound is only enforced if the library is built without.
+
+static size_t allocations;
+
+void *operator new (size_t bytes) {
+  allocations++;
+  void *res = malloc (bytes ? bytes : 1);
+  if (!res)
+    throw bad_alloc ();
+  return res;
+}
+
+void operator delete (void *ptr) noexcept { free (ptr); }
+void operator delete (void *ptr, size_t) noexcept { free (ptr); }
+
+int main () {
+  CaDiCaL::Solver solver;
+  solver.set ("diplearning", 1);
+
+  // Random 3-SAT formula over 300 variables at the threshold, which is not
+  // solved within the conflicts below.
+
+  const int vars = 300;
+  uint64_t state = 7;
+  auto pick = [&] () {
+    state = state * 6364136223846793005ul + 1442695040888963407ul;
+    const int idx = (int) ((state >> 33) % vars) + 1;
+    return (state >> 20) & 1 ? idx : -idx;
+  };
+  for (int i = 0; i < 426 * vars / 100; i++) {
+    for (int j = 0; j < 3; j++)
+      solver.add (pick ());
+    solver.add (0);
+  }
+
+  solver.limit ("conflicts", 2000);
+  int res = solver.solve ();
+  assert (!res);
+
+  const int conflicts = 4000;
+  const size_t before = allocations;
+  solver.limit ("conflicts", conflicts);
+  res = solver.solve ();
+  assert (!res);
+#ifdef RELEASE
+  assert (allocations - before < 5u * conflicts);
+#else
+  (void) before;
+#endif
+
+  return 0;
+}
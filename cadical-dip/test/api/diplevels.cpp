@@ -0,0 +1,58 @@
+#include "../../src/cadical.hpp"
+#ifdef NDEBUG
+#undef NDEBUG
+#endif
+#include <cassert>
+#include <cstdint>
+#include <vector>
+using namespace std;
+
+// Multi-level DIP learning ('diplearninglevels') replaces literals on lower
+// decision levels by extended variables, which are assigned out-of-order.
+// Random 3-SAT formulas close to the threshold are solved with it and the
+// result is compared to the plain solver.  Satisfying assignments are
+// checked against the formula.  With assertions in the library this also
+// checks that the level marks are cleared after each conflict.
+
+static int pick (uint64_t &state, int vars) {
+  state = state * 6364136223846793005ul + 1442695040888963407ul;
+  const int idx = (int) ((state >> 33) % vars) + 1;
+  return (state >> 20) & 1 ? idx : -idx;
+}
+
+int main () {
+  const int vars = 120;
+  for (uint64_t seed = 1; seed <= 8; seed++) {
+    CaDiCaL::Solver solver, plain;
+    solver.set ("diplearning", 1);
+    solver.set ("diplearningmin", 1);
+    solver.set ("diplearninglevels", 3);
+
+    vector<int> formula;
+    uint64_t state = seed;
+    for (int i = 0; i < 426 * vars / 100; i++) {
+      for (int j = 0; j < 3; j++) {
+        const int lit = pick (state, vars);
+        formula.push_back (lit);
+        solver.add (lit);
+        plain.add (lit);
+      }
+      formula.push_back (0);
+      solver.add (0);
+      plain.add (0);
+    }
+
+    const int res = solver.solve ();
+    assert (res == plain.solve ());
+    if (res != 10)
+      continue;
+    bool satisfied = false;
+    for (const auto &lit : formula)
+      if (!lit) {
+        assert (satisfied);
+        satisfied = false;
+      } else if (solver.val (lit) > 0)
+        satisfied = true;
+  }
+  return 0;
+}
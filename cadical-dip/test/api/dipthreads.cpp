@@ -0,0 +1,66 @@
+#include "../../src/cadical.hpp"
+#include <cstdint>
+#include <thread>
+#include <vector>
+using namespace std;
+
+// DIP learning state has to be per solver.  Solve the same random XOR
+// formula sequentially and then concurrently in several threads and check
+// that every solver sees exactly the same search (same result and same
+// number of learned clauses).  Then solve again incrementally.
+
+static const int vars = 200, xors = 200, threads = 4;
+
+static void encode (CaDiCaL::Solver &solver) {
+  uint64_t state = 42;
+  auto pick = [&] () {
+    state = state * 6364136223846793005ul + 1442695040888963407ul;
+    return (int) ((state >> 33) % vars) + 1;
+  };
+  for (int i = 0; i < xors; i++) {
+    int a = pick (), b, c;
+    do b = pick (); while (b == a);
+    do c = pick (); while (c == a || c == b);
+    const bool parity = (i * 7) & 1;
+    for (int signs = 0; signs < 8; signs++) {
+      const bool odd = ((signs ^ (signs >> 1) ^ (signs >> 2)) & 1);
+      if (odd == parity) continue;
+      solver.add (signs & 1 ? -a : a);
+      solver.add (signs & 2 ? -b : b);
+      solver.add (signs & 4 ? -c : c);
+      solver.add (0);
+    }
+  }
+}
+
+struct Run {
+  int res[2];
+  int64_t redundant;
+};
+
+static void run (Run &r) {
+  CaDiCaL::Solver solver;
+  solver.set ("diplearning", 1);
+  solver.set ("diplearningmin", 2);
+  encode (solver);
+  solver.assume (1);
+  r.res[0] = solver.solve ();
+  r.redundant = solver.redundant ();
+  r.res[1] = solver.solve ();
+}
+
+int main () {
+  Run expected;
+  run (expected);
+  vector<Run> runs (threads);
+  vector<thread> workers;
+  for (auto &r : runs)
+    workers.push_back (thread (run, ref (r)));
+  for (auto &w : workers)
+    w.join ();
+  for (const auto &r : runs)
+    if (r.res[0] != expected.res[0] || r.res[1] != expected.res[1] ||
+        r.redundant != expected.redundant)
+      return 1;
+  return 0;
+}
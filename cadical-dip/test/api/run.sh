@@ -113,6 +113,10 @@ run cfreeze
 run traverse
 run cipasir
 run incproof
+run dipthreads
+run define
+run dipalloc
+run diplevels
 
 if [ "`grep DNTRACING $makefile`" = "" ]
 then
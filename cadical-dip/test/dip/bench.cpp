@@ -0,0 +1,92 @@
+// Timing suite for 'TwoVertexBottlenecks' in the spirit of Google
+// Benchmark: every configuration is repeated until it ran for at least
+// 'min_time' seconds and the time per call is reported.  Without
+// arguments random graphs are generated sweeping the number of vertices,
+// the average in-degree and the window of predecessors (which bounds the
+// length of paths from below).  Otherwise the given files of graphs dumped
+// by the solver through 'CADICAL_DIP_DUMP' are replayed.
+//
+//   bench [ <dump> ... ]
+
+#include "dipgraph.hpp"
+
+#include <chrono>
+#include <string>
+
+static const double min_time = 0.2;
+static const int graphs_per_config = 8;
+
+static double seconds () {
+  using namespace std::chrono;
+  return duration<double> (steady_clock::now ().time_since_epoch ())
+      .count ();
+}
+
+static void header () {
+  printf ("%-40s %12s %12s %12s %10s\n", "Benchmark", "Time", "Per-edge",
+          "Iterations", "Bottleneck");
+  printf ("%s\n", std::string (90, '-').c_str ());
+}
+
+// One iteration calls the engine once on every graph as the solver does,
+// i.e., with the same object reused across calls.
+
+static void run (const std::string &name, const std::vector<DIPGraph> &gs) {
+  TwoVertexBottlenecks tvb;
+  long edges = 0, found = 0;
+  for (const auto &g : gs) {
+    edges += g.edges ();
+    found += tvb.CalcBottlenecks (g.predecessors, g.predIndex) > 0;
+  }
+  long iterations = 0;
+  double start = seconds (), elapsed = 0;
+  for (long n = 1; elapsed < min_time; n *= 2) {
+    for (long i = 0; i < n; i++)
+      for (const auto &g : gs)
+        tvb.CalcBottlenecks (g.predecessors, g.predIndex);
+    iterations += n;
+    elapsed = seconds () - start;
+  }
+  const double calls = (double) iterations * gs.size ();
+  printf ("%-40s %9.3f us %9.3f ns %12ld %9.0f%%\n", name.c_str (),
+          1e6 * elapsed / calls, 1e9 * elapsed / (iterations * edges),
+          iterations, 100.0 * found / gs.size ());
+  fflush (stdout);
+}
+
+int main (int argc, char **argv) {
+  header ();
+  if (argc > 1) {
+    for (int i = 1; i < argc; i++) {
+      FILE *file = fopen (argv[i], "r");
+      if (!file) {
+        fprintf (stderr, "bench: can not read '%s'\n", argv[i]);
+        return 1;
+      }
+      std::vector<DIPGraph> gs;
+      DIPGraph g;
+      while (read_dip_graph (file, g))
+        gs.push_back (g);
+      fclose (file);
+      if (gs.empty ()) {
+        fprintf (stderr, "bench: no graphs in '%s'\n", argv[i]);
+        return 1;
+      }
+      run ("replay/" + std::string (argv[i]), gs);
+    }
+    return 0;
+  }
+  std::mt19937 rng (42);
+  for (int n : {100, 1000, 10000, 100000})
+    for (double degree : {1.5, 2.5, 4.0})
+      for (int window : {2, 8, 64}) {
+        std::vector<DIPGraph> gs;
+        for (int i = 0; i < graphs_per_config; i++)
+          gs.push_back (random_dip_graph (rng, n, degree, window));
+        char name[64];
+        snprintf (name, sizeof name, "random/N:%d/degree:%.1f/window:%d", n,
+                  degree, window);
+        run (name, gs);
+      }
+  return 0;
+}
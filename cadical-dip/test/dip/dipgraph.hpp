@@ -0,0 +1,182 @@
+#ifndef _dipgraph_hpp_INCLUDED
+#define _dipgraph_hpp_INCLUDED
+
+// Shared by the fuzzer 'fuzz.cpp' and the benchmark 'bench.cpp' of the
+// two-vertex bottleneck engine used for DIP learning.  Both are compiled
+// stand-alone against 'twovertexbottlenecks.cpp' (see 'run.sh'), which
+// by defining 'TVB_XMAPLE' can also be the copy in 'xMapleLCM-DIP/core'.
+
+#ifdef TVB_XMAPLE
+#include "TwoVertexBottlenecks.h"
+#else
+#include "../../src/twovertexbottlenecks.hpp"
+#endif
+
+#include <algorithm>
+#include <cstdio>
+#include <random>
+#include <set>
+#include <utility>
+#include <vector>
+
+/*------------------------------------------------------------------------*/
+
+// A graph in the input format of 'TwoVertexBottlenecks::CalcBottlenecks',
+// i.e., vertex '0' is the sink, 'N-1' the source and predecessors of a
+// vertex have a larger index.
+
+struct DIPGraph {
+  std::vector<int> predecessors;
+  std::vector<int> predIndex;
+
+  int size () const { return (int) predIndex.size (); }
+  int edges () const { return (int) predecessors.size (); }
+
+  const int *begin (int v) const {
+    return predecessors.data () + predIndex[v];
+  }
+  const int *end (int v) const {
+    return predecessors.data () +
+           (v + 1 < size () ? predIndex[v + 1] : edges ());
+  }
+};
+
+/*------------------------------------------------------------------------*/
+
+// Random topologically sorted DAG with 'n >= 3' vertices.  Every vertex
+// besides the source gets on average 'degree' predecessors among the next
+// 'window' vertices, thus a small window yields long paths.  Every vertex
+// besides the sink is further given a successor, so that all vertices lie
+// on a path from the source to the sink, as in a conflict graph.
+
+inline DIPGraph random_dip_graph (std::mt19937 &rng, int n, double degree,
+                                  int window) {
+  std::vector<std::vector<int>> preds (n);
+  std::vector<bool> has_succ (n, false);
+  std::uniform_real_distribution<double> coin (0, 1);
+  const int floor_degree = (int) degree;
+  for (int v = 0; v + 1 < n; v++) {
+    const int hi = std::min (n - 1, v + window);
+    const int candidates = hi - v;
+    int k = floor_degree + (coin (rng) < degree - floor_degree);
+    k = std::max (1, std::min (k, candidates));
+    std::vector<int> &p = preds[v];
+    while ((int) p.size () < k) {
+      const int u = v + 1 + (int) (rng () % candidates);
+      if (std::find (p.begin (), p.end (), u) == p.end ())
+        p.push_back (u), has_succ[u] = true;
+    }
+  }
+  for (int u = 1; u + 1 < n; u++) {
+    if (has_succ[u])
+      continue;
+    const int lo = std::max (0, u - window);
+    const int v = lo + (int) (rng () % (u - lo));
+    preds[v].push_back (u);
+  }
+  DIPGraph g;
+  for (int v = 0; v < n; v++) {
+    g.predIndex.push_back (g.edges ());
+    std::sort (preds[v].begin (), preds[v].end ());
+    for (const auto &u : preds[v])
+      g.predecessors.push_back (u);
+  }
+  return g;
+}
+
+/*------------------------------------------------------------------------*/
+
+// Graphs are dumped by the solver if 'CADICAL_DIP_DUMP' is set and read
+// back here.  Each record is 'p dip <N> <M>' followed by the 'N' entries
+// of 'predIndex' and the 'M' entries of 'predecessors'.
+
+inline void write_dip_graph (FILE *file, const DIPGraph &g) {
+  fprintf (file, "p dip %d %d\n", g.size (), g.edges ());
+  for (const auto &x : g.predIndex)
+    fprintf (file, "%d ", x);
+  fputc ('\n', file);
+  for (const auto &x : g.predecessors)
+    fprintf (file, "%d ", x);
+  fputc ('\n', file);
+}
+
+inline bool read_dip_graph (FILE *file, DIPGraph &g) {
+  int n, m;
+  if (fscanf (file, " p dip %d %d", &n, &m) != 2 || n < 2 || m < 0)
+    return false;
+  g.predIndex.resize (n);
+  g.predecessors.resize (m);
+  for (auto &x : g.predIndex)
+    if (fscanf (file, "%d", &x) != 1)
+      return false;
+  for (auto &x : g.predecessors)
+    if (fscanf (file, "%d", &x) != 1)
+      return false;
+  return true;
+}
+
+/*------------------------------------------------------------------------*/
+
+// Brute-force reference.  The source reaches the sink without the
+// 'removed' vertices iff the source is reached backwards from the sink,
+// which in topological order is a single pass over the edges.
+
+inline bool connected (const DIPGraph &g, const std::vector<bool> &removed,
+                       std::vector<bool> &reached) {
+  const int n = g.size ();
+  reached.assign (n, false);
+  reached[0] = true;
+  for (int v = 0; v < n; v++) {
+    if (!reached[v] || removed[v])
+      continue;
+    for (const int *p = g.begin (v); p != g.end (v); p++)
+      reached[*p] = true;
+  }
+  return reached[n - 1];
+}
+
+// Vertices from which 'v' is reachable, including 'v' itself.
+
+inline void ancestors (const DIPGraph &g, int v, std::vector<bool> &res) {
+  const int n = g.size ();
+  res.assign (n, false);
+  res[v] = true;
+  for (int u = v; u < n; u++) {
+    if (!res[u])
+      continue;
+    for (const int *p = g.begin (u); p != g.end (u); p++)
+      res[*p] = true;
+  }
+}
+
+struct DIPReference {
+  std::vector<int> single;                  // single vertex bottlenecks
+  std::set<std::pair<int, int>> pairs;      // two vertex bottlenecks
+};
+
+inline DIPReference reference_bottlenecks (const DIPGraph &g) {
+  DIPReference res;
+  const int n = g.size ();
+  std::vector<bool> removed (n, false), reached;
+  for (int v = 1; v + 1 < n; v++) {
+    removed[v] = true;
+    if (!connected (g, removed, reached))
+      res.single.push_back (v);
+    removed[v] = false;
+  }
+  if (!res.single.empty ())
+    return res;
+  for (int u = 1; u + 1 < n; u++) {
+    removed[u] = true;
+    for (int v = u + 1; v + 1 < n; v++) {
+      removed[v] = true;
+      if (!connected (g, removed, reached))
+        res.pairs.insert ({u, v});
+      removed[v] = false;
+    }
+    removed[u] = false;
+  }
+  return res;
+}
+
+#endif
@@ -0,0 +1,142 @@
+// Compares 'TwoVertexBottlenecks' on random topologically sorted DAGs
+// against the brute-force reference in 'dipgraph.hpp'.  A failing graph
+// is written to 'fuzz-failed.dip' in the format of 'CADICAL_DIP_DUMP'.
+//
+//   fuzz [ <graphs> [ <seed> ] ]
+
+#include "dipgraph.hpp"
+
+#include <cstdlib>
+#include <string>
+
+typedef TwoVertexBottlenecks::VertPairInfo Info;
+
+static std::string error;
+
+static bool fail (const char *msg, int x = -1, int y = -1) {
+  error = msg;
+  if (x >= 0)
+    error += " " + std::to_string (x);
+  if (y >= 0)
+    error += " " + std::to_string (y);
+  return false;
+}
+
+static bool is_pred (const DIPGraph &g, int v, int u) {
+  return std::find (g.begin (v), g.end (v), u) != g.end (v);
+}
+
+// The path has to go from the source to the sink along edges and the
+// list entries have to be increasing and refer to their path position.
+
+static bool check_path (const DIPGraph &g, const std::vector<int> &path,
+                        const std::vector<Info> &list) {
+  const int n = g.size ();
+  if (path.size () < 2 || path.front () != n - 1 || path.back () != 0)
+    return fail ("path does not connect source to sink");
+  for (size_t i = 0; i + 1 < path.size (); i++)
+    if (!is_pred (g, path[i + 1], path[i]))
+      return fail ("path uses missing edge", path[i], path[i + 1]);
+  for (size_t i = 0; i < list.size (); i++) {
+    const Info &e = list[i];
+    if (i && list[i - 1].vertNum >= e.vertNum)
+      return fail ("list not increasing at", e.vertNum);
+    if (e.pathPos < 0 || e.pathPos >= (int) path.size () ||
+        path[e.pathPos] != e.vertNum)
+      return fail ("wrong path position of", e.vertNum);
+    if (e.sinkDist != (int) path.size () - 1 - e.pathPos)
+      return fail ("wrong sink distance of", e.vertNum);
+  }
+  return true;
+}
+
+// Every vertex of 'other' above 'minAncestor' has to reach the vertex.
+
+static bool check_ancestors (const DIPGraph &g, const std::vector<Info> &list,
+                             const std::vector<Info> &other) {
+  std::vector<bool> anc;
+  for (const auto &e : list) {
+    ancestors (g, e.vertNum, anc);
+    for (const auto &f : other)
+      if (f.vertNum > e.minAncestor && !anc[f.vertNum])
+        return fail ("wrong minimal ancestor bound", e.vertNum, f.vertNum);
+  }
+  return true;
+}
+
+static bool check (TwoVertexBottlenecks &tvb, const DIPGraph &g) {
+  const DIPReference ref = reference_bottlenecks (g);
+  const int res = tvb.CalcBottlenecks (g.predecessors, g.predIndex);
+  if (!ref.single.empty ()) {
+    if (res != -1)
+      return fail ("expected single vertex bottleneck but got", res);
+    if (tvb.SingleVertBottleneck != ref.single.front ())
+      return fail ("wrong single vertex bottleneck",
+                   tvb.SingleVertBottleneck, ref.single.front ());
+    return true;
+  }
+  if (ref.pairs.empty ())
+    return res == 0 ? true : fail ("expected 3-connected but got", res);
+  if (res < 4 || res > 7)
+    return fail ("expected bottlenecks but got", res);
+
+  const auto &A = tvb.GetVertListA (), &B = tvb.GetVertListB ();
+  if (A.empty () || B.empty ())
+    return fail ("empty vertex list");
+  if (!check_path (g, tvb.GetPathA (), A) ||
+      !check_path (g, tvb.GetPathB (), B))
+    return false;
+  if (((res - 4) >> 1) != (A[0].sinkDist == 1))
+    return fail ("wrong return code bit for list A", res);
+  if (((res - 4) & 1) != (B[0].sinkDist == 1))
+    return fail ("wrong return code bit for list B", res);
+  if (!check_ancestors (g, A, B) || !check_ancestors (g, B, A))
+    return false;
+
+  std::set<std::pair<int, int>> pairs;
+  for (const auto &a : A)
+    for (const auto &b : B) {
+      const bool from_a = a.minPair <= b.vertNum && b.vertNum <= a.maxPair;
+      const bool from_b = b.minPair <= a.vertNum && a.vertNum <= b.maxPair;
+      if (from_a != from_b)
+        return fail ("inconsistent pair bounds", a.vertNum, b.vertNum);
+      if (from_a)
+        pairs.insert ({std::min (a.vertNum, b.vertNum),
+                       std::max (a.vertNum, b.vertNum)});
+    }
+  for (const auto &p : ref.pairs)
+    if (!pairs.count (p))
+      return fail ("missing bottleneck", p.first, p.second);
+  for (const auto &p : pairs)
+    if (!ref.pairs.count (p))
+      return fail ("spurious bottleneck", p.first, p.second);
+  return true;
+}
+
+int main (int argc, char **argv) {
+  const long graphs = argc > 1 ? atol (argv[1]) : 20000;
+  const unsigned seed = argc > 2 ? atoi (argv[2]) : 42;
+  std::mt19937 rng (seed);
+  TwoVertexBottlenecks tvb; // reused as in the solver
+  long counts[3] = {0, 0, 0};
+  for (long i = 0; i < graphs; i++) {
+    const int n = 3 + (int) (rng () % 40);
+    const double degree = 1 + (rng () % 30) / 10.0;
+    const int window = 1 + (int) (rng () % 8);
+    const DIPGraph g = random_dip_graph (rng, n, degree, window);
+    if (!check (tvb, g)) {
+      printf ("graph %ld (n %d, degree %.1f, window %d): %s\n", i, n,
+              degree, window, error.c_str ());
+      FILE *file = fopen ("fuzz-failed.dip", "w");
+      if (file)
+        write_dip_graph (file, g), fclose (file);
+      return 1;
+    }
+    const int res = tvb.CalcBottlenecks (g.predecessors, g.predIndex);
+    counts[res < 0 ? 0 : res ? 2 : 1]++;
+  }
+  printf ("checked %ld graphs: %ld not 2-connected, %ld 3-connected, "
+          "%ld with bottlenecks\n",
+          graphs, counts[0], counts[1], counts[2]);
+  return 0;
+}
@@ -0,0 +1,100 @@
+#!/bin/sh
+
+# Stand-alone tests of the two-vertex bottleneck engine used for DIP
+# learning.  By default runs the fuzzer against the brute-force reference.
+# With 'bench' runs the timing suite instead, on random graphs or on the
+# given graph dumps (written by the solver to the file named by the
+# environment variable 'CADICAL_DIP_DUMP').  With '--xmaple' the copy of
+# the engine in 'xMapleLCM-DIP/core' is tested instead.
+#
+#   ./dip/run.sh [ --xmaple ] [ bench [ <dump> ... ] ]
+
+#--------------------------------------------------------------------------#
+
+die () {
+  cecho "${HIDE}test/dip/run.sh:${NORMAL} ${BAD}error:${NORMAL} $*"
+  exit 1
+}
+
+msg () {
+  cecho "${HIDE}test/dip/run.sh:${NORMAL} $*"
+}
+
+for dir in . .. ../..
+do
+  [ -f $dir/scripts/colors.sh ] || continue
+  . $dir/scripts/colors.sh || exit 1
+  break
+done
+
+#--------------------------------------------------------------------------#
+
+[ -d ../test -a -d ../test/dip ] || \
+die "needs to be called from a top-level sub-directory of CaDiCaL"
+
+[ x"$CADICALBUILD" = x ] && CADICALBUILD="../build"
+
+[ -f "$CADICALBUILD/makefile" ] || \
+  die "can not find '$CADICALBUILD/makefile' (run 'configure' first)"
+
+engine=../src/twovertexbottlenecks.cpp
+defines=""
+if [ x"$1" = x--xmaple ]
+then
+  core=../../xMapleLCM-DIP/core
+  engine=$core/TwoVertexBottlenecks.cc
+  defines="-I$core -DTVB_XMAPLE"
+  shift
+fi
+
+[ -f $engine ] || die "can not find '$engine'"
+
+#--------------------------------------------------------------------------#
+
+makefile=$CADICALBUILD/makefile
+
+CXX=`grep '^CXX=' "$makefile"|sed -e 's,CXX=,,'`
+CXXFLAGS=`grep '^CXXFLAGS=' "$makefile"|sed -e 's,CXXFLAGS=,,'`
+
+msg "using CXX=$CXX"
+msg "using CXXFLAGS=$CXXFLAGS"
+msg "using engine '$engine'"
+
+tests=../test/dip
+
+compile () {
+  name=$CADICALBUILD/test-dip-$1
+  rm -f $name
+  cecho "$CXX $CXXFLAGS $defines -o $name $tests/$1.cpp $engine"
+  $CXX $CXXFLAGS $defines -o $name $tests/$1.cpp $engine || \
+    die "compiling '$1' failed"
+}
+
+if [ x"$1" = xbench ]
+then
+  shift
+  cecho -n "$HILITE"
+  cecho "---------------------------------------------------------"
+  cecho "DIP bottleneck benchmark in '$CADICALBUILD'"
+  cecho "---------------------------------------------------------"
+  cecho -n "$NORMAL"
+  compile bench
+  exec $CADICALBUILD/test-dip-bench $*
+fi
+
+cecho -n "$HILITE"
+cecho "---------------------------------------------------------"
+cecho "DIP bottleneck testing in '$CADICALBUILD'"
+cecho "---------------------------------------------------------"
+cecho -n "$NORMAL"
+
+compile fuzz
+msg "running ${HILITE}'fuzz'${NORMAL}"
+if (cd $CADICALBUILD && ./test-dip-fuzz)
+then
+  cecho "# 0 ... ${GOOD}ok${NORMAL} (zero exit code)"
+  exit 0
+else
+  cecho "# 0 ... ${BAD}failed${NORMAL} (non-zero exit code)"
+  exit 1
+fi
@@ -0,0 +1,67 @@
+#!/bin/sh
+
+# Compares two runs of 'run.sh' given by their directories or 'results.csv'
+# files.  Prints every instance on which the status differs or the time
+# differs by more than the given factor (default 1.5), followed by the
+# number of solved instances, the PAR-2 score and the average number of
+# conflicts and propagations per second over instances solved by both.
+#
+#   compare.sh [ -r <ratio> ] <run1> <run2>
+
+name=compare.sh
+
+die () {
+  echo "$name: error: $*" 1>&2
+  exit 1
+}
+
+ratio=1.5
+if [ x"$1" = x-r ]
+then
+  ratio=$2
+  shift 2
+fi
+
+[ $# = 2 ] || die "expected two runs"
+
+csv1=$1; [ -d $csv1 ] && csv1=$csv1/results.csv
+csv2=$2; [ -d $csv2 ] && csv2=$csv2/results.csv
+[ -f $csv1 ] || die "can not find '$csv1'"
+[ -f $csv2 ] || die "can not find '$csv2'"
+
+awk -F , -v ratio=$ratio -v name1="$1" -v name2="$2" '
+function solved(s) { return s == "SAT" || s == "UNSAT" }
+FNR == 1 { file++; next }
+file == 1 { key = $1 "/" $2; status1[key] = $3; time1[key] = $4; par1[key] = $5
+            cps1[key] = $8; pps1[key] = $9; next }
+{
+  key = $1 "/" $2
+  if (!(key in status1)) { missing++; next }
+  n++
+  s1 = status1[key]; s2 = $3; t1 = time1[key]; t2 = $4
+  if (solved(s1)) solved1++
+  if (solved(s2)) solved2++
+  par2_1 += par1[key]; par2_2 += $5
+  if (solved(s1) && solved(s2)) {
+    both++
+    cps_1 += cps1[key]; cps_2 += $8; pps_1 += pps1[key]; pps_2 += $9
+  }
+  if (s1 != s2 || (t1 > 1 && t2 > ratio * t1) || (t2 > 1 && t1 > ratio * t2)) {
+    if (!diffs++)
+      printf "%-60s %8s %10s %8s %10s\n", "instance", "status1", "time1", "status2", "time2"
+    printf "%-60s %8s %10.2f %8s %10.2f\n", key, s1, t1, s2, t2
+  }
+}
+END {
+  if (diffs) printf "\n"
+  printf "%-24s %16s %16s\n", "", name1, name2
+  printf "%-24s %16d %16d\n", "solved", solved1, solved2
+  printf "%-24s %16.2f %16.2f\n", "PAR-2", par2_1, par2_2
+  if (both) {
+    printf "%-24s %16.0f %16.0f\n", "conflicts/sec (both)", cps_1 / both, cps_2 / both
+    printf "%-24s %16.0f %16.0f\n", "propagations/sec (both)", pps_1 / both, pps_2 / both
+  }
+  printf "%d common instances, %d solved by both", n, both
+  if (missing) printf ", %d only in the second run", missing
+  printf "\n"
+}' $csv1 $csv2
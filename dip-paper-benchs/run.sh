@@ -0,0 +1,202 @@
+#!/bin/sh
+
+# Runs one of the solvers of this repository on benchmark families with a
+# time and memory limit per instance and several instances in parallel.
+# Every run gets a directory with the solver logs and a 'results.csv'
+# (see 'README.md' for its columns), which can be appended to an SQLite
+# data base too and be compared with another run by 'compare.sh'.
+
+#--------------------------------------------------------------------------#
+
+name=run.sh
+benchsdir=`dirname $0`
+rootdir=$benchsdir/..
+
+die () {
+  echo "$name: error: $*" 1>&2
+  exit 1
+}
+
+msg () {
+  echo "c [$name] $*"
+}
+
+usage () {
+cat <<EOF
+usage: $name [ <option> ... ] <solver> [ <family> ... ]
+
+where '<option>' is one of the following
+
+  -h             print this command line option summary
+  -t <seconds>   time limit per instance (default 5000)
+  -m <mb>        memory limit per instance (default 16384)
+  -j <jobs>      number of instances run in parallel (default 1)
+  -o <dir>       run directory (default 'runs/<solver>-<date>')
+  -d <db>        also append the results to this SQLite data base
+  -f "<flags>"   additional command line flags for the solver
+
+and '<solver>' is one of
+
+  cadical        cadical-original/build/cadical
+  cadical-nodip  cadical-dip/build/cadical --diplearning=0
+  cadical-dip    cadical-dip/build/cadical --diplearning=1
+  xmaplelcm      xMapleLCM/bin/xmaplelcm
+  xmaplelcm-dip  xMapleLCM-DIP/bin/xmaplelcm
+  glucoser       glucoser-1.0/ER/glucoser
+  maplefps       LStech-Maple-FPS/core/maplefps
+
+Families are the sub-directories of 'dip-paper-benchs' (default all) or
+any other directory with CNF files.
+EOF
+}
+
+#--------------------------------------------------------------------------#
+
+# Internal mode used for the parallel jobs:
+#
+#   run.sh --instance <dir> <time> <mb> <solver> ... <cnf>
+#
+# runs the solver on a single instance and prints its CSV result line.
+
+if [ x"$1" = x--instance ]
+then
+  dir=$2; time=$3; mb=$4; shift 4
+  for cnf
+  do
+    :
+  done
+  family=`basename \`dirname $cnf\``
+  instance=`basename $cnf`
+  log=$dir/$family-$instance.log
+  start=`date +%s.%N`
+  ( ulimit -v `expr $mb \* 1024`; exec timeout $time "$@" ) > $log 2>&1
+  res=$?
+  end=`date +%s.%N`
+  awk -v family=$family -v instance=$instance -v res=$res \
+      -v start=$start -v end=$end -v limit=$time '
+function number(s) { sub(/^[^:]*:[ \t]*/, "", s); split(s, a, /[ \t]/); return a[1] }
+{ key = $0; sub(/^c /, "", key); sub(/[ \t]*:.*/, "", key) }
+key == "conflicts" { conflicts = number($0) }
+key == "propagations" { propagations = number($0) }
+key == "dip_conflicts" || key == "dip-conflicts" ||
+key == "conflicts w/ DIP-learning" { dip = number($0) }
+key == "num_ext_vars" || key == "total ext vars" { ext = number($0) }
+key == "Memory used" ||
+key == "maximum resident set size of process" { memory = number($0) }
+/^(s )?SATISFIABLE/ { status = "SAT" }
+/^(s )?UNSATISFIABLE/ { status = "UNSAT" }
+END {
+  time = end - start
+  if (status == "" && res == 10) status = "SAT"
+  if (status == "" && res == 20) status = "UNSAT"
+  if (status == "") status = (res == 124) ? "TIMEOUT" : "UNKNOWN"
+  par2 = (status == "SAT" || status == "UNSAT") ? time : 2 * limit
+  cps = (conflicts != "" && time > 0) ? sprintf("%.0f", conflicts / time) : ""
+  pps = (propagations != "" && time > 0) ? sprintf("%.0f", propagations / time) : ""
+  printf "%s,%s,%s,%.2f,%.2f,%s,%s,%s,%s,%s,%s,%s\n",
+    family, instance, status, time, par2, conflicts, propagations,
+    cps, pps, dip, ext, memory
+}' $log
+  exit 0
+fi
+
+#--------------------------------------------------------------------------#
+
+time=5000
+mb=16384
+jobs=1
+dir=""
+db=""
+flags=""
+
+while [ $# -gt 0 ]
+do
+  case $1 in
+    -h) usage; exit 0;;
+    -t) shift; time=$1;;
+    -m) shift; mb=$1;;
+    -j) shift; jobs=$1;;
+    -o) shift; dir=$1;;
+    -d) shift; db=$1;;
+    -f) shift; flags=$1;;
+    -*) die "invalid option '$1' (try '-h')";;
+    *) break;;
+  esac
+  shift
+done
+
+[ $# -gt 0 ] || die "solver missing (try '-h')"
+solver=$1
+shift
+
+case $solver in
+  cadical) binary=cadical-original/build/cadical;;
+  cadical-nodip) binary=cadical-dip/build/cadical; flags="--diplearning=0 $flags";;
+  cadical-dip) binary=cadical-dip/build/cadical; flags="--diplearning=1 $flags";;
+  xmaplelcm) binary=xMapleLCM/bin/xmaplelcm;;
+  xmaplelcm-dip) binary=xMapleLCM-DIP/bin/xmaplelcm;;
+  glucoser) binary=glucoser-1.0/ER/glucoser;;
+  maplefps) binary=LStech-Maple-FPS/core/maplefps;;
+  *) die "unknown solver '$solver' (try '-h')";;
+esac
+
+binary=$rootdir/$binary
+for suffix in _static _release
+do
+  [ -x $binary ] || [ ! -x $binary$suffix ] || binary=$binary$suffix
+done
+[ -x $binary ] || die "can not find '$binary' (build '$solver' first)"
+
+[ x"$dir" = x ] && dir=$benchsdir/runs/$solver-`date +%Y%m%d-%H%M%S`
+mkdir -p $dir || die "can not create '$dir'"
+
+if [ $# = 0 ]
+then
+  for family in $benchsdir/*/
+  do
+    ls $family*.cnf >/dev/null 2>&1 && set -- "$@" $family
+  done
+fi
+
+instances=$dir/instances
+rm -f $instances
+for family in "$@"
+do
+  [ -d $family ] || family=$benchsdir/$family
+  [ -d $family ] || die "can not find family '$family'"
+  ls $family/*.cnf >> $instances 2>/dev/null
+done
+[ -s $instances ] || die "no CNF files found"
+
+msg "solver '$binary $flags'"
+msg "`wc -l < $instances` instances in $# families"
+msg "limits $time seconds and $mb MB with $jobs parallel jobs"
+msg "writing to '$dir'"
+
+#--------------------------------------------------------------------------#
+
+csv=$dir/results.csv
+echo "family,instance,status,time,par2,conflicts,propagations,conflicts_per_sec,propagations_per_sec,dip,ext_vars,memory_mb" > $csv
+xargs -P $jobs -I {} \
+  $0 --instance $dir $time $mb $binary $flags {} < $instances | \
+  sort >> $csv
+
+awk -F , 'NR > 1 { n++; par2 += $5; if ($3 == "SAT" || $3 == "UNSAT") solved++ }
+END { printf "c [run.sh] solved %d of %d with PAR-2 %.2f\n", solved, n, par2 }' $csv
+msg "results in '$csv'"
+
+if [ ! x"$db" = x ]
+then
+  run=`basename $dir`
+  {
+    echo "CREATE TABLE IF NOT EXISTS results (run TEXT, solver TEXT, flags TEXT, family TEXT, instance TEXT, status TEXT, time REAL, par2 REAL, conflicts INTEGER, propagations INTEGER, conflicts_per_sec INTEGER, propagations_per_sec INTEGER, dip INTEGER, ext_vars INTEGER, memory_mb REAL);"
+    echo "BEGIN;"
+    awk -F , -v run="$run" -v solver="$solver" -v flags="$flags" 'NR > 1 {
+      printf "INSERT INTO results VALUES (\x27%s\x27,\x27%s\x27,\x27%s\x27,\x27%s\x27,\x27%s\x27,\x27%s\x27", run, solver, flags, $1, $2, $3
+      for (i = 4; i <= 12; i++) printf ",%s", ($i == "" ? "NULL" : $i)
+      printf ");\n"
+    }' $csv
+    echo "COMMIT;"
+  } | sqlite3 $db || die "failed to append results to '$db'"
+  msg "appended run '$run' to '$db'"
+fi
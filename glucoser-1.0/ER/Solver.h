@@ -37,7 +37,6 @@ OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWA
 #include "Heap.h"
 #include "Alg.h"
 #include <algorithm>
-#include <boost/unordered_map.hpp>
 
 #include "SolverTypes.h"
 #include "BoundedQueue.h"
@@ -57,9 +56,17 @@ struct compare_vsids {
 };
 
 struct extclauses {
-  Clause *xl1l2;
-  Clause *xl1;
-  Clause *xl2;
+  CRef xl1l2;
+  CRef xl1;
+  CRef xl2;
+  extclauses() : xl1l2(CRef_Undef), xl1(CRef_Undef), xl2(CRef_Undef) {}
+};
+
+// One entry of the extension table: X <=> l1 \/ other, stored under l1 (toInt(l1) < toInt(other))
+struct extdef {
+  Lit other;
+  Var X;
+  extdef(Lit o, Var x) : other(o), X(x) {}
 };
 
 class Solver {
@@ -112,6 +119,7 @@ public:
     double    restart_inc;        // The factor with which the restart limit is multiplied in each restart.                    (default 1.5)
     double    learntsize_factor;  // The intitial limit for learnt clauses is a factor of the original clauses.                (default 1 / 3)
     double    learntsize_inc;     // The limit for learnt clauses is multiplied with this factor each restart.                 (default 1.1)
+    double    garbage_frac;       // The fraction of wasted memory allowed before a garbage collection is triggered.           (default 0.20)
     bool      expensive_ccmin;    // Controls conflict clause minimization.                                                    (default TRUE)
     int       polarity_mode;      // Controls which polarity the decision heuristic chooses. See enum below for allowed modes. (default polarity_false)
     int       verbosity;          // Verbosity level. 0=silent, 1=some progress report                                         (default 0)
@@ -155,8 +163,9 @@ protected:
     // Solver state:
     //
     bool                ok;               // If FALSE, the constraints are already unsatisfiable. No part of the solver state may be used!
-    vec<Clause*>        clauses;          // List of problem clauses.
-    vec<Clause*>        learnts;          // List of learnt clauses.
+    ClauseAllocator     ca;               // Region holding all clauses, addressed by 32-bit CRefs.
+    vec<CRef>           clauses;          // List of problem clauses.
+    vec<CRef>           learnts;          // List of learnt clauses.
     double              cla_inc;          // Amount to bump next clause with.
     vec<double>         activity;         // A heuristic measurement of the activity of a variable.
     double              var_inc;          // Amount to bump next variable with.
@@ -167,14 +176,13 @@ protected:
     vec<char>           decision_var;     // Declares if a variable is eligible for selection in the decision heuristic.
     vec<Lit>            trail;            // Assignment stack; stores all assigments made in the order they were made.
     vec<int>            trail_lim;        // Separator indices for different decision levels in 'trail'.
-    vec<Clause*>        reason;           // 'reason[var]' is the clause that implied the variables current value, or 'NULL' if none.
+    vec<CRef>           reason;           // 'reason[var]' is the clause that implied the variables current value, or 'CRef_Undef' if none.
     vec<int>            level;            // 'level[var]' contains the level at which the assignment was made.
     vec<unsigned long int> permDiff;      // permDiff[var] contains the current conflict number... Used to count the number of  LBD
                                                                                   // different decision level variables in learnt clause;
 
 
-    typedef boost::unordered_map<int, int> extmap;
-    vec<extmap>         extended;               // l1 and l2 have been used in extended[l1][l2] <=> l1 or l2
+    vec< vec<extdef> >  extended;               // literal-indexed: {l2, X} in extended[l1] <=> X was introduced for l1 or l2
     vec< pair<Lit, Lit> > extending;            // X <=> extending[X].first v extending[X].second
     vec< extclauses >   extending_clauses;      // the clauses that encode X <=> l1 or l2
     vec< int >          extended_blocked_count; // var cannot be removed because it depends on this many extended vars
@@ -186,6 +194,8 @@ protected:
     vec<Lit> lastExtended;
     int                 orignvars;
     bool is_extended(Var v) const;
+    Var  findExtension(Lit l1, Lit l2) const;   // X <=> l1 \/ l2 if there is one (toInt(l1) < toInt(l2)), var_Undef otherwise
+    void removeExtension(Lit l1, Lit l2);
 
 
 #ifdef UPDATEVARACTIVITY
@@ -216,7 +226,7 @@ protected:
     unsigned long int MYFLAG;
     vec<int>            extend_reduce_index;
     vec<Lit>            extend_reduce_assertLits;
-    vec<Clause*>        extend_reduce_assertClauses;
+    vec<CRef>           extend_reduce_assertClauses;
     Heap<compare_vsids> extend_reduce_candidates;
 
     // Main internal methods:
@@ -226,11 +236,11 @@ protected:
     void     insertVarOrder   (Var x);                                                 // Insert a variable in the decision order priority queue.
     Lit      pickBranchLit    (int polarity_mode, double random_var_freq);             // Return the next decision variable.
     void     newDecisionLevel ();                                                      // Begins a new decision level.
-    void     uncheckedEnqueue (Lit p, Clause* from = NULL);                            // Enqueue a literal. Assumes value of literal is undefined.
-    bool     enqueue          (Lit p, Clause* from = NULL);                            // Test if fact 'p' contradicts current state, enqueue otherwise.
-    Clause*  propagate        ();                                                      // Perform unit propagation. Returns possibly conflicting clause.
+    void     uncheckedEnqueue (Lit p, CRef from = CRef_Undef);                         // Enqueue a literal. Assumes value of literal is undefined.
+    bool     enqueue          (Lit p, CRef from = CRef_Undef);                         // Test if fact 'p' contradicts current state, enqueue otherwise.
+    CRef     propagate        ();                                                      // Perform unit propagation. Returns possibly conflicting clause.
     void     cancelUntil      (int level);                                             // Backtrack until a certain level.
-    void     analyze          (Clause* confl, vec<Lit>& out_learnt, int& out_btlevel,int &nblevels); // (bt = backtrack)
+    void     analyze          (CRef confl, vec<Lit>& out_learnt, int& out_btlevel,int &nblevels); // (bt = backtrack)
     void     analyzeFinal     (Lit p, vec<Lit>& out_conflict);                         // COULD THIS BE IMPLEMENTED BY THE ORDINARIY "analyze" BY SOME REASONABLE GENERALIZATION?
     bool     litRedundant     (Lit p, uint32_t abstract_levels);                       // (helper method for 'analyze()')
     lbool    search           ();                                                      // Search
@@ -242,13 +252,13 @@ protected:
     int      reduce_clause_by (vec<Lit>& out_learnt,
                                Lit lx1, Lit lx2, Lit lX,
                                int osize);
-    int      extend_by        (Lit l1, Lit l2, Clause **assertClause);                 // introduce X <=> l1 \/ l2, return X
+    int      extend_by        (Lit l1, Lit l2, CRef *assertClause);                    // introduce X <=> l1 \/ l2, return X
     void     deleteVar        (int X);                                                 // delete an extended var
     bool tryToExtend(vec<Lit>& last,int lastDBL,vec<Lit>&cur,int curDBL,vec<Lit>&intersect);
     bool tryToExtend2(vec<Lit>&cur,int curDBL);
 
 
-    void     removeSatisfied  (vec<Clause*>& cs);                                      // Shrink 'cs' to contain only non-satisfied clauses.
+    void     removeSatisfied  (vec<CRef>& cs);                                         // Shrink 'cs' to contain only non-satisfied clauses.
 
     // Maintaining Variable/Clause activity:
     //
@@ -259,12 +269,18 @@ protected:
 
     // Operations on clauses:
     //
-    void     attachClause     (Clause& c);             // Attach a clause to watcher lists.
-    void     detachClause     (Clause& c);             // Detach a clause to watcher lists.
-    void     removeClause     (Clause& c);             // Detach and free a clause.
+    void     attachClause     (CRef cr);               // Attach a clause to watcher lists.
+    void     detachClause     (CRef cr);               // Detach a clause to watcher lists.
+    void     removeClause     (CRef cr);               // Detach and free a clause.
     bool     locked           (const Clause& c) const; // Returns TRUE if a clause is a reason for some implication in the current state.
     bool     satisfied        (const Clause& c) const; // Returns TRUE if a clause is satisfied in the current state.
 
+    // Garbage collection:
+    //
+    void     relocAll         (ClauseAllocator& to);   // Move all live clauses to 'to' and update every reference to them.
+    void     garbageCollect   ();
+    void     checkGarbage     ();                      // Collect if the wasted part of 'ca' exceeds 'garbage_frac'.
+
     // Misc:
     //
     int      decisionLevel    ()      const; // Gives the current decisionlevel.
@@ -319,11 +335,11 @@ inline void Solver::claBumpActivity (Clause& c) {
   if ( (c.oldActivity() += cla_inc) > 1e20 ) {
     // Rescale:
     for (int i = 0; i < learnts.size(); i++)
-      learnts[i]->oldActivity() *= 1e-20;
+      ca[learnts[i]].oldActivity() *= 1e-20;
     cla_inc *= 1e-20; } }
 
-inline bool     Solver::enqueue         (Lit p, Clause* from)   { return value(p) != l_Undef ? value(p) != l_False : (uncheckedEnqueue(p, from), true); }
-inline bool     Solver::locked          (const Clause& c) const { return reason[var(c[0])] == &c && value(c[0]) == l_True; }
+inline bool     Solver::enqueue         (Lit p, CRef from)      { return value(p) != l_Undef ? value(p) != l_False : (uncheckedEnqueue(p, from), true); }
+inline bool     Solver::locked          (const Clause& c) const { return value(c[0]) == l_True && reason[var(c[0])] != CRef_Undef && ca.lea(reason[var(c[0])]) == &c; }
 inline void     Solver::newDecisionLevel()                      { trail_lim.push(trail.size()); }
 inline int     Solver::nbPropagated(int level) {
   if(level==decisionLevel()) return trail.size()-trail_lim[level-1]-1;
@@ -344,6 +360,18 @@ inline void     Solver::setDecisionVar(Var v, bool b) { decision_var[v] = (char)
 inline bool     Solver::solve         ()              { vec<Lit> tmp; return solve(tmp); }
 inline bool     Solver::okay          ()      const   { return ok; }
 inline bool     Solver::is_extended   (Var v) const   { return v >= orignvars; }
+inline void     Solver::checkGarbage  ()              { if (ca.wasted() > ca.size() * garbage_frac) garbageCollect(); }
+
+inline Var Solver::findExtension(Lit l1, Lit l2) const {
+  const vec<extdef>& ds = extended[toInt(l1)];
+  for (int i = 0; i < ds.size(); i++)
+    if (ds[i].other == l2) return ds[i].X;
+  return var_Undef; }
+
+inline void Solver::removeExtension(Lit l1, Lit l2) {
+  vec<extdef>& ds = extended[toInt(l1)];
+  for (int i = 0; i < ds.size(); i++)
+    if (ds[i].other == l2) { ds[i] = ds.last(); ds.pop(); return; } }
 
 
 
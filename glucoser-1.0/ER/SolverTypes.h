@@ -33,6 +33,7 @@ OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWA
 
 #include <cassert>
 #include <stdint.h>
+#include "Alloc.h"
 
 //=================================================================================================
 // Variables, literals, lifted booleans, clauses:
@@ -107,50 +108,46 @@ const lbool l_Undef = toLbool( 0);
 //=================================================================================================
 // Clause -- a simple class for representing a clause:
 
+class Clause;
+typedef RegionAllocator<uint32_t>::Ref CRef;
+const CRef CRef_Undef = RegionAllocator<uint32_t>::Ref_Undef;
 
 class Clause {
-    uint32_t size_etc;
+    uint32_t size_etc;          // size << 4 | reloced << 3 | mark << 1 | learnt
     union { int lbd; uint32_t abst; } extra;
     float decayingActivity;
     Lit     data[0];
 
-public:
-    void calcAbstraction() {
-        uint32_t abstraction = 0;
-        for (int i = 0; i < size(); i++)
-            abstraction |= 1 << (var(data[i]) & 31);
-        extra.abst = abstraction;  }
+    friend class ClauseAllocator;
 
     // NOTE: This constructor cannot be used directly (doesn't allocate enough memory).
     template<class V>
     Clause(const V& ps, bool learnt) {
-        size_etc = (ps.size() << 3) | (uint32_t)learnt;
+        size_etc = (ps.size() << 4) | (uint32_t)learnt;
         for (int i = 0; i < ps.size(); i++) data[i] = ps[i];
         decayingActivity = 0.0;
         if (learnt) extra.lbd = 0; else calcAbstraction(); }
 
-    // -- use this function instead:
-    template<class V>
-    friend Clause* Clause_new2(const V& ps, bool learnt = false) {
-        assert(sizeof(Lit)      == sizeof(uint32_t));
-        assert(sizeof(float)    == sizeof(uint32_t));
-        void* mem = malloc(sizeof(Clause) + sizeof(uint32_t)*(ps.size()));
-        return new (mem) Clause(ps, learnt); }
-
-  friend Clause* Clause_new(const vec<Lit>& ps, bool learnt);
-        // assert(sizeof(Lit)      == sizeof(uint32_t));
-        // assert(sizeof(float)    == sizeof(uint32_t));
-        // void* mem = malloc(sizeof(Clause) + sizeof(uint32_t)*(ps.size()));
-        // return new (mem) Clause(ps, learnt); }
+public:
+    void calcAbstraction() {
+        uint32_t abstraction = 0;
+        for (int i = 0; i < size(); i++)
+            abstraction |= 1 << (var(data[i]) & 31);
+        extra.abst = abstraction;  }
 
-    int          size        ()      const   { return size_etc >> 3; }
-    void         shrink      (int i)         { assert(i <= size()); size_etc = (((size_etc >> 3) - i) << 3) | (size_etc & 7); }
+    int          size        ()      const   { return size_etc >> 4; }
+    void         shrink      (int i)         { assert(i <= size()); size_etc = (((size_etc >> 4) - i) << 4) | (size_etc & 15); }
     void         pop         ()              { shrink(1); }
     bool         learnt      ()      const   { return size_etc & 1; }
     uint32_t     mark        ()      const   { return (size_etc >> 1) & 3; }
     void         mark        (uint32_t m)    { size_etc = (size_etc & ~6) | ((m & 3) << 1); }
     const Lit&   last        ()      const   { return data[size()-1]; }
 
+    // Garbage collection: a moved clause keeps its new reference in place of the first literal.
+    bool         reloced     ()      const   { return size_etc & 8; }
+    CRef         relocation  ()      const   { return (CRef)toInt(data[0]); }
+    void         relocate    (CRef c)        { size_etc |= 8; data[0] = toLit((int)c); }
+
     // NOTE: somewhat unsafe to change the clause in-place! Must manually call 'calcAbstraction' afterwards for
     //       subsumption operations to behave correctly.
     Lit&         operator [] (int i)         { return data[i]; }
@@ -213,13 +210,63 @@ inline void Clause::strengthen(Lit p)
   remove(*this, p);
   calcAbstraction();
 }
+
+
+//=================================================================================================
+// ClauseAllocator -- clauses live in one region and are referred to by 32-bit CRefs:
+
+
+class ClauseAllocator : public RegionAllocator<uint32_t>
+{
+    static int clauseWord32Size(int size) {
+        return (sizeof(Clause) + sizeof(Lit) * size) / sizeof(uint32_t); }
+
+ public:
+    ClauseAllocator(uint32_t start_cap) : RegionAllocator<uint32_t>(start_cap) {}
+    ClauseAllocator() {}
+
+    void moveTo(ClauseAllocator& to) { RegionAllocator<uint32_t>::moveTo(to); }
+
+    template<class V>
+    CRef alloc(const V& ps, bool learnt = false) {
+        assert(sizeof(Lit)      == sizeof(uint32_t));
+        assert(sizeof(float)    == sizeof(uint32_t));
+        CRef cid = RegionAllocator<uint32_t>::alloc(clauseWord32Size(ps.size()));
+        new (lea(cid)) Clause(ps, learnt);
+        return cid; }
+
+    // Deref, Load Effective Address (LEA), Inverse of LEA (AEL):
+    Clause&       operator[](CRef r)       { return (Clause&)RegionAllocator<uint32_t>::operator[](r); }
+    const Clause& operator[](CRef r) const { return (Clause&)RegionAllocator<uint32_t>::operator[](r); }
+    Clause*       lea       (CRef r)       { return (Clause*)RegionAllocator<uint32_t>::lea(r); }
+    const Clause* lea       (CRef r) const { return (Clause*)RegionAllocator<uint32_t>::lea(r); }
+    CRef          ael       (const Clause* t){ return RegionAllocator<uint32_t>::ael((uint32_t*)t); }
+
+    void free(CRef cid) {
+        Clause& c = operator[](cid);
+        RegionAllocator<uint32_t>::free(clauseWord32Size(c.size())); }
+
+    // Copy a clause into 'to' the first time it is seen, afterwards just follow the forward reference.
+    void reloc(CRef& cr, ClauseAllocator& to) {
+        Clause& c = operator[](cr);
+        if (c.reloced()) { cr = c.relocation(); return; }
+
+        cr = to.alloc(c, c.learnt());
+        c.relocate(cr);
+
+        Clause& nc = to[cr];
+        nc.extra            = c.extra;
+        nc.decayingActivity = c.decayingActivity;
+        nc.mark(c.mark()); }
+};
+
 //------------------------------------------
 
 // A structure tu use block litterals !
 
 struct Watched {
   Lit blocked;
-  Clause *wcl;
+  CRef cref;
 };
 
 
@@ -228,7 +275,7 @@ struct Watched {
 
 struct Binaire {
   Lit implied;
-  Clause *clause;
+  CRef cref;
 };
 
 
@@ -1,16 +1,20 @@
 Main.o: Main.C Solver.h Constants.h ../mtl/Vec.h ../mtl/Heap.h \
- ../mtl/Vec.h ../mtl/Alg.h SolverTypes.h BoundedQueue.h
+ ../mtl/Vec.h ../mtl/Alg.h SolverTypes.h ../mtl/Alloc.h BoundedQueue.h
 Solver.o: Solver.C Solver.h Constants.h ../mtl/Vec.h ../mtl/Heap.h \
- ../mtl/Vec.h ../mtl/Alg.h SolverTypes.h BoundedQueue.h ../mtl/Sort.h
+ ../mtl/Vec.h ../mtl/Alg.h SolverTypes.h ../mtl/Alloc.h BoundedQueue.h \
+ ../mtl/Sort.h
 Main.op: Main.C Solver.h Constants.h ../mtl/Vec.h ../mtl/Heap.h \
- ../mtl/Vec.h ../mtl/Alg.h SolverTypes.h BoundedQueue.h
+ ../mtl/Vec.h ../mtl/Alg.h SolverTypes.h ../mtl/Alloc.h BoundedQueue.h
 Solver.op: Solver.C Solver.h Constants.h ../mtl/Vec.h ../mtl/Heap.h \
- ../mtl/Vec.h ../mtl/Alg.h SolverTypes.h BoundedQueue.h ../mtl/Sort.h
+ ../mtl/Vec.h ../mtl/Alg.h SolverTypes.h ../mtl/Alloc.h BoundedQueue.h \
+ ../mtl/Sort.h
 Main.od: Main.C Solver.h Constants.h ../mtl/Vec.h ../mtl/Heap.h \
- ../mtl/Vec.h ../mtl/Alg.h SolverTypes.h BoundedQueue.h
+ ../mtl/Vec.h ../mtl/Alg.h SolverTypes.h ../mtl/Alloc.h BoundedQueue.h
 Solver.od: Solver.C Solver.h Constants.h ../mtl/Vec.h ../mtl/Heap.h \
- ../mtl/Vec.h ../mtl/Alg.h SolverTypes.h BoundedQueue.h ../mtl/Sort.h
+ ../mtl/Vec.h ../mtl/Alg.h SolverTypes.h ../mtl/Alloc.h BoundedQueue.h \
+ ../mtl/Sort.h
 Main.or: Main.C Solver.h Constants.h ../mtl/Vec.h ../mtl/Heap.h \
- ../mtl/Vec.h ../mtl/Alg.h SolverTypes.h BoundedQueue.h
+ ../mtl/Vec.h ../mtl/Alg.h SolverTypes.h ../mtl/Alloc.h BoundedQueue.h
 Solver.or: Solver.C Solver.h Constants.h ../mtl/Vec.h ../mtl/Heap.h \
- ../mtl/Vec.h ../mtl/Alg.h SolverTypes.h BoundedQueue.h ../mtl/Sort.h
+ ../mtl/Vec.h ../mtl/Alg.h SolverTypes.h ../mtl/Alloc.h BoundedQueue.h \
+ ../mtl/Sort.h
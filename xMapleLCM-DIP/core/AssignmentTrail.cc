@@ -31,6 +31,7 @@ using namespace Minisat;
 AssignmentTrail::AssignmentTrail(Solver& s)
     : ca(s.ca)
     , solver(s)
+    , chronological(false)
 {}
 
 ///////////////////////////////////////////////////////////////////////////////////////////////////
@@ -65,7 +66,7 @@ void AssignmentTrail::cancelUntilLevel(int level) {
     if (decisionLevel() <= level) return;
 
     // Backtrack
-    cancelUntil<true>(trail_lim[level]);
+    cancelUntil<true>(trail_lim[level], chronological ? level : -1);
 
     // Update current decision level
     trail_lim.shrink(trail_lim.size() - level);
@@ -78,6 +79,18 @@ void AssignmentTrail::cancelUntilTrailSize(int trailSize) {
 ///////////////////////////////////////////////////////////////////////////////////////////////////
 // HELPER FUNCTIONS
 
+inline int AssignmentTrail::reasonLevel(Lit p, CRef from) const {
+    const Clause& c = ca[from];
+    int lvl = 0;
+
+    // Binary reasons may hold the implied literal in either position
+    for (int i = c.size() == 2 ? 0 : 1; i < c.size(); i++)
+        if (var(c[i]) != var(p) && level(var(c[i])) > lvl)
+            lvl = level(var(c[i]));
+
+    return lvl;
+}
+
 template <bool simple>
 inline void AssignmentTrail::genericAssign(Lit p, CRef from) {
     assert(value(p) == l_Undef);
@@ -98,12 +111,12 @@ inline void AssignmentTrail::genericAssign(Lit p, CRef from) {
 	if (c.size() == 2) {
 	  if (p == c[0]) {
 	    assert(value(c[1]) == l_False);
-	    assert(level(var(c[1])) == decisionLevel());
+	    assert(chronological || level(var(c[1])) == decisionLevel());
 	  }
 	  else {
 	    assert(p == c[1]);
 	    assert(value(c[0]) == l_False);
-	    assert(level(var(c[0])) == decisionLevel());
+	    assert(chronological || level(var(c[0])) == decisionLevel());
 	  }
 	}
 	else {
@@ -115,7 +128,7 @@ inline void AssignmentTrail::genericAssign(Lit p, CRef from) {
 	    if (value(c[i]) != l_False) allFalse = false;
 	  }
 	  assert(allFalse);
-	  assert(maxDL == decisionLevel());
+	  assert(chronological ? maxDL <= decisionLevel() : maxDL == decisionLevel());
 	}
       }
 #endif
@@ -127,15 +140,23 @@ inline void AssignmentTrail::genericAssign(Lit p, CRef from) {
     Var x = var(p);
     assigns[x] = lbool(!sign(p));
     if (simple) vardata[x].reason = from;
+    else if (chronological && from != CRef_Undef) vardata[x] = VarData{from, reasonLevel(p, from)};
     else vardata[x] = VarData{from, decisionLevel()};
     trail.push_(p);
 }
 
 template<bool notifyListeners>
-void AssignmentTrail::cancelUntil(int trailSize) {
+void AssignmentTrail::cancelUntil(int trailSize, int keepLevel) {
     // Clear the values of the variables
     for (int c = trail.size() - 1; c >= trailSize; c--){
         Var x = var(trail[c]);
+
+        // Keep literals of lower levels, which were assigned out of order
+        if (vardata[x].level <= keepLevel) {
+            kept.push(trail[c]);
+            continue;
+        }
+
         assigns[x] = l_Undef;
 	//	cout << "UnSet " << trail[c] << endl;
 
@@ -151,6 +172,10 @@ void AssignmentTrail::cancelUntil(int trailSize) {
 
     // Decrease the size of the trail
     trail.shrink(trail.size() - trailSize);
+    while (kept.size() > 0) {
+        trail.push_(kept.last());
+        kept.pop();
+    }
 
     // Add remaining assignments to the queue
     solver.propagationQueue.batchEnqueue(trail, trailSize);
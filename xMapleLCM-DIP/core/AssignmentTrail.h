@@ -81,6 +81,18 @@ namespace Minisat {
         /// @brief Used to keep track of variables when computing LBD
         vec<uint64_t> lbd_seen;
 
+        /// @brief Literals kept on the trail while backtracking chronologically
+        vec<Lit> kept;
+
+    public:
+        ///////////////////////////////////////////////////////////////////////////////////////////
+        // PARAMETERS
+
+        /// @brief Whether implied literals are assigned at the highest level of their reason
+        /// instead of the current decision level, as needed for chronological backtracking.
+        /// Literals of lower levels may then be interleaved with those of the current level.
+        bool chronological;
+
     public:
         ///////////////////////////////////////////////////////////////////////////////////////////
         // CONSTRUCTORS
@@ -253,6 +265,8 @@ namespace Minisat {
          * not beyond.
          * 
          * @param level The decision level to which to backtrack.
+         * @note If @code{chronological}, assignments at or below 'level' that were made after
+         * it are kept as well, and are propagated again.
          */
         void cancelUntilLevel(int level);
 
@@ -296,8 +310,25 @@ namespace Minisat {
         template <bool simple>
         void genericAssign(Lit p, CRef from);
 
+        /**
+         * @brief Get the highest decision level of the literals of a reason clause, except for
+         * the literal it implies
+         * 
+         * @param p the implied literal
+         * @param from the reason for the literal assignment
+         * @return the decision level at which 'p' is implied
+         */
+        int reasonLevel(Lit p, CRef from) const;
+
+        /**
+         * @brief Unassign the literals of the trail from 'trailSize' on.
+         * 
+         * @tparam notifyListeners true to notify event listeners
+         * @param trailSize the size of the trail after backtracking
+         * @param keepLevel literals assigned at this level or below are kept (-1 for none)
+         */
         template<bool notifyListeners>
-        void cancelUntil(int trailSize);
+        void cancelUntil(int trailSize, int keepLevel = -1);
     };
 
     ///////////////////////////////////////////////////////////////////////////////////////////////
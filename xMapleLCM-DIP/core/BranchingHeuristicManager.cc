@@ -160,12 +160,10 @@ void BranchingHeuristicManager::checkSwitchHeuristic(uint64_t propagations) {
 
 void BranchingHeuristicManager::switchHeuristic(void) {
   VSIDS = !VSIDS;
-  if (VSIDS) {
-    printf("c Switched to VSIDS.\n");
-  } else {
-    printf("c Switched to LRB.\n");
+  if (solver.verbosity >= 1) {
+    printf(VSIDS ? "c Switched to VSIDS.\n" : "c Switched to LRB.\n");
+    fflush(stdout);
   }
-  fflush(stdout);
 
   // Instead of clearing, set vectors to 0
   for (int i = 0; i < assignmentTrail.nVars(); i++) {
@@ -218,7 +216,7 @@ void BranchingHeuristicManager::updateActivityDistance(
 						       int maxDistance
 						       ) {
   // Compute exponential decay series
-  vec<int> level_incs;
+  level_incs.clear();
   getExponentialDecaySeries(level_incs, maxDistance, var_iLevel_inc, my_var_decay);
 
   // Update variable activities
@@ -230,6 +230,9 @@ namespace Minisat {
         /// @brief Temporary list of variables whose values need to be cleared
         vec<Var> toClear;
 
+        /// @brief Exponential decay series of @code{updateActivityDistance}
+        vec<int> level_incs;
+
     public:
         ///////////////////////////////////////////////////////////////////////////////////////////
         // STATISTICS
@@ -504,9 +507,8 @@ namespace Minisat {
     // STATE MODIFICATION
 
     inline void BranchingHeuristicManager::newVar(Var v, bool sign, bool dvar) {
-        // Decision variables
+        // Decision variables (inserted into the order heaps below, after their activities exist)
         decision.push();
-        setDecisionVar(v, dvar);
 
 	// cout << "New var rand " << rnd_init_act << endl;
 	// double x = randomNumberGenerator.drand() * 0.00001;
@@ -531,6 +533,8 @@ namespace Minisat {
 
         // Phase saving
         polarity.push(sign);
+
+        setDecisionVar(v, dvar);
     }
 
     inline void BranchingHeuristicManager::setDecisionVar(Var v, bool b) { 
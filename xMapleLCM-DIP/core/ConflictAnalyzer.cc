@@ -41,7 +41,7 @@ static IntOption    opt_ccmin_mode             (_cat, "ccmin-mode",  "Controls c
 
 static BoolOption   opt_learn_two_dip_clauses  (_cat2, "dip-2clauses",    "Learn two DIP clauses: UIP -> DIP and DIP -> conflict. If set to false, only DIP -> conflict is learned.", true);
 static IntOption    opt_common_pair_DIP_min    (_cat2, "dip-pair-min",  "Specifies the minimum numer of times a DIP has to appear before we introduce it. (-1 means disabled)", 20, IntRange(-1, INT32_MAX));
-static IntOption    opt_dip_type               (_cat2, "dip-type",  "Specifies the type of DIP computed (1 = middle, 2 = closest to conflict, 3 = random)", 1, IntRange(1, 3));
+static IntOption    opt_dip_type               (_cat2, "dip-type",  "Specifies the type of DIP computed (1 = middle, 2 = closest to conflict, 3 = random, 4 = adaptive)", 1, IntRange(1, 4));
 
 static IntOption    opt_DIP_window_size         (_cat2, "dip-window-size",  "Introduce a DIP only if the sum of the activities of the pair is larger than the average of the last DIPs in a window of the given size (-1 means option disabled).", -1, IntRange(-1, INT32_MAX));
 
@@ -143,6 +143,14 @@ void ConflictAnalyzer::analyze1UIP(CRef confl, vec<Lit>& out_learnt, int& out_bt
         seen[var(mainLearnedClause[j])] = false;
 }
 
+inline Lit ConflictAnalyzer::nextMarkedLit(const vec<bool>& marks, int& index) const {
+    const int level = assignmentTrail.decisionLevel();
+    for (;;) {
+        Lit p = assignmentTrail[index--];
+        if (marks[var(p)] && assignmentTrail.level(var(p)) == level) return p;
+    }
+}
+
 inline void ConflictAnalyzer::getFirstUIPClause(CRef confl, vec<Lit>& out_learnt) {
     Lit p = lit_Undef;
     int pathC = 0;
@@ -179,8 +187,7 @@ inline void ConflictAnalyzer::getFirstUIPClause(CRef confl, vec<Lit>& out_learnt
         }
         
         // Select next clause to look at:
-        while (!seen[var(assignmentTrail[index--])]);
-        p     = assignmentTrail[index+1];
+        p     = nextMarkedLit(seen, index);
         confl = assignmentTrail.reason(var(p));
 
         // Mark variable as unseen: it is either at or after the first UIP
@@ -288,8 +295,9 @@ void ConflictAnalyzer::analyzeFinal(Lit p, vec<Lit>& out_conflict) {
       out_conflict.push(~assignmentTrail[i]);
     } else {
       Clause& c = ca[assignmentTrail.reason(x)];
+      // Binary reasons may hold the implied literal in either position
       for (int j = c.size() == 2 ? 0 : 1; j < c.size(); j++)
-	if (assignmentTrail.level(var(c[j])) > 0) 
+	if (var(c[j]) != x && assignmentTrail.level(var(c[j])) > 0)
 	  seen[var(c[j])] = 1;
     }
   }
@@ -297,6 +305,40 @@ void ConflictAnalyzer::analyzeFinal(Lit p, vec<Lit>& out_conflict) {
   seen[var(p)] = 0;
 }
 
+int ConflictAnalyzer::findConflictLevel(CRef confl, bool& out_single) {
+  Clause& c = ca[confl];
+
+  // Find the literal of the highest level and the one of the next highest
+  int i_max = 0, i_next = -1, count = 1;
+  for (int i = 1; i < c.size(); i++) {
+    const int l = assignmentTrail.level(var(c[i]));
+    if (l > assignmentTrail.level(var(c[i_max]))) {
+      i_next = i_max;
+      i_max = i;
+      count = 1;
+    } else {
+      if (l == assignmentTrail.level(var(c[i_max]))) count++;
+      if (i_next == -1 || l > assignmentTrail.level(var(c[i_next]))) i_next = i;
+    }
+  }
+
+  const int level = assignmentTrail.level(var(c[i_max]));
+  out_single = count == 1;
+
+  // The literal of the highest level must be implied by the clause, which then has to be watched
+  // by it and by the literal of the next highest level
+  if (out_single) {
+    if (c.size() == 2) {
+      // Don't need to touch watchers for binary clauses
+      if (i_max == 1) std::swap(c[0], c[1]);
+    } else {
+      solver.unitPropagator.enforceWatcherInvariant(confl, i_max, i_next);
+    }
+  }
+
+  return level;
+}
+
 template <class C>
 static inline void enforceBinaryClauseInvariant(const AssignmentTrail& at, C& c) {
   if (c.size() == 2 && at.value(c[0]) == l_False) {
@@ -578,11 +620,11 @@ bool ConflictAnalyzer::ok_DIP (Lit dip1, Lit dip2, Lit UIP, CRef confl) {
   return true;
 }
 
-bool ConflictAnalyzer::computeRandomDIP (int a, int b, TwoVertexBottlenecks& info, const DIPGraphEncoder& encoder, Lit& x, Lit& y) {
+bool ConflictAnalyzer::computeRandomDIP (int a, int b, const TwoVertexBottlenecks& info, const DIPGraphEncoder& encoder, Lit& x, Lit& y) {
   // a == 1 if the first element of VertPairListA is an immediate ancestor of the conflict node
   // b == 1 if the first element of VertPairListB is an immediate ancestor of the conflict node
   
-  vector<TwoVertexBottlenecks::VertPairInfo> listA = info.GetVertListA();
+  const vector<TwoVertexBottlenecks::VertPairInfo>& listA = info.GetVertListA();
   int idxA;
   if (a == 1) {
     if (listA.size() == 1) return false;
@@ -592,8 +634,9 @@ bool ConflictAnalyzer::computeRandomDIP (int a, int b, TwoVertexBottlenecks& inf
   
   x = encoder.Sam2Solver(listA[idxA].vertNum);
 
-  vector<TwoVertexBottlenecks::VertPairInfo> listB = info.GetVertListB();  
-  vector<Lit> candidatesY;
+  const vector<TwoVertexBottlenecks::VertPairInfo>& listB = info.GetVertListB();  
+  vector<Lit>& candidatesY = dipCandidatesY;
+  candidatesY.clear();
   for (int i = 0; i < listB.size(); ++i){
     if (b == 1 and i == 0) continue;
     if (listA[idxA].minPair <= listB[i].vertNum and
@@ -612,7 +655,7 @@ bool ConflictAnalyzer::computeRandomDIP (int a, int b, TwoVertexBottlenecks& inf
   return true;
 }
 
-bool ConflictAnalyzer::computeClosestDIPToConflict (int a, int b, TwoVertexBottlenecks& info, const DIPGraphEncoder& encoder, Lit& x, Lit& y) {
+bool ConflictAnalyzer::computeClosestDIPToConflict (int a, int b, const TwoVertexBottlenecks& info, const DIPGraphEncoder& encoder, Lit& x, Lit& y) {
   const vector<TwoVertexBottlenecks::VertPairInfo>& listA = info.GetVertListA();
 
   // a == 1 if the first element of VertPairListA is an immediate ancestor of the conflict node
@@ -645,8 +688,10 @@ bool ConflictAnalyzer::computeClosestDIPToConflict (int a, int b, TwoVertexBottl
   return true;
 }
 
-bool ConflictAnalyzer::computeBestMiddleDIP (const TwoVertexBottlenecks& info, const DIPGraphEncoder& encoder, const vector<int>& pathA, const vector<int>& pathB, Lit& x, Lit& y) {
+bool ConflictAnalyzer::computeBestMiddleDIP (const TwoVertexBottlenecks& info, const DIPGraphEncoder& encoder, Lit& x, Lit& y) {
 
+  const vector<int>& pathA = info.GetPathA();
+  const vector<int>& pathB = info.GetPathB();
   if (pathA.size() <= 3 and pathB.size() <= 3) return false; // does not seem interesting
   
   
@@ -666,37 +711,19 @@ bool ConflictAnalyzer::computeBestMiddleDIP (const TwoVertexBottlenecks& info, c
   const vector<TwoVertexBottlenecks::VertPairInfo>& longestList = (pathA.size() > pathB.size() ? listA : listB);
   const vector<TwoVertexBottlenecks::VertPairInfo>& shortestList = (pathA.size() > pathB.size() ? listB : listA);
 
-  // First we compute the position in the path of each vertex of the lists (which are the DIP candidates)
-  // For every k, posInLongestPath[k] = p  iff vertex longestList[k].vertNum appears in longestPath[p]
-  // similarly for shortest
-  vector<int> posInLongestPath(longestList.size());
-  vector<int> posInShortestPath(shortestList.size());
-
-  // Remember that pathA, pathB both start with the 1UIP (largest vertex) and finish with the conflict (vertex 0).
-  // We know that both paths are strictly ordered from large to small
-  // However, note that longest/shortest List are ordered strictly from smaller to larger
-  for (int i = 0, j = longestPath.size() - 1; i < longestList.size(); ++i) {
-    while (longestPath[j] != longestList[i].vertNum) --j;
-    posInLongestPath[i] = j;
-    //cout << "Pos of " << longestList[i].vertNum << " in longestPath is " << j << endl;
-  }
-
-  for (int i = 0, j = shortestPath.size() - 1; i < shortestList.size(); ++i) {
-    while (shortestPath[j] != shortestList[i].vertNum) --j;
-    posInShortestPath[i] = j;
-    //cout << "Pos of " << shortestList[i].vertNum << " in shortestPath is " << j << endl;
-  }
+  // The position of each DIP candidate in its path is given by pathPos
+  // (paths start with the 1UIP and finish with the conflict, vertex 0).
 
   int medianLongest = longestPath.size()/2;
   int medianShortest = shortestPath.size()/2;
 
   // We know that the longest path has size >= 3 (we have returned false otherwise)  
   int idxLongest = 0;
-  int longestDistToMedian  = abs(medianLongest - posInLongestPath[0]);
+  int longestDistToMedian  = abs(medianLongest - longestList[0].pathPos);
   // Look for the one closest to the middle (DIP_A in the description)
   int k = 1;
-  while (k < posInLongestPath.size() and longestDistToMedian > 0) {
-    int dist = abs(medianLongest - posInLongestPath[k]);
+  while (k < longestList.size() and longestDistToMedian > 0) {
+    int dist = abs(medianLongest - longestList[k].pathPos);
     if (dist < longestDistToMedian) {
       longestDistToMedian = dist;
       idxLongest = k;
@@ -704,7 +731,7 @@ bool ConflictAnalyzer::computeBestMiddleDIP (const TwoVertexBottlenecks& info, c
     ++k;
   }
 
-  //cout << "For longest we choose DIP " << longestList[idxLongest].vertNum << " at position " << posInLongestPath[idxLongest] << endl;
+  //cout << "For longest we choose DIP " << longestList[idxLongest].vertNum << " at position " << longestList[idxLongest].pathPos << endl;
 
   // minV and maxV tell that any number inside [minV, maxV] is DIP-compatible with DIP_A
   int minV = longestList[idxLongest].minPair;
@@ -714,9 +741,9 @@ bool ConflictAnalyzer::computeBestMiddleDIP (const TwoVertexBottlenecks& info, c
   int shortestDistToMedian = 1e9;
   
   k = 0;
-  while (k < posInShortestPath.size() and shortestDistToMedian > 0) {
+  while (k < shortestList.size() and shortestDistToMedian > 0) {
     if (shortestList[k].vertNum < minV or shortestList[k].vertNum > maxV) {++k; continue;}
-    int dist = abs(medianShortest - posInShortestPath[k]);
+    int dist = abs(medianShortest - shortestList[k].pathPos);
     if (dist < shortestDistToMedian) {
       shortestDistToMedian = dist;
       idxShortest = k;
@@ -729,11 +756,11 @@ bool ConflictAnalyzer::computeBestMiddleDIP (const TwoVertexBottlenecks& info, c
   //   return false; 
   // }
 
-  //cout << "For shortest we choose DIP " << shortestList[idxShortest].vertNum << " at position " << posInShortestPath[idxShortest] << endl;
+  //cout << "For shortest we choose DIP " << shortestList[idxShortest].vertNum << " at position " << shortestList[idxShortest].pathPos << endl;
 
 
-  if (posInShortestPath[idxShortest] == shortestPath.size() - 2 and
-      posInLongestPath[idxLongest] == longestPath.size() - 2)
+  if (shortestList[idxShortest].sinkDist == 1 and
+      longestList[idxLongest].sinkDist == 1)
     {
       //cout << "TWO IMMEDIATE ANCESTORS" << endl;
       return false;}
@@ -779,8 +806,7 @@ int ConflictAnalyzer::computeLBD_DIP2Conflict (CRef confl, Lit x, Lit y) {
         
     // Select next clause to look at:
     while (dipReached != 2) {
-      while (!seen3[var(assignmentTrail[index--])]);
-      p = assignmentTrail[index+1];
+      p = nextMarkedLit(seen3, index);
       if (p == x) heightX = index+1;
       else if (p == y) heightY = index+1;	  
       if (p != x and p != y) break;
@@ -820,7 +846,22 @@ int ConflictAnalyzer::computeLBD_DIP2Conflict (CRef confl, Lit x, Lit y) {
   return LBD + 1;
 }
 
-bool ConflictAnalyzer::computeDIPClauses (int a, int b, CRef confl, TwoVertexBottlenecks& info, const DIPGraphEncoder& encoder, vec<Lit>& clause_to_learn, vec<Lit>& clause_to_learn2, Lit UIP, vector<int>& pathA, vector<int>& pathB) {
+// Number of distinct decision levels of c[1..], plus one for c[0] (the UIP or the
+// extension literal, both at the conflict level).
+int ConflictAnalyzer::dipClauseGlue (const vec<Lit>& c) {
+  counter++;
+  int glue = 1;
+  for (int i = 1; i < c.size(); i++) {
+    int l = assignmentTrail.level(var(c[i]));
+    if (seen2[l] != counter) {
+      seen2[l] = counter;
+      glue++;
+    }
+  }
+  return glue;
+}
+
+bool ConflictAnalyzer::computeDIPClauses (int a, int b, CRef confl, const TwoVertexBottlenecks& info, const DIPGraphEncoder& encoder, vec<Lit>& clause_to_learn, vec<Lit>& clause_to_learn2, Lit UIP) {
   assert(clause_to_learn.size() == 0);
 
   CRef originalConflict = confl;
@@ -829,16 +870,18 @@ bool ConflictAnalyzer::computeDIPClauses (int a, int b, CRef confl, TwoVertexBot
   // 3 DIP computations: random, closest to conflict, the one in the middle
 
   bool dip_found = false;
-  if (dip_type == MIDDLE_DIP) dip_found = computeBestMiddleDIP(info,encoder,pathA,pathB,x,y);
-  else if (dip_type == CLOSEST_TO_CONFLICT) dip_found = computeClosestDIPToConflict(a,b,info,encoder,x,y);
-  else if (dip_type == RANDOM_DIP) dip_found = computeRandomDIP(a,b,info,encoder,x,y);
+  int type = dip_type;
+  if (type == ADAPTIVE_DIP) type = MIDDLE_DIP + dipBandit.choose();
+  if (type == MIDDLE_DIP) dip_found = computeBestMiddleDIP(info,encoder,x,y);
+  else if (type == CLOSEST_TO_CONFLICT) dip_found = computeClosestDIPToConflict(a,b,info,encoder,x,y);
+  else if (type == RANDOM_DIP) dip_found = computeRandomDIP(a,b,info,encoder,x,y);
   else assert(false);
 
   if (not dip_found) return false;
   
   // //if (not computeRandomDIP(a,b,info,encoder,x,y)) return false;
   // //if (not computeClosestDIPToConflict(a,b,info,encoder,x,y)) return false;
-  // if (not computeBestMiddleDIP(info,encoder,pathA,pathB,x,y)) return false;
+  // if (not computeBestMiddleDIP(info,encoder,x,y)) return false;
   
   //cout << "DIP " << x << " " << y << " at conflict " << solver.conflicts << endl;
 
@@ -861,12 +904,14 @@ bool ConflictAnalyzer::computeDIPClauses (int a, int b, CRef confl, TwoVertexBot
   // This is done starting from conflict, doing standard 1UIP reasoning but stopping as soon as we hit the
   // two elements of the DIP
   assert(checkSeen3());
-  vector<Lit> toIncreaseActivity;
+  vector<Lit>& toIncreaseActivity = dipToIncreaseActivity;
+  toIncreaseActivity.clear();
   int dipReached = 0;
   Lit p = lit_Undef;
   int index = assignmentTrail.nAssigns() - 1;
   int heightX = -1, heightY = -1;
-  vector<Lit> afterLits;
+  vector<Lit>& afterLits = dipAfterLits;
+  afterLits.clear();
   do {
     assert(confl != CRef_Undef); // (otherwise should be UIP)
     Clause& c = ca[confl];
@@ -896,8 +941,7 @@ bool ConflictAnalyzer::computeDIPClauses (int a, int b, CRef confl, TwoVertexBot
         
     // Select next clause to look at:
     while (dipReached != 2) {
-      while (!seen3[var(assignmentTrail[index--])]);
-      p = assignmentTrail[index+1];
+      p = nextMarkedLit(seen3, index);
       if (p == x) heightX = index+1;
       else if (p == y) heightY = index+1;	  
       if (p != x and p != y) break;
@@ -993,7 +1037,8 @@ bool ConflictAnalyzer::computeDIPClauses (int a, int b, CRef confl, TwoVertexBot
                 // this lit has already been "regressed"
   p = (heightX > heightY ? x : y);
   index = max(heightX,heightY) - 1;
-  vector<Lit> beforeLits;
+  vector<Lit>& beforeLits = dipBeforeLits;
+  beforeLits.clear();
   confl = assignmentTrail.reason(var(p));
   seen3[var(x)] = seen3[var(y)] = true;
   // cout << "Començo amb x " << x << " alçada " << heightX << endl;
@@ -1025,8 +1070,7 @@ bool ConflictAnalyzer::computeDIPClauses (int a, int b, CRef confl, TwoVertexBot
     }
         
     // Select next clause to look at:
-    while (!seen3[var(assignmentTrail[index--])]);
-    p = assignmentTrail[index+1];
+    p = nextMarkedLit(seen3, index);
     confl = assignmentTrail.reason(var(p));
     //	cout << "Ara trec la reason de " << p << endl;
 	
@@ -1075,7 +1119,7 @@ void ConflictAnalyzer::writeEdgeInGraph (ofstream& out, const Lit& orig, const L
   out << endl;
 }
 
-void ConflictAnalyzer::writeDIPComputationInfo (TwoVertexBottlenecks& info, DIPGraphEncoder& encoder, const vector<int>& predecessors, const vector<Lit>& predecessorsLits, const vector<int>& predIndex, const vector<Lit>& literalsInAnalysis, bool foundDIP, const vector<int>& pathA, const vector<int>& pathB) {
+void ConflictAnalyzer::writeDIPComputationInfo (TwoVertexBottlenecks& info, DIPGraphEncoder& encoder, const vector<int>& predecessors, const vector<Lit>& predecessorsLits, const vector<int>& predIndex, const vector<Lit>& literalsInAnalysis, bool foundDIP) {
   cout << endl;
   cout << endl;
   cout << string(60,'=') << endl;
@@ -1097,15 +1141,15 @@ void ConflictAnalyzer::writeDIPComputationInfo (TwoVertexBottlenecks& info, DIPG
   
   cout << "Found DIP: " << (foundDIP?"true":"false") << endl;
   
-  vector<TwoVertexBottlenecks::VertPairInfo> listA = info.GetVertListA();
-  vector<TwoVertexBottlenecks::VertPairInfo> listB = info.GetVertListB();
+  const vector<TwoVertexBottlenecks::VertPairInfo>& listA = info.GetVertListA();
+  const vector<TwoVertexBottlenecks::VertPairInfo>& listB = info.GetVertListB();
 
   cout << string(30,'-') << endl;
   cout << "pathA: ";
-  for (int x : pathA) cout << x << " ";
+  for (int x : info.GetPathA()) cout << x << " ";
   cout << endl;
   cout << "pathB: ";
-  for (int x : pathB) cout << x << " ";
+  for (int x : info.GetPathB()) cout << x << " ";
   cout << endl << endl;
 
   cout << "List A: " << endl;
@@ -1130,8 +1174,6 @@ inline bool ConflictAnalyzer::getDIPLearntClauses (CRef confl, vec<Lit>& out_lea
   // Stuff for writing the conflict graph (useful for debugging/understanding)
   // Currently the writing is interleaved with the 1UIP computation
   // It might be cleaner to do it separately (but I think that is not a problem for efficiency)
-  string filename1 = "graph-"+to_string(solver.conflicts) + ".dot"; //conflict graph
-  string filename2 = "graph-current-"+to_string(solver.conflicts) + ".dot"; // conflict graph with only last-DL lits
   ofstream outAll;
   ofstream outCurrent;
   set<Lit> currentNodes;
@@ -1141,6 +1183,8 @@ inline bool ConflictAnalyzer::getDIPLearntClauses (CRef confl, vec<Lit>& out_lea
   //bool write = solver.conflicts == 44; // To write conflict graph only of a concrete conflict
 #define write 0 // quicker for release mode
   if (write) {
+    string filename1 = "graph-"+to_string(solver.conflicts) + ".dot"; //conflict graph
+    string filename2 = "graph-current-"+to_string(solver.conflicts) + ".dot"; // conflict graph with only last-DL lits
     outAll.open(filename1.c_str(),fstream::out);
     outCurrent.open(filename2.c_str(),fstream::out);
     outAll << "digraph D {" << endl;
@@ -1148,10 +1192,13 @@ inline bool ConflictAnalyzer::getDIPLearntClauses (CRef confl, vec<Lit>& out_lea
   }
 
   // Data structure for generating correct input for DIP-detection algorithm
-  DIPGraphEncoder encoder(assignmentTrail.nVars());
-  vector<Lit> predecessorsLits; // only needed for DIP-detection algorithm
-  vector<int> predIndex; // only needed for DIP-detection algorithm
-  vector<Lit> literalsInAnalysis; // only needed for DIP-detection algorithm
+  // (members, which are cleared instead of allocated for every conflict)
+  DIPGraphEncoder& encoder = dipEncoder;
+  encoder.reset(assignmentTrail.nVars());
+  vector<Lit>& predecessorsLits = dipPredecessorsLits; // only needed for DIP-detection algorithm
+  vector<int>& predIndex = dipPredIndex; // only needed for DIP-detection algorithm
+  vector<Lit>& literalsInAnalysis = dipLiteralsInAnalysis; // only needed for DIP-detection algorithm
+  predecessorsLits.clear(), predIndex.clear(), literalsInAnalysis.clear();
   // The latter stores the literals as they have appeared in the analysis (inverse topological order)
   // This will allow us to assign numbers respecting the order (the algorithm needs this)
   // Remember that conflict node is the sink (node 0), and the 1UIP is the source (node with largest N)
@@ -1161,7 +1208,8 @@ inline bool ConflictAnalyzer::getDIPLearntClauses (CRef confl, vec<Lit>& out_lea
 
   CRef origConfl = confl; // needed because confl is modified during the 1UIP detection    
 
-  vector<Lit> litsToNotifyBranchingHeuristic; // ALBERT: should explain and understand this
+  vector<Lit>& litsToNotifyBranchingHeuristic = dipLitsToNotify; // ALBERT: should explain and understand this
+  litsToNotifyBranchingHeuristic.clear();
 
   // Start by adding the edges from the negation of the lits  the conflicting clause to the "CONFLICT" node
   literalsInAnalysis.push_back(mkLit(assignmentTrail.nVars(),false)); // Fake literal corresponding to conflict
@@ -1219,8 +1267,7 @@ inline bool ConflictAnalyzer::getDIPLearntClauses (CRef confl, vec<Lit>& out_lea
     }
         
     // Select next clause to look at:
-    while (!seen[var(assignmentTrail[index--])]);
-    p     = assignmentTrail[index+1];
+    p     = nextMarkedLit(seen, index);
     confl = assignmentTrail.reason(var(p));
 
 	
@@ -1263,18 +1310,18 @@ inline bool ConflictAnalyzer::getDIPLearntClauses (CRef confl, vec<Lit>& out_lea
 
   clock_t start = clock(), end;
   
-  vector<int> predecessors;
+  vector<int>& predecessors = dipPredecessors;
+  predecessors.clear();
   for (auto lit : literalsInAnalysis) encoder.Solver2Sam(lit); // encode in topological order
   for (auto lit : predecessorsLits) predecessors.push_back(encoder.Solver2Sam(lit)); // map vec<Lit> to vec<int>
-  TwoVertexBottlenecks dip;
-  vector<int> pathA, pathB; // the two disjoint paths
-  int res = dip.CalcBottlenecks(predecessors,predIndex,pathA,pathB);
+  TwoVertexBottlenecks& dip = dipBottlenecks; // reused, keeps its buffers between conflicts
+  int res = dip.CalcBottlenecks(predecessors,predIndex);
   
   foundDIP =  (res > 0);
   
   
   if (write) 
-    writeDIPComputationInfo(dip,encoder,predecessors,predecessorsLits,predIndex,literalsInAnalysis,foundDIP,pathA,pathB);
+    writeDIPComputationInfo(dip,encoder,predecessors,predecessorsLits,predIndex,literalsInAnalysis,foundDIP);
   
   if (foundDIP) {
     
@@ -1293,10 +1340,22 @@ inline bool ConflictAnalyzer::getDIPLearntClauses (CRef confl, vec<Lit>& out_lea
     res/=2;
     int a = res;     
     
-    vec<Lit> dip_clause_to_learn;
-    vec<Lit> dip_clause_to_learn2;
+    vec<Lit>& dip_clause_to_learn = dipClause;
+    vec<Lit>& dip_clause_to_learn2 = dipClause2;
+    dip_clause_to_learn.clear(), dip_clause_to_learn2.clear();
     
-    bool ok = computeDIPClauses(a,b,origConfl,dip,encoder,dip_clause_to_learn,dip_clause_to_learn2,UIP,pathA, pathB);
+    bool ok = computeDIPClauses(a,b,origConfl,dip,encoder,dip_clause_to_learn,dip_clause_to_learn2,UIP);
+
+    // Reward the adaptive DIP type by the glue saved by the DIP clause
+    if (dipBandit.pending()) {
+      double reward = 0;
+      if (ok) {
+	int uipGlue = dipClauseGlue(out_learnt);
+	int dipGlue = dipClauseGlue(dip_clause_to_learn);
+	reward = std::min(1.0, std::max(0.0, double(uipGlue - dipGlue + 1)/(uipGlue + 1)));
+      }
+      dipBandit.update(reward);
+    }
     // If DIP-clause learning seems a good idea
     if (ok) {
 	// Clear seen marks
@@ -25,6 +25,7 @@ OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWA
 
 #include "core/SolverTypes.h"
 #include "core/TwoVertexBottlenecks.h"
+#include "core/DIPBandit.h"
 
 #include "er/ERManager.h"
 
@@ -48,13 +49,20 @@ namespace Minisat {
 
   public:
     int numVertices ( ) const;
-    DIPGraphEncoder (int nVars ):
+    DIPGraphEncoder (int nVars = 0):
       nextVertex(0), _solver2sam(nVars+1,DIP_ENCODER_UNDEF) { }
+    void reset (int nVars); // forget all vertices, keeping the memory
     Lit Sam2Solver (int var) const;
     int Solver2Sam (Lit lit);
   };
   
   inline int DIPGraphEncoder::numVertices ( )      const { return nextVertex; }
+  inline void DIPGraphEncoder::reset (int nVars) {
+    for (int i = 0; i < _sam2solver.size(); ++i) _solver2sam[var(_sam2solver[i])] = DIP_ENCODER_UNDEF;
+    _sam2solver.clear();
+    nextVertex = 0;
+    if (_solver2sam.size() < nVars+1) _solver2sam.growTo(nVars+1,DIP_ENCODER_UNDEF);
+  }
   inline Lit DIPGraphEncoder::Sam2Solver (int var) const { return _sam2solver[var]; };
   inline int DIPGraphEncoder::Solver2Sam (Lit lit)       {
     int v = var(lit);
@@ -111,9 +119,13 @@ namespace Minisat {
     static const int MIDDLE_DIP = 1;
     static const int CLOSEST_TO_CONFLICT = 2;
     static const int RANDOM_DIP = 3;
+    static const int ADAPTIVE_DIP = 4;
 
     // @brief Type of DIP computed
     int dip_type;
+
+    // @brief Chooses the type of DIP computed if dip_type is ADAPTIVE_DIP
+    DIPBandit dipBandit;
     
   public:
 
@@ -156,6 +168,27 @@ namespace Minisat {
 
     vec<Var> involved_vars;
 
+    /// @brief Two vertex bottleneck computation, reused across conflicts so that its buffers are kept
+    TwoVertexBottlenecks dipBottlenecks;
+
+    /// @brief Maps the conflict graph of @code{getDIPLearntClauses} to the vertices of @code{dipBottlenecks}
+    DIPGraphEncoder dipEncoder;
+
+    // Conflict graph on the conflict level, see @code{getDIPLearntClauses}
+    vector<Lit> dipPredecessorsLits;
+    vector<int> dipPredIndex;
+    vector<Lit> dipLiteralsInAnalysis;
+    vector<int> dipPredecessors;
+
+    /// @brief Literals bumped if the 1UIP clause is learnt instead of the DIP clause
+    vector<Lit> dipLitsToNotify;
+
+    /// @brief The DIP -> conflict and the UIP -> DIP clause
+    vec<Lit> dipClause, dipClause2;
+
+    // Temporaries of @code{computeDIPClauses} and @code{computeRandomDIP}
+    vector<Lit> dipToIncreaseActivity, dipAfterLits, dipBeforeLits, dipCandidatesY;
+
     ERManager* erManager;
       
   public:
@@ -257,10 +290,33 @@ namespace Minisat {
       
     bool collectFirstUIP(CRef confl);
 
+    /**
+     * @brief Find the highest decision level of the literals of a conflicting clause. Its
+     * literal of that level is moved to index 0 and the one of the next highest level to index 1
+     * if it is the only one of that level, in which case it should have been implied at the
+     * next highest level by the clause. This can only happen with chronological backtracking.
+     * 
+     * @param confl the conflicting clause
+     * @param out_single Output: whether a single literal is of the highest level
+     * @return the decision level of the conflict
+     */
+    int findConflictLevel(CRef confl, bool& out_single);
+
   private:
     ///////////////////////////////////////////////////////////////////////////////////////////
     // HELPER FUNCTIONS
 
+    /**
+     * @brief Walk down the trail to the next marked literal of the current decision level.
+     * With chronological backtracking, literals of lower levels may be interleaved with those
+     * of the current level; they are skipped even if marked.
+     * 
+     * @param marks the marks of the variables (@code{seen} or @code{seen3})
+     * @param index Input/Output: the trail index to start from, decremented past the literal
+     * @return the marked literal
+     */
+    Lit nextMarkedLit(const vec<bool>& marks, int& index) const;
+
     /**
      * @brief Check whether a literal is redundant and can be removed.
      * 
@@ -348,16 +404,16 @@ namespace Minisat {
 
     void writeDIPComputationInfo (TwoVertexBottlenecks& info, DIPGraphEncoder& encoder,
 				  const vector<int>& predecessors, const vector<Lit>& predecessorLits,
-				  const vector<int>& predIndex, const vector<Lit>& literalsInAnalysis, bool founDIP,
-				  const vector<int>& pathA, const vector<int>& pathB);
+				  const vector<int>& predIndex, const vector<Lit>& literalsInAnalysis, bool founDIP);
     void writeEdgeInGraph (ofstream& out, const Lit& orig, const Lit& dest, bool colored);
 
 
-    bool computeBestMiddleDIP (const TwoVertexBottlenecks& info, const DIPGraphEncoder& encoder, const vector<int>& pathA, const vector<int>& pathB, Lit& x, Lit& y);
-    bool computeRandomDIP (int a, int b, TwoVertexBottlenecks& info, const DIPGraphEncoder& encoder, Lit& x, Lit& y);
-    bool computeClosestDIPToConflict (int a, int b, TwoVertexBottlenecks& info, const DIPGraphEncoder& encoder, Lit& x, Lit& y);
+    bool computeBestMiddleDIP (const TwoVertexBottlenecks& info, const DIPGraphEncoder& encoder, Lit& x, Lit& y);
+    bool computeRandomDIP (int a, int b, const TwoVertexBottlenecks& info, const DIPGraphEncoder& encoder, Lit& x, Lit& y);
+    bool computeClosestDIPToConflict (int a, int b, const TwoVertexBottlenecks& info, const DIPGraphEncoder& encoder, Lit& x, Lit& y);
 
-    bool computeDIPClauses (int a, int b, CRef confl, TwoVertexBottlenecks& info, const DIPGraphEncoder& encoder, vec<Lit>& clause_to_learn1, vec<Lit>& clause_to_learn2, Lit UIP, vector<int>& pathA, vector<int>& pathB);
+    bool computeDIPClauses (int a, int b, CRef confl, const TwoVertexBottlenecks& info, const DIPGraphEncoder& encoder, vec<Lit>& clause_to_learn1, vec<Lit>& clause_to_learn2, Lit UIP);
+    int dipClauseGlue (const vec<Lit>& c);
     bool ok_DIP (Lit dip1, Lit dip2, Lit UIP, CRef confl);
     bool checkSeen3();
   public:
@@ -0,0 +1,108 @@
+/*************************************************************************************[DIPBandit.h]
+MiniSat -- Copyright (c) 2003-2006, Niklas Een, Niklas Sorensson
+           Copyright (c) 2007-2010, Niklas Sorensson
+
+MapleSAT_Refactor, based on MapleSAT -- Copyright (c) 2022, Jonathan Chung, Vijay Ganesh, Sam Buss
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of this software and
+associated documentation files (the "Software"), to deal in the Software without restriction,
+including without limitation the rights to use, copy, modify, merge, publish, distribute,
+sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all copies or
+substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT
+NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT
+OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+**************************************************************************************************/
+
+#ifndef Minisat_DIPBandit_h
+#define Minisat_DIPBandit_h
+
+#include <cassert>
+#include <cmath>
+
+namespace Minisat {
+    /**
+     * @brief Multi-armed bandit that chooses online between the DIP selection strategies
+     * (middle, closest to conflict, random) for dip-type 4. It is UCB1 on discounted
+     * statistics: after every update all rewards and counts are multiplied by 'decay', so
+     * that the choice follows changes of the search. Rewards are expected to be in [0,1].
+     * 
+     */
+    class DIPBandit {
+    public:
+        static const int arms = 3;
+        static constexpr double decay = 0.999;
+
+    private:
+        /// @brief Discounted sum of rewards of each arm
+        double reward[arms];
+
+        /// @brief Discounted number of plays of each arm
+        double count[arms];
+
+        /// @brief Sum of the discounted counts
+        double total;
+
+        /// @brief Arm returned by the last call to @code{choose}
+        int last;
+
+        /// @brief Whether @code{choose} has been called without a matching @code{update}
+        bool pending_;
+
+    public:
+        DIPBandit() { reset(); }
+
+        void reset() {
+            for (int a = 0; a < arms; a++) reward[a] = count[a] = 0;
+            total = 0;
+            last = 0;
+            pending_ = false;
+        }
+
+        bool pending() const { return pending_; }
+
+        /**
+         * @brief Choose the arm with the largest upper confidence bound. Arms that have never
+         * been played are chosen first.
+         * 
+         * @return the arm in [0, arms)
+         */
+        int choose() {
+            int best = 0;
+            double bestScore = -1;
+            for (int a = 0; a < arms; a++) {
+                if (count[a] == 0) { best = a; break; }
+                double score = reward[a] / count[a] + std::sqrt(2 * std::log(total) / count[a]);
+                if (score > bestScore) { best = a; bestScore = score; }
+            }
+            pending_ = true;
+            return last = best;
+        }
+
+        /**
+         * @brief Report the reward of the arm returned by the last call to @code{choose}.
+         * 
+         * @param r the reward, in [0,1]
+         */
+        void update(double r) {
+            assert(pending_);
+            assert(0 <= r && r <= 1);
+            for (int a = 0; a < arms; a++) {
+                reward[a] *= decay;
+                count[a] *= decay;
+            }
+            total = total * decay + 1;
+            reward[last] += r;
+            count[last] += 1;
+            pending_ = false;
+        }
+    };
+}
+
+#endif
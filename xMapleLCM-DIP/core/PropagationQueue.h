@@ -148,6 +148,15 @@ namespace Minisat {
          */
         bool simpleEnqueue(Lit p, CRef from = CRef_Undef);
 
+        /**
+         * @brief Add a literal to the propagation queue and assign it right away, even if
+         * assignments are otherwise delayed until the literal is propagated
+         * 
+         * @param p the literal to add to the queue, which must be unassigned and not queued
+         * @param from the reason for the literal
+         */
+        void enqueueAssigned(Lit p, CRef from = CRef_Undef);
+
         /**
          * @brief Add a set of literals to the propagation queue
          * 
@@ -221,6 +230,18 @@ namespace Minisat {
         return genericEnqueue<true>(p, from);
     }
 
+    inline void PropagationQueue::enqueueAssigned(Lit p, CRef from) {
+        switch (propagationMode) {
+            case PropagationMode::DELAYED: {
+                // Literals on the trail are propagated before those in the priority queue
+                assert(soft_assigns[var(p)] == l_Undef);
+                assignmentTrail.assign(p, from);
+            } break;
+
+            default: genericEnqueue<false>(p, from);
+        }
+    }
+
     inline void PropagationQueue::batchEnqueue(const vec<Lit>& trail, int levelHead) {
         switch (propagationMode) {
             case PropagationMode::IMMEDIATE:
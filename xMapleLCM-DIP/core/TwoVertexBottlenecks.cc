@@ -33,98 +33,21 @@ inline void UpdateMin(int& runningMin, int newValue) {
     }
 }
 
-// ********************************************
-// Internal data structures.
-// ********************************************
+// The internal data structures (vertInfo, reachInfo, pivotInfoPlus) are
+// declared in TwoVertexBottlenecks.h so that their arrays can be retained
+// between calls.
 
-//   vertInfo-- uSed in Phases A, B, C
-//   Tracks for each vertex: whether it is on a path
-//           and whether it has been visited the depth first searches.
-
-class vertInfo {
-public:
-    int status = 0;     // Status
-    int succ = -1;      // Successor node, i.e, on the path towards the sink (vertex 0).
-
-    // Handle membership on first path.  
-    bool TestOnFirst() const { return status & 0x01; }  // Test whether on first path.
-    void SetOnFirst() { status = status | 0x01; }       // Mark as on first path
-    void ResetOnFirst() { status = (status & ~0x01); }  // Mark as not on first path
-
-    bool TestOnSecond() const { return status & 0x02; } // Test whether on second path
-    void SetOnSecond() { status = status | 0x02; }      // Mark as on second path
-
-    // TestOnPath returns 0, 1, 2, 3 - If on neither path, path one, path two or both.
-    int TestOnPath() const { return (status & 0x03); }   
-    // Test if on path two (leftFlag==1) or on path 1 (leftFlag==0)
-    bool TestOnPath(int leftFlag) const { return status & (0x01 << leftFlag); } 
-
-    bool TestReachedPhaseB() const { return status & 0x04; }
-    // Mark as reached in Phase B.  Returns true is already was reached in Phase B
-    bool ReachedInPhaseB() {
-        bool ret = status & 0x04;
-        status = status | 0x04;
-        return ret;
-    }
-
-    // Mark as reached in Phase C.  Returns true is already was reached in Phase C
-    // leftFlag will be 0 or 1 for working on reachability 
-    //     from left path vertices or from right path vertices (respectively)
-    bool ReachedInPhaseC( int leftFlag ) {
-        bool ret = status & (0x08 << leftFlag);
-        status = status | (0x08 << leftFlag);
-        return ret;
-    }
-};
-
-class reachInfo {
-    // maxDirectReachOnPath - max. reachable node on the path.
-    // minAncestorOnPath - min reachable node on the path,
-    //                       allowing traversing vertices on the *other* path.
-public:
-    reachInfo(int maxReach, int minAncestor)
-        : maxDirectReachOnPath(maxReach), minAncestorOnPath(minAncestor) {}
-    int maxDirectReachOnPath;
-    int minAncestorOnPath;
-};
-
-class pivotInfo {
-    // In the array of pathJumpingInfo objects:
-    //     First PivotVert 0. (Sink)   Last PivotVert is N-1. (Source)
-    //     MaxReachOtherPath is *non-decreasing*
-
-public:
-    pivotInfo(int vert, int maxReach) { PivotVert = vert; MaxReachOtherPath = maxReach; }
-
-    int PivotVert;  
-    int MaxReachOtherPath;
-};
-
-class pivotInfoPlus {
-    // In the array of pathJumpingInfoPlus objects:
-    //     First PivotVert 0. (Sink)   Last PivotVert is N-1. (Source)
-    //     MaxReachOtherPath may not be non-decreasing, but it
-    //         would be once points on the other path which are not pivots are skipped.
-    //     MinAncestorOtherPath is non-decreasing.
-    //     MaxReachOtherPath is initially used for the max reachable vertex on the same path,
-    //         but then is replaced with the max reachable vertex on the other path.
-
-public:
-    pivotInfoPlus() { assert(false); }
-    pivotInfoPlus(int vert, int maxReach) 
-    : PivotVert(vert), MaxReachOtherPath(maxReach) {}
-
-    int PivotVert;
-    int MaxReachOtherPath;
-    int MinAncestorOtherPath;
-};
-
-int TwoVertexBottlenecks::CalcBottlenecks(int N, const int predecessors[], const int predIndex[], std::vector<int>& pathA, std::vector<int>& pathB, int maxNumGroups)
+int TwoVertexBottlenecks::CalcBottlenecks(int N, const int predecessors[], const int predIndex[], int maxNumGroups)
 {
-    // Allocate vertex info array.
-    std::vector<vertInfo> verts(N);
+    // Reset vertex info array.  Capacity is kept from earlier calls.
+    verts.assign(N, vertInfo());
     
     Clear();    // Initialize output info 
+    vertsForDFS.clear();
+    directReach1.clear();
+    directReach2.clear();
+    leftPathPivotsBis.clear();
+    rightPathPivotsBis.clear();
 
     // ***************************************************
     // Phase A: Construct a path from the sink to the source (in direction of reverse edges)
@@ -150,7 +73,6 @@ int TwoVertexBottlenecks::CalcBottlenecks(int N, const int predecessors[], const
     int startDFS = 0;
     int maxReachedOnPath = 0;               // Highest reached vertex on first path.
     int maxReachedFrom;                     // Vertex from which the highest reached vertex was encountered.
-    std::vector<int> vertsForDFS;           // Stack of vertices to explore for depth first search
     
     while (true) {
         vertsForDFS.push_back(startDFS);
@@ -225,26 +147,28 @@ int TwoVertexBottlenecks::CalcBottlenecks(int N, const int predecessors[], const
 
     //std::cout << "Path B: " << N-1;
     verts[N - 1].SetOnSecond();
-    pathA.push_back(N-1);
+    PathA.push_back(N-1);
     for (curVert = maxReachedFrom; curVert != 0; curVert = verts[curVert].succ) {
       //std::cout << " " << curVert;
-      pathA.push_back(curVert);
+      verts[curVert].pathPos = (int)PathA.size();
+      PathA.push_back(curVert);
       verts[curVert].SetOnSecond();
       verts[curVert].ResetOnFirst();
     }
     verts[0].SetOnSecond();
     //    std::cout << " 0" << std::endl;
-    pathA.push_back(0);
+    PathA.push_back(0);
 
     //std::cout << "Path A: " << N - 1;
-    pathB.push_back(N-1);
+    PathB.push_back(N-1);
     for (int k = N-2; k > 0; --k)
       if (verts[k].TestOnFirst()) {
 	//std::cout << " " << k;
-	pathB.push_back(k);
+	verts[k].pathPos = (int)PathB.size();
+	PathB.push_back(k);
       }
     //std::cout << " 0" << std::endl;
-    pathB.push_back(0);
+    PathB.push_back(0);
     
     // The vertex at the top of path 1 is verts[N-1].succ.
     // The vertex at the top of path 2 is lastVertSecondPath.
@@ -270,9 +194,6 @@ int TwoVertexBottlenecks::CalcBottlenecks(int N, const int predecessors[], const
     //   We are interested in these values for all vertices in *both* paths.
     // *****************************************************
 
-    std::vector<reachInfo> directReach1;
-    std::vector<reachInfo> directReach2;
-
     directReach1.emplace_back(N - 1, N - 1);  // First entry is for vertex N-1 (the source)
     directReach2.emplace_back(N - 1 , N - 1);  // ditto
     int lastPredIdx = predIndex[N - 1] - 1;  // No predecessor is traversed yet.
@@ -328,8 +249,6 @@ int TwoVertexBottlenecks::CalcBottlenecks(int N, const int predecessors[], const
     // All this information is stored in leftPathPivotsBis
     //    and rightPathPivotsBis
     // **********************************************
-    std::vector<pivotInfoPlus> leftPathPivotsBis;
-    std::vector<pivotInfoPlus> rightPathPivotsBis;
     for (int leftFlag = 0; leftFlag <= 1; leftFlag++) {
         // leftFlag==0 - finding the pivots for the left path
         // leftFlag==1 - finding the pivots for the right path.
@@ -378,6 +297,7 @@ int TwoVertexBottlenecks::CalcBottlenecks(int N, const int predecessors[], const
         const std::vector<pivotInfoPlus>& thisPathPivots = (leftFlag == 0) ? leftPathPivotsBis : rightPathPivotsBis;
         const std::vector<pivotInfoPlus>& otherPathPivots = (leftFlag == 0) ? rightPathPivotsBis : leftPathPivotsBis;
         std::vector<VertPairInfo>& vertListX = (leftFlag == 0) ? VertListA : VertListB;
+        const int sinkPos = (int)((leftFlag == 0) ? PathA : PathB).size() - 1;
         if (otherPathPivots.size() == 1) {
             return 0;                   // No two vertex bottlenexks - Source and sink are three connected.
         }
@@ -396,7 +316,9 @@ int TwoVertexBottlenecks::CalcBottlenecks(int N, const int predecessors[], const
             int upperBdPair = (otherPathPivot-1)->PivotVert;
             int lowerBdPair = curPivot->MaxReachOtherPath;   // Max reachable by a vertex below the curPivot vertex.
             if (lowerBdPair <= upperBdPair && (upperBdPair < N - 1 || lowerBdPair <= butLastOtherPathPivotVert)) {
-                vertListX.emplace_back(curPivot->PivotVert, lowerBdPair, upperBdPair, curPivot->MinAncestorOtherPath);
+                const int pathPos = verts[curPivot->PivotVert].pathPos;
+                vertListX.emplace_back(curPivot->PivotVert, lowerBdPair, upperBdPair, curPivot->MinAncestorOtherPath,
+                                       pathPos, sinkPos - pathPos);
             }
             // XXX UpdateMax(curMaxReachThisToOther, curPivot->MaxReachOtherPath);
         }
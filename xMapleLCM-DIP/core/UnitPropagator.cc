@@ -193,6 +193,22 @@ inline CRef UnitPropagator::propagateSingleNonBinary(Lit p) {
         i->blocker = first;
         *j++ = *i++;
 
+        // With chronological backtracking 'p' may be of a lower level than other false literals.
+        // Watch the one of the highest level instead, so that the clause becomes unit again
+        // whenever 'first' is unassigned.
+        if (!simple && assignmentTrail.chronological && assignmentTrail.value(first) == l_Undef) {
+            int i_max = 1;
+            for (int k = 2; k < c.size(); k++)
+                if (assignmentTrail.level(var(c[k])) > assignmentTrail.level(var(c[i_max])))
+                    i_max = k;
+
+            if (i_max != 1) {
+                std::swap(c[1], c[i_max]);
+                watches[~c[1]].push(Watcher(cr, first));
+                j--;
+            }
+        }
+
         if (
             assignmentTrail.value(first) == l_False ||
             !enqueue<simple>(propagationQueue, first, cr)
@@ -292,7 +292,8 @@ void ERManager::introduceExtVars(
     // Add extension definition clauses
     for (const ExtDef& def : *extVarDefBuffer) {
         const Lit x = def.x, a = def.a, b = def.b;
-        assert(var(x) >= originalNumVars && var(x) > var(a) && var(x) > var(b));
+        assert(var(x) > var(a) && var(x) > var(b));
+        extVars[var(x)] = true;
         
         // Update extension level
 #if PRIORITIZE_ER || BUMP_ER
@@ -434,7 +435,10 @@ bool ERManager::substitute(vec<Lit>& clause, SubstitutionPredicate& p) {
     res = true;
     
     // Ensure variables are assigned so the clause is still asserting. Some extension variables
-    // are undefined after substitution, so we need to propagate from their definitions
+    // are undefined after substitution, so we need to propagate from their definitions. They
+    // have to be assigned before the clause is, also when assignments are delayed.
+    // With chronological backtracking, this is expected for extension variables that were
+    // assigned after the literals they are substituted for, at a level above the backtrack level.
     for (int i = (extLits[0] == clause[0]) ? 1 : 0; i < extLits.size(); i++) {
         Lit x = extLits[i];
         if (assignmentTrail.value(x) != l_Undef) continue;
@@ -443,10 +447,12 @@ bool ERManager::substitute(vec<Lit>& clause, SubstitutionPredicate& p) {
         assert(cr != CRef_Undef);
         unitPropagator.enforceWatcherInvariant(cr, i_undef, i_max);
         Clause& c = ca[cr];
-	cout << endl;
-	cout << "ALERT!!!!! UNEXPECTED BEHAVIOUR" << endl;
-	cout << endl;
-        propagationQueue.enqueue(c[0], cr);
+	if (!assignmentTrail.chronological) {
+	  cout << endl;
+	  cout << "ALERT!!!!! UNEXPECTED BEHAVIOUR" << endl;
+	  cout << endl;
+	}
+        propagationQueue.enqueueAssigned(c[0], cr);
     }
 
 EXIT_SUBSTITUTE:;
@@ -29,6 +29,8 @@ using namespace Minisat;
 static const char* _cat2 = "DIP";
 static BoolOption   opt_compute_dip            (_cat2, "compute-dip",   "Compute DIP.", true);
 static BoolOption   disabling_dip              (_cat2, "disabling-dip",   "Allows dynamically disabling DIP computation if the perc. of decisions on exteded variables is low.", false);
+static IntOption    opt_chrono                 (_cat2, "chrono",          "Backtrack chronologically if the backtrack level is at least this many levels below the conflict (-1 means never).", -1, IntRange(-1, INT32_MAX));
+static IntOption    opt_confl_to_chrono        (_cat2, "confl-to-chrono", "Number of conflicts before backtracking chronologically.", 4000, IntRange(0, INT32_MAX));
 
 ///////////////////////////////////////////////////////////////////////////////////////////////////
 // CONSTRUCTORS
@@ -36,34 +38,53 @@ static BoolOption   disabling_dip              (_cat2, "disabling-dip",   "Allow
 ERSolver::ERSolver()
   : Solver()
   , erManager(*this)
+  , statsCallback(NULL)
+  , statsInterval(0)
+  , terminateCallback(NULL)
+  , terminateState(NULL)
+  , learnCallback(NULL)
+  , learnState(NULL)
   , use_dip(opt_compute_dip)
+  , chrono(opt_chrono)
+  , confl_to_chrono(opt_confl_to_chrono)
+  , chrono_backtrack(0)
+  , non_chrono_backtrack(0)
   , allow_dip_disabling(disabling_dip)
+  , dip_some_very_high(false)
+  , dip_some_evaluation(false)
+  , dip_suspended_until(0)
+  , dip_suspension(100000)
 {
   this->conflictAnalyzer.notifyERManager(&erManager);
+  assignmentTrail.chronological = chrono >= 0;
 }
 
 ///////////////////////////////////////////////////////////////////////////////////////////////////
 // HELPER FUNCTIONS
 
-void ERSolver::disable_DIP_computation_if_needed ( ){
-  if (not allow_dip_disabling) return;
-  static bool some_very_high = false;
-  static bool some_evaluation = false;
-  static vector<double> window;  
-  if (use_dip and not some_very_high) {
+// Returns true if DIP computation should be skipped for this conflict. Every 10000 conflicts
+// the percentage of decisions on extension variables is sampled. If it did not grow over a
+// window of samples, DIP computation is suspended, first for 100000 conflicts, doubling on
+// every suspension, and then tried again (instead of switching it off for good).
+bool ERSolver::disable_DIP_computation_if_needed ( ){
+  if (not allow_dip_disabling) return false;
+  if (use_dip and not dip_some_very_high) {
+    if (conflicts < dip_suspended_until) return true;
     if (conflicts%10000 == 0) {
-      window.push_back(double(erManager.branchOnExt)/branchingHeuristicManager.decisions*100);
-      if ((not some_evaluation and window.size() == 20) or (some_evaluation and window.size() == 10)) {
-	some_evaluation = true;
+      dip_window.push_back(double(erManager.branchOnExt)/branchingHeuristicManager.decisions*100);
+      if ((not dip_some_evaluation and dip_window.size() == 20) or (dip_some_evaluation and dip_window.size() == 10)) {
+	dip_some_evaluation = true;
 	//	cout << "Window full" << endl;
-	if (window.back() >= 5) {/*cout << "Some very high" << endl;*/ some_very_high = true;}
-	if (some_very_high or
-	    (window.back() - window[0] > 0)) {/*cout << "Continue" << endl;*/}
-	else {/*cout << "Deactivate" << endl;*/use_dip = false;}
-	window.clear();
+	if (dip_window.back() >= 5) {/*cout << "Some very high" << endl;*/ dip_some_very_high = true;}
+	if (dip_some_very_high or
+	    (dip_window.back() - dip_window[0] > 0)) {/*cout << "Continue" << endl;*/}
+	else {/*cout << "Suspend" << endl;*/ dip_suspended_until = conflicts + dip_suspension; dip_suspension *= 2;}
+	dip_window.clear();
       }
     }
+    return conflicts < dip_suspended_until;
   }
+  return false;
 }
 
 lbool ERSolver::search(int& nof_conflicts) {
@@ -99,7 +120,7 @@ lbool ERSolver::search(int& nof_conflicts) {
  
     if (confl != CRef_Undef) {
 
-      disable_DIP_computation_if_needed();
+      bool dip_suspended = disable_DIP_computation_if_needed();
       // if (conflicts % 10000 == 0)
       // 	cout << "We had " << branchingHeuristicManager.decisions << " decisions of which only " << double(erManager.branchOnExt)/branchingHeuristicManager.decisions*100 << " were on extended" << endl;
 
@@ -107,24 +128,55 @@ lbool ERSolver::search(int& nof_conflicts) {
       // CONFLICT
       assert(conflictAnalyzer.checkSeen());
       conflicts++;
+      if (statsCallback && statsInterval && conflicts % statsInterval == 0) statsCallback(*this);
+      if (terminateCallback && terminateCallback(terminateState)) interrupt();
 
       if (assignmentTrail.decisionLevel() == 0) return l_False;
 
+      // With chronological backtracking, the conflict may be below the current decision level,
+      // where the analysis has to take place
+      if (assignmentTrail.chronological) {
+	bool single;
+	int conflict_level = conflictAnalyzer.findConflictLevel(confl, single);
+	if (conflict_level == 0) return l_False;
+
+	if (single) {
+	  // The clause is not conflicting but implies its literal of the conflict level one level
+	  // below: no need to learn anything
+	  assignmentTrail.cancelUntilLevel(conflict_level - 1);
+	  propagationQueue.enqueue(ca[confl][0], confl);
+	  continue;
+	}
+
+	assignmentTrail.cancelUntilLevel(conflict_level);
+      }
+
       clauseDatabase.handleEventConflicted(conflicts);
       branchingHeuristicManager.handleEventConflicted(confl, conflicts);
       learnt_clause.clear();
       learnt_clause_UIP_to_DIP.clear();
 
-      if (use_dip) {     
+      if (use_dip and not dip_suspended) {     
 	if (conflictAnalyzer.analyze(confl, learnt_clause, backtrack_level, lbd, learnt_clause_UIP_to_DIP))
 	  dip_conflicts++;
       }
       else conflictAnalyzer.analyze1UIP(confl, learnt_clause, backtrack_level, lbd);
 	
       assert(conflictAnalyzer.checkSeen());
-      assignmentTrail.cancelUntilLevel(backtrack_level);
 
-      if (use_dip) {
+      // Backtrack only one level if the backtrack level is far below the conflict level. The
+      // asserting literal is then implied at the backtrack level anyway.
+      bool chrono_backtracked = learnt_clause.size() > 1 && chrono >= 0 && conflicts > (uint64_t)confl_to_chrono
+	&& assignmentTrail.decisionLevel() - backtrack_level >= chrono;
+      if (chrono_backtracked) {
+	chrono_backtrack++;
+	assignmentTrail.cancelUntilLevel(assignmentTrail.decisionLevel() - 1);
+      } else {
+	non_chrono_backtrack++;
+	assignmentTrail.cancelUntilLevel(backtrack_level);
+      }
+
+      if (use_dip and not dip_suspended) {
 	// EXTENDED RESOLUTION - substitute disjunctions with extension variables. This must be
 	// called after backtracking because extension variables might need to be propagated.
 	bool subst = erManager.substitute(learnt_clause);
@@ -143,7 +195,7 @@ lbool ERSolver::search(int& nof_conflicts) {
 	  if (max_pos != 1)
 	    swap(learnt_clause[1],learnt_clause[max_pos]);
 	  
-	  assignmentTrail.cancelUntilLevel(max_level);
+	  if (!chrono_backtracked) assignmentTrail.cancelUntilLevel(max_level);
 	  lbd = assignmentTrail.computeLBD(learnt_clause); // it might have changed
 	}
       }
@@ -176,7 +228,8 @@ lbool ERSolver::search(int& nof_conflicts) {
 #endif
 
       // Output to proof file
-      proofLogger.addClause(learnt_clause);	    
+      proofLogger.addClause(learnt_clause);
+      if (learnCallback) learnCallback(learnState, learnt_clause);
 	    
       if (learnt_clause_UIP_to_DIP.size()) {
 	assert(learn_two_DIP_clauses);
@@ -212,15 +265,33 @@ lbool ERSolver::search(int& nof_conflicts) {
       // Reduce the set of learnt clauses:
       clauseDatabase.checkReduceDB(conflicts);
 
-      // New variable decision:
-      Lit next = branchingHeuristicManager.pickBranchLit();
-      if (next == lit_Undef)
-	// Model found:
-	return l_True;
+      Lit next = lit_Undef;
+      while (assignmentTrail.decisionLevel() < assumptions.size()) {
+	// Perform user provided assumption:
+	Lit p = assumptions[assignmentTrail.decisionLevel()];
+	if (assignmentTrail.value(p) == l_True) {
+	  // Dummy decision level:
+	  assignmentTrail.newDecisionLevel();
+	} else if (assignmentTrail.value(p) == l_False) {
+	  conflictAnalyzer.analyzeFinal(~p, conflict);
+	  return l_False;
+	} else {
+	  next = p;
+	  break;
+	}
+      }
 
-      // Update stats
-      if (erManager.isExtVar(var(next)))
-	erManager.branchOnExt++;
+      if (next == lit_Undef) {
+	// New variable decision:
+	next = branchingHeuristicManager.pickBranchLit();
+	if (next == lit_Undef)
+	  // Model found:
+	  return l_True;
+
+	// Update stats
+	if (erManager.isExtVar(var(next)))
+	  erManager.branchOnExt++;
+      }
 
 	    
       // Increase decision level and enqueue 'next'
@@ -239,8 +310,9 @@ lbool ERSolver::solve_() {
 
   solves++;
 
-  // Initialize solver components
-  erManager.init();
+  // The previous call may have ended with another heuristic active, whose heap then received
+  // the variables unassigned on the final backtrack
+  branchingHeuristicManager.rebuildPriorityQueue();
 
   lbool status = l_Undef;
 
@@ -275,9 +347,10 @@ lbool ERSolver::solve_() {
   if (status == l_False) proofLogger.flush();
 
   if (status == l_True) {
-    // Extend & copy model:
+    // Extend & copy model (extension variables are left undefined):
     model.growTo(assignmentTrail.nVars());
-    for (int i = 0; i < assignmentTrail.nVars(); i++) model[i] = assignmentTrail.value(i);
+    for (int i = 0; i < assignmentTrail.nVars(); i++)
+      model[i] = erManager.isExtVar(i) ? l_Undef : assignmentTrail.value(i);
   } else if (status == l_False && conflict.size() == 0) {
     ok = false;
   }
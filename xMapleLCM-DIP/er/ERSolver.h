@@ -31,6 +31,10 @@ namespace Minisat {
     /**
      * @brief This class augments the base solver with extended resolution capabilities.
      * 
+     * The solver can be used incrementally: variables and clauses may be added between calls to
+     * @code{solve}, each under its own assumptions. Extension variables, their definitions and the
+     * clauses learnt over them are kept across calls. Extension variables are left undefined in
+     * @code{model} and never occur in @code{conflict}, which only contains negated assumptions.
      */
     class ERSolver : public Solver {
 
@@ -44,12 +48,45 @@ namespace Minisat {
         /// @brief The extended resolution component
         ERManager erManager;
 
+        /// @brief Called every 'statsInterval' conflicts during search if both are set (used in
+        /// Main.cc to write time-series statistics)
+        void (*statsCallback)(ERSolver&);
+        uint64_t statsInterval;
+
+        /// @brief Polled on every conflict during search if set, which is interrupted once it
+        /// returns non-zero (used by 'ipasir_set_terminate')
+        int (*terminateCallback)(void*);
+        void* terminateState;
+
+        /// @brief Called with every learnt clause if set, which may contain extension variables
+        /// (used by 'ipasir_set_learn')
+        void (*learnCallback)(void*, const vec<Lit>&);
+        void* learnState;
+
         /// @brief Whether to use DIPs
         bool use_dip;
 
+        /// @brief Backtrack chronologically, i.e., only one level, if the backtrack level of a
+        /// learnt clause is at least this many levels below the conflict (-1 means never), once
+        /// there were 'confl_to_chrono' conflicts
+        int chrono;
+        int confl_to_chrono;
+
+        /// @brief The number of chronological and non-chronological backtracks after conflicts
+        uint64_t chrono_backtrack;
+        uint64_t non_chrono_backtrack;
+
       /// @brief Whether to dynamically decide to disable DIP computation
       bool allow_dip_disabling ;
 
+      /// @brief State of disable_DIP_computation_if_needed: samples of the percentage of
+      /// decisions on extension variables, and the suspension of DIP computation
+      bool dip_some_very_high;
+      bool dip_some_evaluation;
+      std::vector<double> dip_window;
+      uint64_t dip_suspended_until;
+      uint64_t dip_suspension;
+
     public:
         ///////////////////////////////////////////////////////////////////////////////////////////
         // CONSTRUCTORS
@@ -127,7 +164,7 @@ namespace Minisat {
         virtual void handleEventClauseDeleted(const Clause& c, CRef cr);
 
     private:
-      void disable_DIP_computation_if_needed();
+      bool disable_DIP_computation_if_needed();
     };
   
   
@@ -47,6 +47,7 @@ void printStats(ERSolver& solver) {
     printf("decisions                 : %-12" PRIu64 "   (%4.2f %% random) (%.0f /sec)\n", solver.branchingHeuristicManager.decisions, 0.f, solver.branchingHeuristicManager.decisions   /cpu_time);
     printf("propagations              : %-12" PRIu64 "   (%.0f /sec)\n", solver.unitPropagator.propagations, solver.unitPropagator.propagations/cpu_time);
     printf("conflict literals         : %-12" PRIu64 "   (%4.2f %% deleted)\n", solver.conflictAnalyzer.tot_literals, (solver.conflictAnalyzer.max_literals - solver.conflictAnalyzer.tot_literals)*100 / (double)solver.conflictAnalyzer.max_literals);
+    printf("chrono backtracks         : %-12" PRIu64 "   (%4.2f %% of backtracks)\n", solver.chrono_backtrack, double(solver.chrono_backtrack)/(solver.chrono_backtrack + solver.non_chrono_backtrack)*100);
     printf("\n");
     
     // Extended resolution stats
@@ -78,6 +79,32 @@ void printStats(ERSolver& solver) {
 }
 
 
+// Machine readable statistics: a JSON object on a single line, written every 'json-interval'
+// conflicts as 'sample' and at the end as 'summary'.
+static FILE* json_file = NULL;
+
+static void printJSON(ERSolver& solver, const char* type) {
+    if (json_file == NULL) return;
+    const ERManager& erm = solver.erManager;
+    ClauseDatabase& db = solver.clauseDatabase;
+    fprintf(json_file, "{\"type\":\"%s\",\"cpu_time\":%.3f", type, cpuTime());
+    fprintf(json_file, ",\"rss_mb\":%.2f,\"max_rss_mb\":%.2f", memUsed(), memUsedPeak());
+    fprintf(json_file, ",\"conflicts\":%" PRIu64 ",\"decisions\":%" PRIu64 ",\"propagations\":%" PRIu64 ",\"restarts\":%" PRIu64,
+            solver.conflicts, solver.branchingHeuristicManager.decisions, solver.unitPropagator.propagations, solver.starts);
+    fprintf(json_file, ",\"clauses\":{\"irredundant\":%d,\"redundant\":%d,\"core\":%d,\"tier2\":%d,\"local\":%d}",
+            db.nClauses(), db.nLearnts(), db.getDB<CORE>().size(), db.getDB<TIER2>().size(), db.getDB<LOCAL>().size());
+    fprintf(json_file, ",\"dip\":{\"exists\":%d,\"conflicts\":%" PRIu64 ",\"dangerous\":%d}",
+            solver.conflictAnalyzer.conflicts_with_dip, solver.dip_conflicts, solver.conflictAnalyzer.conflicts_with_dangerous_dip);
+    fprintf(json_file, ",\"ext_vars\":{\"total\":%" PRIu64 ",\"live\":%" PRIu64 ",\"deleted\":%" PRIu64 ",\"max\":%" PRIu64 ",\"decisions\":%" PRIu64 "}",
+            erm.total_ext_vars, erm.total_ext_vars - erm.deleted_ext_vars, erm.deleted_ext_vars, erm.max_ext_vars, erm.branchOnExt);
+    fprintf(json_file, ",\"timers\":{\"er_sel\":%.3f,\"er_add\":%.3f,\"er_delC\":%.3f,\"er_delV\":%.3f,\"er_sub\":%.3f,\"er_stat\":%.3f,\"dip\":%.3f}}\n",
+            erm.extTimerRead(0), erm.extTimerRead(1), erm.extTimerRead(2), erm.extTimerRead(3), erm.extTimerRead(4), erm.extTimerRead(5), solver.conflictAnalyzer.time_DIP);
+    fflush(json_file);
+}
+
+static void printJSONSample(ERSolver& solver) { printJSON(solver, "sample"); }
+
+
 static ERSolver* solver;
 // Terminate by notifying the solver and back out gracefully. This is mainly to have a test-case
 // for this feature of the Solver as it may take longer than an immediate call to '_exit()'.
@@ -91,6 +118,7 @@ static void SIGINT_exit(int signum) {
     if (solver->verbosity > 0){
         printStats(*solver);
         printf("\n"); printf("*** INTERRUPTED ***\n"); }
+    printJSON(*solver, "summary");
     _exit(1); }
 
 
@@ -113,6 +141,9 @@ int main(int argc, char** argv) {
         IntOption    verb   ("MAIN", "verb",   "Verbosity level (0=silent, 1=some, 2=more).", 1, IntRange(0, 2));
         IntOption    cpu_lim("MAIN", "cpu-lim","Limit on CPU time allowed in seconds.\n", INT32_MAX, IntRange(0, INT32_MAX));
         IntOption    mem_lim("MAIN", "mem-lim","Limit on memory usage in megabytes.\n", INT32_MAX, IntRange(0, INT32_MAX));
+        IntOption    parse_threads("MAIN", "parse-threads", "Threads for parsing uncompressed input (0=one per 16 MB, up to the number of cores).\n", 0, IntRange(0, 256));
+        StringOption json    ("MAIN", "json",  "Write statistics as JSON lines to this file.");
+        IntOption    json_int("MAIN", "json-interval", "Write JSON statistics every this many conflicts (0=only at the end).\n", 0, IntRange(0, INT32_MAX));
         
         parseOptions(argc, argv, true);
 
@@ -120,6 +151,14 @@ int main(int argc, char** argv) {
         double initial_time = cpuTime();
 
         S.verbosity = verb;
+
+        if (json){
+            json_file = fopen(json, "w");
+            if (json_file == NULL)
+                printf("ERROR! Could not open file: %s\n", (const char*)json), exit(1);
+            S.statsCallback = printJSONSample;
+            S.statsInterval = json_int;
+        }
         
         solver = &S;
         // Use signal handlers that forcibly quit until the solver will be able to respond to
@@ -159,7 +198,8 @@ int main(int argc, char** argv) {
             printf("============================[ Problem Statistics ]=============================\n");
             printf("|                                                                             |\n"); }
         
-        parse_DIMACS(in, S);
+        if (argc == 1 || !parse_DIMACS(argv[1], S, parse_threads))
+            parse_DIMACS(in, S);
         gzclose(in);
         FILE* res = (argc >= 3) ? fopen(argv[2], "wb") : NULL;
         
@@ -184,6 +224,7 @@ int main(int argc, char** argv) {
                 printf("Solved by unit propagation\n");
                 printStats(S);
                 printf("\n"); }
+            printJSON(S, "summary");
             printf("UNSATISFIABLE\n");
             exit(20);
         }
@@ -193,6 +234,7 @@ int main(int argc, char** argv) {
         if (S.verbosity > 0){
             printStats(S);
             printf("\n"); }
+        printJSON(S, "summary");
         printf(ret == l_True ? "SATISFIABLE\n" : ret == l_False ? "UNSATISFIABLE\n" : "INDETERMINATE\n");
         if (res != NULL){
             if (ret == l_True){
@@ -0,0 +1,30 @@
+/*************************************************************************************[ipasir.h]
+The generic incremental reentrant SAT solver API used for instance in the SAT competition (see
+https://github.com/biotomas/ipasir). Literals are non-zero integers as in DIMACS, variables are
+created on first use.
+**************************************************************************************************/
+
+#ifndef ipasir_h
+#define ipasir_h
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+const char* ipasir_signature(void);
+void*       ipasir_init(void);
+void        ipasir_release(void* solver);
+void        ipasir_add(void* solver, int lit_or_zero);
+void        ipasir_assume(void* solver, int lit);
+int         ipasir_solve(void* solver);
+int         ipasir_val(void* solver, int lit);
+int         ipasir_failed(void* solver, int lit);
+void        ipasir_set_terminate(void* solver, void* state, int (*terminate)(void* state));
+void        ipasir_set_learn(void* solver, void* state, int max_length,
+                             void (*learn)(void* state, int* clause));
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
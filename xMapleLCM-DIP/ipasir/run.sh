@@ -0,0 +1,41 @@
+#!/bin/sh
+
+# Runs the IPASIR smoke test (see 'Main.cc') on the incremental ICNF traces of
+# the CaDiCaL tests and checks the exit code, i.e., the result of the last
+# query of each trace.
+#
+#   ipasir/run.sh [ <icnf-binary> ]
+
+dir=`dirname $0`
+icnf=${1:-$dir/icnf_static}
+traces=$dir/../../cadical-dip/test/icnf
+
+[ -x $icnf ] || { echo "run.sh: error: can not find '$icnf'"; exit 1; }
+[ -d $traces ] || { echo "run.sh: error: can not find '$traces'"; exit 1; }
+
+ok=0
+failed=0
+
+run () {
+  $icnf $traces/$1.icnf > /dev/null 2>&1
+  res=$?
+  if [ $res = $2 ]
+  then
+    echo "$1 ... ok (exit code '$res' as expected)"
+    ok=`expr $ok + 1`
+  else
+    echo "$1 ... FAILED (actual exit code $res, expected $2)"
+    failed=`expr $failed + 1`
+  fi
+}
+
+run empty 10
+run false 20
+run unit1 20
+run unit2 10
+run two1 20
+run two2 10
+run prime49 10
+
+echo "IPASIR smoke test: $ok ok, $failed failed"
+exit $failed
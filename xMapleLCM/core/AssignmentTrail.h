@@ -276,8 +276,16 @@ namespace Minisat {
         ///////////////////////////////////////////////////////////////////////////////////////////////
         // UTILITY FUNCTIONS
 
+        /**
+         * @brief Compute the number of distinct non-zero decision levels in a clause
+         * 
+         * @param c the clause
+         * @param first the index of the first literal to consider, e.g. 1 to skip an asserting
+         * literal which is unassigned after backtracking
+         * @return the LBD of the clause
+         */
         template<class V>
-        int computeLBD(const V& c);
+        int computeLBD(const V& c, int first = 0);
 
     private:
         ///////////////////////////////////////////////////////////////////////////////////////////////
@@ -403,10 +411,10 @@ namespace Minisat {
     // UTILITY FUNCTIONS
 
     template <class V>
-    int AssignmentTrail::computeLBD(const V& c) {
+    int AssignmentTrail::computeLBD(const V& c, int first) {
         int lbd = 0;
         lbd_calls++;
-        for (int i = 0; i < c.size(); i++) {
+        for (int i = first; i < c.size(); i++) {
             int l = level(var(c[i]));
             if (l != 0 && lbd_seen[l] != lbd_calls){
                 lbd_seen[l] = lbd_calls;
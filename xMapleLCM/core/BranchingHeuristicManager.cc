@@ -139,12 +139,10 @@ void BranchingHeuristicManager::checkSwitchHeuristic(uint64_t propagations) {
 
 void BranchingHeuristicManager::switchHeuristic(void) {
     VSIDS = !VSIDS;
-    if (VSIDS) {
-        printf("c Switched to VSIDS.\n");
-    } else {
-        printf("c Switched to LRB.\n");
+    if (solver.verbosity >= 1) {
+        printf(VSIDS ? "c Switched to VSIDS.\n" : "c Switched to LRB.\n");
+        fflush(stdout);
     }
-    fflush(stdout);
 
     // Instead of clearing, set vectors to 0
     for (int i = 0; i < assignmentTrail.nVars(); i++) {
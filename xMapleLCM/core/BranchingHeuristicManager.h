@@ -477,9 +477,8 @@ namespace Minisat {
     // STATE MODIFICATION
 
     inline void BranchingHeuristicManager::newVar(Var v, bool sign, bool dvar) {
-        // Decision variables
+        // Decision variables (inserted into the order heaps below, after their activities exist)
         decision.push();
-        setDecisionVar(v, dvar);
         
         // Branching heuristics
         activity_CHB     .push(0);
@@ -495,6 +494,8 @@ namespace Minisat {
 
         // Phase saving
         polarity.push(sign);
+
+        setDecisionVar(v, dvar);
     }
 
     inline void BranchingHeuristicManager::setDecisionVar(Var v, bool b) { 
@@ -32,6 +32,7 @@ static const char* _cat = "CORE";
 
 static DoubleOption opt_garbage_frac (_cat, "gc-frac", "The fraction of wasted memory allowed before a garbage collection is triggered", 0.20, DoubleRange(0, false, HUGE_VAL, false));
 static DoubleOption opt_clause_decay (_cat, "cla-decay", "The clause activity decay factor", 0.999, DoubleRange(0, false, 1, false));
+static BoolOption   opt_gc_layout    (_cat, "gc-layout", "Lay out clauses by tier and recent use on garbage collection", false);
 
 ///////////////////////////////////////////////////////////////////////////////////////////////////
 // CONSTRUCTORS
@@ -46,6 +47,7 @@ ClauseDatabase::ClauseDatabase(Solver& s)
     // Memory management parameters
     , remove_satisfied(true)
     , garbage_frac (opt_garbage_frac)
+    , gc_layout    (opt_gc_layout)
 
     , next_T2_reduce(10000)
     , next_L_reduce (15000)
@@ -88,6 +90,42 @@ void ClauseDatabase::detachClause(CRef cr, bool strict) {
     else            clauses_literals -= c.size();
 }
 
+namespace {
+    struct TouchedGt {
+        ClauseAllocator& ca;
+        TouchedGt(ClauseAllocator& ca_) : ca(ca_) {}
+        bool operator() (CRef x, CRef y) const { return ca[x].touched() > ca[y].touched(); }
+    };
+
+    struct ActivityGt {
+        ClauseAllocator& ca;
+        ActivityGt(ClauseAllocator& ca_) : ca(ca_) {}
+        bool operator() (CRef x, CRef y) const { return ca[x].activity() > ca[y].activity(); }
+    };
+
+    // Copies the clauses without updating the references to them
+    inline void copyClauses(const vec<CRef>& cs, ClauseAllocator& from, ClauseAllocator& to) {
+        for (int i = 0; i < cs.size(); i++) {
+            CRef cr = cs[i];
+            if (from[cr].mark() != 1) from.reloc(cr, to);
+        }
+    }
+}
+
+void ClauseDatabase::layOutClauses(ClauseAllocator& to) {
+    copyClauses(learnts_core, ca, to);
+
+    learnts_tier2.copyTo(gc_order);
+    sort(gc_order, TouchedGt(ca));
+    copyClauses(gc_order, ca, to);
+
+    copyClauses(clauses, ca, to);
+
+    learnts_local.copyTo(gc_order);
+    sort(gc_order, ActivityGt(ca));
+    copyClauses(gc_order, ca, to);
+}
+
 ///////////////////////////////////////////////////////////////////////////////////////////////////
 // OUTPUT
 
@@ -169,6 +207,10 @@ void ClauseDatabase::garbageCollect(void) {
     // is not precise but should avoid some unnecessary reallocations for the new region:
     ClauseAllocator to(ca.size() - ca.wasted()); 
 
+    // Copy the clauses that are used together next to each other, before the references are
+    // relocated in the order of the watchers
+    if (gc_layout) solver.layOutClauses(to);
+
     // Reloc all clause references
     solver.relocAll(to);
 
@@ -178,4 +220,7 @@ void ClauseDatabase::garbageCollect(void) {
     
     // Transfer ownership of memory
     to.moveTo(ca);
+
+    // Visit the watchers in the order of the clauses, i.e., the most used ones first
+    if (gc_layout) unitPropagator.sortWatchers();
 }
@@ -77,6 +77,9 @@ namespace Minisat {
         /// @brief The limit on the total number of clauses to delete during reduceDB()
         int reduceDBLimit;
 
+        /// @brief Used to sort clauses when laying them out during garbage collection
+        vec<CRef> gc_order;
+
     protected:
         ///////////////////////////////////////////////////////////////////////////////////////////
         // PARAMETERS
@@ -88,6 +91,10 @@ namespace Minisat {
         /// @brief The fraction of wasted memory allowed before a garbage collection is triggered.
         double garbage_frac;
 
+        /// @brief Indicates whether garbage collection lays out clauses by tier and recent use,
+        /// and sorts the watchers accordingly.
+        bool gc_layout;
+
         /// @brief Conflict trigger threshold for the next tier2 clause database reduction
         uint64_t next_T2_reduce;
 
@@ -200,6 +207,28 @@ namespace Minisat {
          */
         void removeSatisfied(void);
 
+        /**
+         * @brief Remove learnt clauses which satisfy a predicate, unless they are locked.
+         * 
+         * @param shouldRemoveClause the predicate: takes a Clause as input and returns true iff
+         * the clause should be removed
+         * @return the number of removed clauses
+         */
+        template <class RemoveClausePredicate>
+        int removeLearnts(RemoveClausePredicate shouldRemoveClause);
+
+        /**
+         * @brief Demote learnt clauses which satisfy a predicate, unless they are locked. Core and
+         * tier2 clauses are moved to the local database, and all of them are put first in line for
+         * the next local reduction.
+         * 
+         * @param shouldDemoteClause the predicate: takes a Clause as input and returns true iff
+         * the clause should be demoted
+         * @return the number of demoted clauses
+         */
+        template <class DemoteClausePredicate>
+        int demoteLearnts(DemoteClausePredicate shouldDemoteClause);
+
         /**
          * @brief Reduce the set of learnt clauses
          * 
@@ -221,6 +250,15 @@ namespace Minisat {
          */
         void relocAll(ClauseAllocator& to);
 
+        /**
+         * @brief Copy all clauses to a new ClauseAllocator by tier: core clauses, tier2 clauses
+         * by the time they were last used, original clauses and local clauses by activity.
+         * 
+         * @param to the ClauseAllocator to copy to
+         * @note The references to the clauses are only updated by @code{relocAll}.
+         */
+        void layOutClauses(ClauseAllocator& to);
+
         bool upgradeToCore(CRef cr, int lbd);
 
         /**
@@ -319,8 +357,11 @@ namespace Minisat {
         ///////////////////////////////////////////////////////////////////////////////////////////
         // HELPER FUNCTIONS
 
-        template <class CheckClausePredicate>
-        void removeSatisfied(vec<CRef>& cs, CheckClausePredicate shouldCheckClause);
+        template <class CheckClausePredicate, class RemoveClausePredicate>
+        int removeClauses(vec<CRef>& cs, CheckClausePredicate shouldCheckClause, RemoveClausePredicate shouldRemoveClause);
+
+        template <class CheckClausePredicate, class DemoteClausePredicate>
+        int demoteClauses(vec<CRef>& cs, CheckClausePredicate shouldCheckClause, DemoteClausePredicate shouldDemoteClause);
 
         template <int db_mark>
         void reduceDB(uint64_t conflicts);
@@ -435,13 +476,43 @@ namespace Minisat {
     }
 
     inline void ClauseDatabase::removeSatisfied(void) {
-        removeSatisfied(learnts_core , [](const Clause& c){ return true; });
-        removeSatisfied(learnts_tier2, [](const Clause& c){ return c.mark() == TIER2; });
-        removeSatisfied(learnts_local, [](const Clause& c){ return c.mark() == LOCAL; });
+        auto isSatisfied = [this](const Clause& c){ return assignmentTrail.satisfied(c); };
+        removeClauses(learnts_core , [](const Clause& c){ return true; }, isSatisfied);
+        removeClauses(learnts_tier2, [](const Clause& c){ return c.mark() == TIER2; }, isSatisfied);
+        removeClauses(learnts_local, [](const Clause& c){ return c.mark() == LOCAL; }, isSatisfied);
 
         if (remove_satisfied) // Can be turned off.
-            removeSatisfied(clauses, [](const Clause& c){ return true; });
+            removeClauses(clauses, [](const Clause& c){ return true; }, isSatisfied);
+        checkGarbage();
+    }
+
+    template <class RemoveClausePredicate>
+    inline int ClauseDatabase::removeLearnts(RemoveClausePredicate shouldRemoveClause) {
+        auto isRemovable = [&](const Clause& c){ return !assignmentTrail.locked(c) && shouldRemoveClause(c); };
+        int removed = 0;
+        removed += removeClauses(learnts_core , [](const Clause& c){ return c.mark() == CORE; }, isRemovable);
+        removed += removeClauses(learnts_tier2, [](const Clause& c){ return c.mark() == TIER2; }, isRemovable);
+        removed += removeClauses(learnts_local, [](const Clause& c){ return c.mark() == LOCAL; }, isRemovable);
         checkGarbage();
+        return removed;
+    }
+
+    template <class DemoteClausePredicate>
+    inline int ClauseDatabase::demoteLearnts(DemoteClausePredicate shouldDemoteClause) {
+        auto isDemotable = [&](const Clause& c){ return !assignmentTrail.locked(c) && shouldDemoteClause(c); };
+        int demoted = 0;
+        demoted += demoteClauses(learnts_core , [](const Clause& c){ return c.mark() == CORE; }, isDemotable);
+        demoted += demoteClauses(learnts_tier2, [](const Clause& c){ return c.mark() == TIER2; }, isDemotable);
+
+        // Local clauses stay where they are, but are deleted first during the next reduction
+        for (int i = 0; i < learnts_local.size(); i++) {
+            Clause& c = ca[learnts_local[i]];
+            if (c.mark() != LOCAL || c.activity() == 0 || !isDemotable(c)) continue;
+            c.activity() = 0;
+            c.removable(true);
+            demoted++;
+        }
+        return demoted;
     }
 
     inline void ClauseDatabase::checkReduceDB(uint64_t conflicts) {
@@ -559,20 +630,44 @@ namespace Minisat {
     /////////////////////
     // HELPER FUNCTIONS
 
-    template <class CheckClausePredicate>
-    inline void ClauseDatabase::removeSatisfied(vec<CRef>& cs, CheckClausePredicate shouldCheckClause) {
-        int i, j;
+    template <class CheckClausePredicate, class RemoveClausePredicate>
+    inline int ClauseDatabase::removeClauses(vec<CRef>& cs, CheckClausePredicate shouldCheckClause, RemoveClausePredicate shouldRemoveClause) {
+        int i, j, removed = 0;
         for (i = j = 0; i < cs.size(); i++) {
             Clause& c = ca[cs[i]];
             if (!shouldCheckClause(c)) continue;
 
-            if (assignmentTrail.satisfied(c)) {
+            if (shouldRemoveClause(c)) {
                 removeClause(cs[i]);
+                removed++;
+            } else {
+                cs[j++] = cs[i];
+            }
+        }
+        cs.shrink(i - j);
+        return removed;
+    }
+
+    template <class CheckClausePredicate, class DemoteClausePredicate>
+    inline int ClauseDatabase::demoteClauses(vec<CRef>& cs, CheckClausePredicate shouldCheckClause, DemoteClausePredicate shouldDemoteClause) {
+        int i, j, demoted = 0;
+        for (i = j = 0; i < cs.size(); i++) {
+            Clause& c = ca[cs[i]];
+            if (!shouldCheckClause(c)) continue;
+
+            if (shouldDemoteClause(c)) {
+                // Demote clause to local clause database, behind all other local clauses
+                learnts_local.push(cs[i]);
+                c.mark(LOCAL);
+                c.activity() = 0;
+                c.removable(true);
+                demoted++;
             } else {
                 cs[j++] = cs[i];
             }
         }
         cs.shrink(i - j);
+        return demoted;
     }
 
     ///////////////////////////////
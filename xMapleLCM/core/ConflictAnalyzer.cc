@@ -142,8 +142,9 @@ void ConflictAnalyzer::analyzeFinal(Lit p, vec<Lit>& out_conflict) {
             out_conflict.push(~assignmentTrail[i]);
         } else {
             Clause& c = ca[assignmentTrail.reason(x)];
+            // Binary reasons may hold the implied literal in either position
             for (int j = c.size() == 2 ? 0 : 1; j < c.size(); j++)
-                if (assignmentTrail.level(var(c[j])) > 0)
+                if (var(c[j]) != x && assignmentTrail.level(var(c[j])) > 0)
                     seen[var(c[j])] = 1;
         }
     }
@@ -269,6 +269,14 @@ public:
      */
     virtual void relocAll(ClauseAllocator& to);
 
+    /**
+     * @brief Copy all clauses in the order in which they should be laid out in memory
+     * 
+     * @param to the ClauseAllocator to copy to
+     * @note The references to the clauses are only updated by @code{relocAll}.
+     */
+    virtual void layOutClauses(ClauseAllocator& to);
+
 public:
     ///////////////////////////////////////////////////////////////////////////////////////////////
     // PROBLEM SPECIFICATION
@@ -478,6 +486,10 @@ inline void Solver::relocAll(ClauseAllocator& to) {
     clauseDatabase .relocAll(to);
 }
 
+inline void Solver::layOutClauses(ClauseAllocator& to) {
+    clauseDatabase.layOutClauses(to);
+}
+
 //////////////////////////
 // PROBLEM SPECIFICATION
 
@@ -20,6 +20,8 @@ DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE,
 OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
 **************************************************************************************************/
 
+#include <algorithm>
+
 #include <core/UnitPropagator.h>
 #include <core/Solver.h>
 
@@ -98,6 +100,22 @@ void UnitPropagator::relocAll(ClauseAllocator& to) {
     }
 }
 
+struct WatcherLt {
+    bool operator() (const Watcher& x, const Watcher& y) const { return x.cref < y.cref; }
+};
+
+static inline void sortByClause(vec<Watcher>& ws) {
+    std::sort((Watcher*)ws, (Watcher*)ws + ws.size(), WatcherLt());
+}
+
+void UnitPropagator::sortWatchers(void) {
+    for (int v = 0; v < assignmentTrail.nVars(); v++) {
+        Lit p = mkLit(v);
+        sortByClause(watches[ p]);
+        sortByClause(watches[~p]);
+    }
+}
+
 CRef UnitPropagator::propagate() {
     return genericPropagate<false>();
 }
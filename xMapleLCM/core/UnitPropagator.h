@@ -184,6 +184,12 @@ namespace Minisat {
          */
         void relocAll(ClauseAllocator& to);
 
+        /**
+         * @brief Sort the watchers of non-binary clauses by the position of their clauses in
+         * memory, which are laid out with the most used ones first on garbage collection
+         */
+        void sortWatchers(void);
+
         /**
          * @brief Propagate all enqueued facts.
          * 
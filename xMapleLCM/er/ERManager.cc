@@ -68,6 +68,8 @@ static DoubleOption opt_ext_act_thresh(_ext, "ext-act-thresh", "Activity thresho
 static DoubleOption opt_ext_act_thresh(_ext, "ext-act-thresh", "Activity threshold for extension variable deletion\n", 0.5, DoubleRange(0, false, 1, false));
 #endif
 static IntOption    opt_ext_del_freq(_ext, "ext-del-freq", "Number of conflicts to wait before trying to delete extension variables\n", 10000, IntRange(0, INT32_MAX));
+static IntOption    opt_ext_del_learnts(_ext, "ext-del-learnts", "Learnt clauses containing deleted extension variables (0=keep, 1=demote to local, 2=remove)\n", 2, IntRange(0, 2));
+static BoolOption   opt_ext_lbd     (_ext, "ext-lbd", "Recompute the LBD of learnt clauses after extension variable substitution\n", true);
 
 ///////////////////////////////////////////////////////////////////////////////////////////////////
 // CONSTRUCTORS
@@ -114,12 +116,15 @@ ERManager::ERManager(Solver& s)
     , ext_act_threshold(opt_ext_act_thresh)
 #endif
     , ext_del_freq(opt_ext_del_freq)
+    , ext_del_learnts(opt_ext_del_learnts)
+    , ext_lbd(opt_ext_lbd)
 
     /////////////
     // Statistics
     , total_ext_vars     (0)
     , tried_del_ext_vars (0)
     , deleted_ext_vars   (0)
+    , deleted_ext_learnts(0)
     , max_ext_vars       (0)
     , conflict_extclauses(0)
     , learnt_extclauses  (0)
@@ -291,7 +296,8 @@ void ERManager::introduceExtVars(
     // Add extension definition clauses
     for (const ExtDef& def : *extVarDefBuffer) {
         const Lit x = def.x, a = def.a, b = def.b;
-        assert(var(x) >= originalNumVars && var(x) > var(a) && var(x) > var(b));
+        assert(var(x) > var(a) && var(x) > var(b));
+        extVars[var(x)] = true;
         
         // Update extension level
 #if PRIORITIZE_ER || BUMP_ER
@@ -397,7 +403,7 @@ void ERManager::addExtDefClause(std::vector<CRef>& db, Lit ext_lit, vec<Lit>& ps
 ////////////////////////////////////
 // EXTENSION VARIABLE SUBSTITUTION
 
-void ERManager::substitute(vec<Lit>& clause, SubstitutionPredicate& p) {
+bool ERManager::substitute(vec<Lit>& clause, SubstitutionPredicate& p) {
     extTimerStart();
     vec<Lit>& extLits = tmp_vec; extLits.clear();
 
@@ -427,6 +433,7 @@ void ERManager::substitute(vec<Lit>& clause, SubstitutionPredicate& p) {
 
 EXIT_SUBSTITUTE:;
     extTimerStop(ext_sub_overhead);
+    return extLits.size() > 0;
 }
 
 ////////////////////////////////
@@ -462,6 +469,21 @@ void ERManager::getExtVarsToDelete(
     }
 }
 
+/**
+ * @brief Check whether a clause contains any variables in a set
+ * 
+ * @param c the clause to check
+ * @param vars the set of variables
+ * @return true iff the clause contains at least one variable which is in the set
+ */
+static inline bool containsAnyVar(const Clause& c, const VarSet& vars) {
+    for (int i = 0; i < c.size(); i++)
+        if (vars.find(var(c[i])) != vars.end())
+            return true;
+
+    return false;
+}
+
 void ERManager::deleteExtVars(DeletionPredicateSetup& setup, DeletionPredicate& deletionPredicate) {
     extTimerStart();
 
@@ -475,11 +497,18 @@ void ERManager::deleteExtVars(DeletionPredicateSetup& setup, DeletionPredicate&
     // Exit if there are no variables to delete
     if (varsToDelete.size() == 0) return;
 
-    // Delete learnt clauses containing the extension variable
-    // NOTE: This is optional -- we can let the solver delete these by itself as clause activities decay
-    // extTimerStart();
-    // deleteExtVarsFrom(solver->learnts, varsToDelete); // Delete from learnts
-    // extTimerStop(ext_delC_overhead);
+    // Remove or demote learnt clauses containing the extension variables, since they are not
+    // constrained anymore once their definitions are deleted. Otherwise the solver deletes these
+    // by itself as clause activities decay
+    if (ext_del_learnts != 0) {
+        extTimerStart();
+        auto containsDeleted = [&](const Clause& c){ return containsAnyVar(c, varsToDelete); };
+        if (ext_del_learnts == 1)
+            deleted_ext_learnts += clauseDatabase.demoteLearnts(containsDeleted);
+        else
+            deleted_ext_learnts += clauseDatabase.removeLearnts(containsDeleted);
+        extTimerStop(ext_delC_overhead);
+    }
 
     extTimerStart();
 
@@ -527,6 +556,14 @@ void ERManager::relocAll(ClauseAllocator& to) {
     }
 }
 
+void ERManager::layOutClauses(ClauseAllocator& to) {
+    for (std::tr1::unordered_map< Var, std::vector<CRef> >::iterator it = extDefs.begin(); it != extDefs.end(); it++) {
+        for (CRef cr : it->second) {
+            if (ca[cr].mark() != 1) ca.reloc(cr, to);
+        }
+    }
+}
+
 void ERManager::removeSatisfied() {
     // Iterate through every extension variable
     for (std::tr1::unordered_map< Var, std::vector<CRef> >::iterator it = extDefs.begin(); it != extDefs.end(); it++) {
@@ -584,35 +621,3 @@ CRef ERManager::findAssertingClause(int& i_undef, int& i_max, Lit x, std::vector
     assert(false);
     return CRef_Undef;
 }
-
-/////////////////////////////////////////////////////
-// HELPER FUNCTIONS FOR EXTENSION VARIABLE DELETION
-
-/**
- * @brief Check whether a clause contains any variables in a set
- * 
- * @param c the clause to check
- * @param vars the set of variables
- * @return true iff the clause contains at least one variable which is in the set
- */
-static inline bool containsAnyVar(Clause& c, VarSet& vars) {
-    for (int i = 0; i < c.size(); i++)
-        if (vars.find(var(c[i])) != vars.end())
-            return true;
-
-    return false;
-}
-
-void ERManager::deleteExtVarsFrom(vec<CRef>& db, VarSet& varsToDelete) {
-    int i, j;
-    for (i = j = 0; i < db.size(); i++) {
-        CRef cr = db[i];
-        Clause& c = ca[cr];
-        if (!assignmentTrail.locked(c) && containsAnyVar(c, varsToDelete)) {
-            clauseDatabase.removeClause(cr);
-        } else {
-            db[j++] = db[i];
-        }
-    }
-    db.shrink(i - j);
-}
\ No newline at end of file
@@ -81,9 +81,10 @@ private:
     ///////////////////////////////////////////////////////////////////////////////////////////////
     // MEMBER VARIABLES
 
-    /// @brief The number of variables in the original formula.
-    /// @note This value is used to quickly check whether a variable is an extension variable
-    int originalNumVars;
+    /// @brief Map from variables to whether they were introduced as extension variables
+    /// @note Input variables may be added after extension variables when solving incrementally,
+    /// hence extension variables are not simply those beyond the original number of variables
+    vec<bool> extVars;
 
     /// @brief Map from extension variables to a list of their extension definition clauses.
     std::tr1::unordered_map<Var, std::vector<CRef> > extDefs;
@@ -189,6 +190,13 @@ protected:
     /// @brief Number of conflicts to wait before trying to delete extension variables
     int ext_del_freq;
 
+    /// @brief What to do with learnt clauses containing deleted extension variables: 0 = keep,
+    /// 1 = demote to the local database, 2 = remove (default 2)
+    int ext_del_learnts;
+
+    /// @brief Recompute the LBD of learnt clauses after substitution (default true)
+    bool ext_lbd;
+
     /// @brief Threshold activity for variable deletion
     double m_threshold_activity;
 
@@ -205,6 +213,10 @@ public:
     /// @brief The total number of extension variables which the solver successfully deleted
     mutable uint64_t deleted_ext_vars;
 
+    /// @brief The total number of learnt clauses removed or demoted along with deleted extension
+    /// variables
+    mutable uint64_t deleted_ext_learnts;
+
     /// @brief The maximum number of extension variables present in the solver at any one time
     mutable uint64_t max_ext_vars;
 
@@ -293,12 +305,6 @@ public:
     ///////////////////////////////////////////////////////////////////////////////////////////////
     // STATE MODIFICATION
 
-    /**
-     * @brief Set up data structures when the solver starts
-     * 
-     */
-    inline void init(void);
-
     /**
      * @brief Update data structures to allocate enough memory when a new variable is added
      * 
@@ -313,6 +319,15 @@ public:
      */
     void relocAll(ClauseAllocator& to);
 
+    /**
+     * @brief Copy the extension definition clauses to a new ClauseAllocator, the clauses of
+     * each definition next to each other
+     * 
+     * @param to The ClauseAllocator into which to copy
+     * @note The references to the clauses are only updated by @code{relocAll}.
+     */
+    void layOutClauses(ClauseAllocator& to);
+
     /**
      * @brief Remove extension definition clauses that have already been satisfied
      */
@@ -464,8 +479,9 @@ public:
      * 
      * @param clause The vector of literals in which to substitute
      * @param predicate The condition with which to check the clause
+     * @return true iff at least one extension variable was substituted into the clause
      */
-    void substitute(vec<Lit>& clause, SubstitutionPredicate& p);
+    bool substitute(vec<Lit>& clause, SubstitutionPredicate& p);
 
     /**
      * @brief Check whether the given clause meets some condition and substitute extension
@@ -475,6 +491,15 @@ public:
      */
     void substitute(vec<Lit>& clause);
 
+    /**
+     * @brief Substitute extension variables into a learnt clause after backtracking and update
+     * its LBD accordingly.
+     * 
+     * @param clause The learnt clause, with the asserting literal first
+     * @param lbd The LBD of the clause, counting the conflict level of the asserting literal
+     */
+    void substitute(vec<Lit>& clause, int& lbd);
+
 public:
     ///////////////////////////////////////////////////////////////////////////////////////////////
     // EXTENSION VARIABLE DELETION
@@ -595,14 +620,6 @@ protected:
     ///////////////////////////////////////////////////////////////////////////////////////////////
     // HELPER FUNCTIONS FOR CLAUSE DELETION
 
-    /**
-     * @brief Delete clauses from a learnt clause database if they contain variables that are being deleted
-     * 
-     * @param db the learnt clause database to delete from
-     * @param varsToDelete the set of variables to delete (represented as a set of positive literals)
-     */
-    void deleteExtVarsFrom(vec<CRef>& db, VarSet& varsToDelete);
-
     /**
      * @brief Remove deleted clauses from CRef buffers. 
      * Used in tandem with @code{handleEventClauseDeleted} 
@@ -649,23 +666,20 @@ private:
 ///////////////////////
 // STATE MODIFICATION
 
-inline void ERManager::init(void) {
-    originalNumVars = assignmentTrail.nVars();
-}
-
 inline void ERManager::newVar(Var v) {
     extensionLevel.push(0);
+    extVars.push(false);
 }
 
 //////////////
 // ACCESSORS
 
 inline bool ERManager::isExtVar(Var x) const {
-    return x >= originalNumVars;
+    return extVars[x];
 }
 
 inline bool ERManager::isCurrentExtVar(Var x) const {
-    return x >= originalNumVars && xdm.containsExt(mkLit(x));
+    return extVars[x] && xdm.containsExt(mkLit(x));
 }
 
 // FIXME: need to handle the case where the pair is currently queued for variable introduction in
@@ -782,6 +796,23 @@ inline void ERManager::substitute(vec<Lit>& clause) {
 #endif
 }
 
+/**
+ * @brief Substitute extension variables into a learnt clause after backtracking and update its
+ * LBD accordingly.
+ * 
+ * @param clause The learnt clause, with the asserting literal first
+ * @param lbd The LBD of the clause, counting the conflict level of the asserting literal
+ */
+inline void ERManager::substitute(vec<Lit>& clause, int& lbd) {
+#if ER_USER_SUBSTITUTE_HEURISTIC != ER_SUBSTITUTE_HEURISTIC_NONE
+    // The asserting literal is unassigned after backtracking and keeps counting as the conflict
+    // level. Substituted extension literals are propagated at the backtrack level at the latest,
+    // hence the LBD can only decrease
+    if (substitute(clause, user_extSubPredicate) && ext_lbd)
+        lbd = assignmentTrail.computeLBD(clause, 1) + 1;
+#endif
+}
+
 ////////////////////////////////
 // EXTENSION VARIABLE DELETION
 
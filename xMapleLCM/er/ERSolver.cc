@@ -30,6 +30,12 @@ using namespace Minisat;
 ERSolver::ERSolver()
     : Solver()
     , erManager(*this)
+    , statsCallback(NULL)
+    , statsInterval(0)
+    , terminateCallback(NULL)
+    , terminateState(NULL)
+    , learnCallback(NULL)
+    , learnState(NULL)
 {}
 
 ///////////////////////////////////////////////////////////////////////////////////////////////////
@@ -68,6 +74,8 @@ lbool ERSolver::search(int& nof_conflicts) {
         if (confl != CRef_Undef) {
             // CONFLICT
             conflicts++;
+            if (statsCallback && statsInterval && conflicts % statsInterval == 0) statsCallback(*this);
+            if (terminateCallback && terminateCallback(terminateState)) interrupt();
             if (assignmentTrail.decisionLevel() == 0) return l_False;
 
             clauseDatabase.handleEventConflicted(conflicts);
@@ -79,7 +87,7 @@ lbool ERSolver::search(int& nof_conflicts) {
 
             // EXTENDED RESOLUTION - substitute disjunctions with extension variables. This must be
             // called after backtracking because extension variables might need to be propagated.
-            erManager.substitute(learnt_clause);
+            erManager.substitute(learnt_clause, lbd);
 
             lbd--;
             restartHeuristicManager.handleEventLearntClause(lbd);
@@ -109,6 +117,7 @@ lbool ERSolver::search(int& nof_conflicts) {
 
             // Output to proof file
             proofLogger.addClause(learnt_clause);
+            if (learnCallback) learnCallback(learnState, learnt_clause);
         } else {
             // NO CONFLICT
             if (restartHeuristicManager.shouldRestart() || !withinBudget()) {
@@ -130,15 +139,34 @@ lbool ERSolver::search(int& nof_conflicts) {
             // Reduce the set of learnt clauses:
             clauseDatabase.checkReduceDB(conflicts);
 
-            // New variable decision:
-            Lit next = branchingHeuristicManager.pickBranchLit();
-            if (next == lit_Undef)
-                // Model found:
-                return l_True;
+            Lit next = lit_Undef;
+            while (assignmentTrail.decisionLevel() < assumptions.size()) {
+                // Perform user provided assumption:
+                Lit p = assumptions[assignmentTrail.decisionLevel()];
+                if (assignmentTrail.value(p) == l_True) {
+                    // Dummy decision level:
+                    assignmentTrail.newDecisionLevel();
+                } else if (assignmentTrail.value(p) == l_False) {
+                    conflictAnalyzer.analyzeFinal(~p, conflict);
+                    return l_False;
+                } else {
+                    next = p;
+                    break;
+                }
+            }
+
+            if (next == lit_Undef) {
+                // New variable decision:
+                next = branchingHeuristicManager.pickBranchLit();
 
-            // Update stats
-            if (erManager.isExtVar(var(next)))
-                erManager.branchOnExt++;
+                if (next == lit_Undef)
+                    // Model found:
+                    return l_True;
+
+                // Update stats
+                if (erManager.isExtVar(var(next)))
+                    erManager.branchOnExt++;
+            }
 
             // Increase decision level and enqueue 'next'
             assignmentTrail.newDecisionLevel();
@@ -155,8 +183,9 @@ lbool ERSolver::solve_() {
 
     solves++;
 
-    // Initialize solver components
-    erManager.init();
+    // The previous call may have ended with another heuristic active, whose heap then received
+    // the variables unassigned on the final backtrack
+    branchingHeuristicManager.rebuildPriorityQueue();
 
     lbool status = l_Undef;
 
@@ -191,9 +220,10 @@ lbool ERSolver::solve_() {
     if (status == l_False) proofLogger.flush();
 
     if (status == l_True) {
-        // Extend & copy model:
+        // Extend & copy model (extension variables are left undefined):
         model.growTo(assignmentTrail.nVars());
-        for (int i = 0; i < assignmentTrail.nVars(); i++) model[i] = assignmentTrail.value(i);
+        for (int i = 0; i < assignmentTrail.nVars(); i++)
+            model[i] = erManager.isExtVar(i) ? l_Undef : assignmentTrail.value(i);
     } else if (status == l_False && conflict.size() == 0) {
         ok = false;
     }
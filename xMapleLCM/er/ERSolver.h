@@ -31,6 +31,10 @@ namespace Minisat {
     /**
      * @brief This class augments the base solver with extended resolution capabilities.
      * 
+     * The solver can be used incrementally: variables and clauses may be added between calls to
+     * @code{solve}, each under its own assumptions. Extension variables, their definitions and the
+     * clauses learnt over them are kept across calls. Extension variables are left undefined in
+     * @code{model} and never occur in @code{conflict}, which only contains negated assumptions.
      */
     class ERSolver : public Solver {
     public:
@@ -40,6 +44,21 @@ namespace Minisat {
         /// @brief The extended resolution component
         ERManager erManager;
 
+        /// @brief Called every 'statsInterval' conflicts during search if both are set (used in
+        /// Main.cc to write time-series statistics)
+        void (*statsCallback)(ERSolver&);
+        uint64_t statsInterval;
+
+        /// @brief Polled on every conflict during search if set, which is interrupted once it
+        /// returns non-zero (used by 'ipasir_set_terminate')
+        int (*terminateCallback)(void*);
+        void* terminateState;
+
+        /// @brief Called with every learnt clause if set, which may contain extension variables
+        /// (used by 'ipasir_set_learn')
+        void (*learnCallback)(void*, const vec<Lit>&);
+        void* learnState;
+
     public:
         ///////////////////////////////////////////////////////////////////////////////////////////
         // CONSTRUCTORS
@@ -67,6 +86,14 @@ namespace Minisat {
          */
         virtual void relocAll(ClauseAllocator& to);
 
+        /**
+         * @brief Copy all clauses in the order in which they should be laid out in memory,
+         * starting with the extension definition clauses
+         * 
+         * @param to the ClauseAllocator to copy to
+         */
+        virtual void layOutClauses(ClauseAllocator& to);
+
     public:
         ///////////////////////////////////////////////////////////////////////////////////////////
         // PROBLEM SPECIFICATION
@@ -128,6 +155,11 @@ namespace Minisat {
         erManager.relocAll(to);
     }
 
+    inline void ERSolver::layOutClauses(ClauseAllocator& to) {
+        erManager.layOutClauses(to);
+        Solver::layOutClauses(to);
+    }
+
     //////////////////////////
     // PROBLEM SPECIFICATION
 
@@ -366,8 +366,9 @@ void ERManager::user_extDelPredicateSetup_activity() {
 #elif ER_USER_DELETE_HEURISTIC == ER_DELETE_HEURISTIC_ACTIVITY2
     // Copy activities for current variables
     const vec<double>& activity = solver.branchingHeuristicManager.getActivity();
-    vec<double> currentActivity(originalNumVars);
-    for (int i = 0; i < originalNumVars; i++) currentActivity.push(activity[i]);
+    vec<double> currentActivity;
+    for (int i = 0; i < assignmentTrail.nVars(); i++)
+        if (!extVars[i]) currentActivity.push(activity[i]);
     for (auto it = extDefs.begin(); it != extDefs.end(); it++) currentActivity.push(activity[it->first]);
     
     // Compute threshold activity
@@ -52,6 +52,7 @@ void printStats(ERSolver& solver) {
     printf("total ext vars        : %-12" PRIu64 "\n", erm.total_ext_vars);
     printf("tried delete ext vars : %-12" PRIu64 "\n", erm.tried_del_ext_vars);
     printf("deleted ext vars      : %-12" PRIu64 "\n", erm.deleted_ext_vars);
+    printf("deleted ext learnts   : %-12" PRIu64 "\n", erm.deleted_ext_learnts);
     printf("max ext vars          : %-12" PRIu64 "\n", erm.max_ext_vars);
     printf("conflict ext clauses  : %-12" PRIu64 "   (%.0f /sec)\n", erm.conflict_extclauses, erm.conflict_extclauses / cpu_time);
     printf("learnt ext clauses    : %-12" PRIu64 "   (%.0f /sec)\n", erm.learnt_extclauses, erm.learnt_extclauses / cpu_time);
@@ -71,6 +72,30 @@ void printStats(ERSolver& solver) {
 }
 
 
+// Machine readable statistics: a JSON object on a single line, written every 'json-interval'
+// conflicts as 'sample' and at the end as 'summary'.
+static FILE* json_file = NULL;
+
+static void printJSON(ERSolver& solver, const char* type) {
+    if (json_file == NULL) return;
+    const ERManager& erm = solver.erManager;
+    ClauseDatabase& db = solver.clauseDatabase;
+    fprintf(json_file, "{\"type\":\"%s\",\"cpu_time\":%.3f", type, cpuTime());
+    fprintf(json_file, ",\"rss_mb\":%.2f,\"max_rss_mb\":%.2f", memUsed(), memUsedPeak());
+    fprintf(json_file, ",\"conflicts\":%" PRIu64 ",\"decisions\":%" PRIu64 ",\"propagations\":%" PRIu64 ",\"restarts\":%" PRIu64,
+            solver.conflicts, solver.branchingHeuristicManager.decisions, solver.unitPropagator.propagations, solver.starts);
+    fprintf(json_file, ",\"clauses\":{\"irredundant\":%d,\"redundant\":%d,\"core\":%d,\"tier2\":%d,\"local\":%d}",
+            db.nClauses(), db.nLearnts(), db.getDB<CORE>().size(), db.getDB<TIER2>().size(), db.getDB<LOCAL>().size());
+    fprintf(json_file, ",\"ext_vars\":{\"total\":%" PRIu64 ",\"live\":%" PRIu64 ",\"deleted\":%" PRIu64 ",\"max\":%" PRIu64 ",\"decisions\":%" PRIu64 "}",
+            erm.total_ext_vars, erm.total_ext_vars - erm.deleted_ext_vars, erm.deleted_ext_vars, erm.max_ext_vars, erm.branchOnExt);
+    fprintf(json_file, ",\"timers\":{\"er_sel\":%.3f,\"er_add\":%.3f,\"er_delC\":%.3f,\"er_delV\":%.3f,\"er_sub\":%.3f,\"er_stat\":%.3f}}\n",
+            erm.extTimerRead(0), erm.extTimerRead(1), erm.extTimerRead(2), erm.extTimerRead(3), erm.extTimerRead(4), erm.extTimerRead(5));
+    fflush(json_file);
+}
+
+static void printJSONSample(ERSolver& solver) { printJSON(solver, "sample"); }
+
+
 static ERSolver* solver;
 // Terminate by notifying the solver and back out gracefully. This is mainly to have a test-case
 // for this feature of the Solver as it may take longer than an immediate call to '_exit()'.
@@ -84,6 +109,7 @@ static void SIGINT_exit(int signum) {
     if (solver->verbosity > 0){
         printStats(*solver);
         printf("\n"); printf("*** INTERRUPTED ***\n"); }
+    printJSON(*solver, "summary");
     _exit(1); }
 
 
@@ -106,6 +132,9 @@ int main(int argc, char** argv) {
         IntOption    verb   ("MAIN", "verb",   "Verbosity level (0=silent, 1=some, 2=more).", 1, IntRange(0, 2));
         IntOption    cpu_lim("MAIN", "cpu-lim","Limit on CPU time allowed in seconds.\n", INT32_MAX, IntRange(0, INT32_MAX));
         IntOption    mem_lim("MAIN", "mem-lim","Limit on memory usage in megabytes.\n", INT32_MAX, IntRange(0, INT32_MAX));
+        IntOption    parse_threads("MAIN", "parse-threads", "Threads for parsing uncompressed input (0=one per 16 MB, up to the number of cores).\n", 0, IntRange(0, 256));
+        StringOption json    ("MAIN", "json",  "Write statistics as JSON lines to this file.");
+        IntOption    json_int("MAIN", "json-interval", "Write JSON statistics every this many conflicts (0=only at the end).\n", 0, IntRange(0, INT32_MAX));
         
         parseOptions(argc, argv, true);
 
@@ -113,6 +142,14 @@ int main(int argc, char** argv) {
         double initial_time = cpuTime();
 
         S.verbosity = verb;
+
+        if (json){
+            json_file = fopen(json, "w");
+            if (json_file == NULL)
+                printf("ERROR! Could not open file: %s\n", (const char*)json), exit(1);
+            S.statsCallback = printJSONSample;
+            S.statsInterval = json_int;
+        }
         
         solver = &S;
         // Use signal handlers that forcibly quit until the solver will be able to respond to
@@ -152,7 +189,8 @@ int main(int argc, char** argv) {
             printf("============================[ Problem Statistics ]=============================\n");
             printf("|                                                                             |\n"); }
         
-        parse_DIMACS(in, S);
+        if (argc == 1 || !parse_DIMACS(argv[1], S, parse_threads))
+            parse_DIMACS(in, S);
         gzclose(in);
         FILE* res = (argc >= 3) ? fopen(argv[2], "wb") : NULL;
         
@@ -177,6 +215,7 @@ int main(int argc, char** argv) {
                 printf("Solved by unit propagation\n");
                 printStats(S);
                 printf("\n"); }
+            printJSON(S, "summary");
             printf("UNSATISFIABLE\n");
             exit(20);
         }
@@ -186,6 +225,7 @@ int main(int argc, char** argv) {
         if (S.verbosity > 0){
             printStats(S);
             printf("\n"); }
+        printJSON(S, "summary");
         printf(ret == l_True ? "SATISFIABLE\n" : ret == l_False ? "UNSATISFIABLE\n" : "INDETERMINATE\n");
         if (res != NULL){
             if (ret == l_True){
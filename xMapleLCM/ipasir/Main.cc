@@ -0,0 +1,143 @@
+/*************************************************************************************[Main.cc]
+Smoke test of the IPASIR interface: runs an incremental trace in the ICNF format of the CaDiCaL
+tests ('cadical-dip/test/icnf'), i.e., a 'p inccnf' header followed by clauses and by queries
+'a <assumptions> 0', each of which is solved under the given assumptions. If the trace has no
+query, the clauses are solved once at the end.
+
+Every model is checked against the clauses and assumptions, and every set of failed assumptions
+is checked to be unsatisfiable together with the clauses on a fresh solver. Exported learnt
+clauses may only contain variables of the trace. The exit code is the result of the last query
+(10 or 20) as for CaDiCaL, or 1 if a check failed.
+**************************************************************************************************/
+
+#include <stdlib.h>
+#include <stdio.h>
+#include <vector>
+
+#include "ipasir/ipasir.h"
+#include "utils/ParseUtils.h"
+
+using namespace Minisat;
+
+typedef std::vector<int> Clause;
+
+static std::vector<Clause> clauses;
+static int maxVar = 0;
+
+static int terminateCalls = 0;
+static int learntClauses = 0;
+static bool learntOk = true;
+
+static int countTerminate(void*) {
+    terminateCalls++;
+    return 0;
+}
+
+static void checkLearnt(void*, int* clause) {
+    learntClauses++;
+    for (int* p = clause; *p; p++)
+        if (abs(*p) > maxVar) learntOk = false;
+}
+
+static void error(const char* msg, int query) {
+    printf("c ERROR! %s in query %d\n", msg, query);
+    exit(1);
+}
+
+// Returns true iff the clauses are unsatisfiable under the given assumptions on a fresh solver
+static bool unsatisfiable(const Clause& assumptions) {
+    void* solver = ipasir_init();
+    for (const Clause& c : clauses) {
+        for (int lit : c) ipasir_add(solver, lit);
+        ipasir_add(solver, 0);
+    }
+    for (int lit : assumptions) ipasir_assume(solver, lit);
+    const int res = ipasir_solve(solver);
+    ipasir_release(solver);
+    return res == 20;
+}
+
+static int query(void* solver, const Clause& assumptions, int n) {
+    for (int lit : assumptions) ipasir_assume(solver, lit);
+    const int res = ipasir_solve(solver);
+
+    if (res == 10) {
+        printf("s SATISFIABLE\n");
+        for (const Clause& c : clauses) {
+            bool sat = false;
+            for (int lit : c)
+                if (ipasir_val(solver, lit) == lit) sat = true;
+            if (!sat) error("clause falsified by model", n);
+        }
+        for (int lit : assumptions)
+            if (ipasir_val(solver, lit) != lit) error("assumption falsified by model", n);
+    } else if (res == 20) {
+        printf("s UNSATISFIABLE\n");
+        Clause failed;
+        for (int lit : assumptions)
+            if (ipasir_failed(solver, lit)) failed.push_back(lit);
+        if (!unsatisfiable(failed)) error("failed assumptions satisfiable", n);
+    } else {
+        error("unexpected result", n);
+    }
+
+    return res;
+}
+
+int main(int argc, char** argv) {
+    if (argc != 2) {
+        fprintf(stderr, "usage: %s <input.icnf>\n", argv[0]);
+        return 1;
+    }
+
+    gzFile in = gzopen(argv[1], "rb");
+    if (in == NULL)
+        printf("c ERROR! Could not open file: %s\n", argv[1]), exit(1);
+
+    printf("c %s\n", ipasir_signature());
+
+    void* solver = ipasir_init();
+    ipasir_set_terminate(solver, NULL, countTerminate);
+    ipasir_set_learn(solver, NULL, 8, checkLearnt);
+
+    StreamBuffer buf(in);
+    int queries = 0, res = 0;
+    for (;;) {
+        skipWhitespace(buf);
+        if (isEof(buf)) break;
+
+        if (*buf == 'p') {
+            if (!eagerMatch(buf, "p inccnf"))
+                printf("c PARSE ERROR! Expected 'p inccnf'\n"), exit(1);
+        } else if (*buf == 'c') {
+            skipLine(buf);
+        } else if (*buf == 'a') {
+            ++buf;
+            Clause assumptions;
+            for (int lit; (lit = parseInt(buf)); ) {
+                assumptions.push_back(lit);
+                if (abs(lit) > maxVar) maxVar = abs(lit);
+            }
+            res = query(solver, assumptions, queries++);
+        } else {
+            Clause c;
+            for (int lit; (lit = parseInt(buf)); ) {
+                c.push_back(lit);
+                if (abs(lit) > maxVar) maxVar = abs(lit);
+                ipasir_add(solver, lit);
+            }
+            ipasir_add(solver, 0);
+            clauses.push_back(c);
+        }
+    }
+    gzclose(in);
+
+    if (queries == 0) res = query(solver, Clause(), queries++);
+
+    printf("c %d queries, %d learnt clauses exported, %d termination checks\n",
+        queries, learntClauses, terminateCalls);
+    if (!learntOk) error("learnt clause over unknown variable exported", queries - 1);
+
+    ipasir_release(solver);
+    return res;
+}
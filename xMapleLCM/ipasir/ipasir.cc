@@ -0,0 +1,165 @@
+/***********************************************************************************[ipasir.cc]
+IPASIR interface of xMapleLCM, implemented on top of ERSolver. Build the library with
+'make libxmaplelcm' in the top-level directory.
+**************************************************************************************************/
+
+#include "ipasir/ipasir.h"
+#include "er/ERSolver.h"
+
+using namespace Minisat;
+
+namespace {
+    /**
+     * @brief An ERSolver together with the mapping between IPASIR and solver variables. The
+     * solver introduces extension variables between the variables of the user, which therefore
+     * can not be used as solver variables directly.
+     */
+    struct IpasirSolver {
+        ERSolver solver;
+
+        /// @brief The solver variable of user variable 'i' at index 'i - 1'
+        vec<Var> solverVars;
+
+        /// @brief The user variable of each solver variable (0 for extension variables)
+        vec<int> userVars;
+
+        /// @brief The clause being added and the assumptions for the next call to solve
+        vec<Lit> clause;
+        vec<Lit> assumptions;
+
+        /// @brief Marks the (solver) literals of the failed assumptions of the last call to solve
+        vec<char> failed;
+
+        /// @brief The learn callback of the user, its state, the maximum length of the clauses to
+        /// export and the buffer they are exported in
+        void (*learn)(void*, int*);
+        void* learnState;
+        int maxLength;
+        vec<int> learnt;
+
+        IpasirSolver()
+            : learn(NULL)
+            , learnState(NULL)
+            , maxLength(0)
+        {}
+
+        // Returns the solver literal of 'lit', creating the solver variables on first use
+        Lit importLit(int lit) {
+            const int x = abs(lit);
+            while (solverVars.size() < x) {
+                Var v = solver.newVar();
+                solverVars.push(v);
+                userVars.growTo(v + 1, 0);
+                userVars[v] = solverVars.size();
+            }
+            return mkLit(solverVars[x - 1], lit < 0);
+        }
+
+        // Returns the user literal of 'p', or 0 if 'p' is over an extension variable
+        int exportLit(Lit p) const {
+            const Var v = var(p);
+            if (v >= userVars.size() || userVars[v] == 0) return 0;
+            return sign(p) ? -userVars[v] : userVars[v];
+        }
+
+        // Returns true iff 'lit' was added or assumed before
+        bool known(int lit) const {
+            return abs(lit) <= solverVars.size();
+        }
+    };
+
+    // ERSolver::learnCallback of solvers with a learn callback of the user
+    void exportLearnt(void* state, const vec<Lit>& c) {
+        IpasirSolver& s = *static_cast<IpasirSolver*>(state);
+        if (c.size() > s.maxLength) return;
+
+        s.learnt.clear();
+        for (int i = 0; i < c.size(); i++) {
+            const int lit = s.exportLit(c[i]);
+
+            // Clauses over extension variables are meaningless to the user
+            if (lit == 0) return;
+            s.learnt.push(lit);
+        }
+        s.learnt.push(0);
+        s.learn(s.learnState, s.learnt);
+    }
+}
+
+extern "C" {
+
+const char* ipasir_signature() { return "xMapleLCM"; }
+
+void* ipasir_init() { return new IpasirSolver(); }
+
+void ipasir_release(void* solver) { delete static_cast<IpasirSolver*>(solver); }
+
+void ipasir_add(void* solver, int lit) {
+    IpasirSolver& s = *static_cast<IpasirSolver*>(solver);
+    if (lit) {
+        s.clause.push(s.importLit(lit));
+    } else {
+        s.solver.addClause(s.clause);
+        s.clause.clear();
+    }
+}
+
+void ipasir_assume(void* solver, int lit) {
+    IpasirSolver& s = *static_cast<IpasirSolver*>(solver);
+    s.assumptions.push(s.importLit(lit));
+}
+
+int ipasir_solve(void* solver) {
+    IpasirSolver& s = *static_cast<IpasirSolver*>(solver);
+
+    // A terminated call leaves the solver interrupted
+    s.solver.clearInterrupt();
+    lbool res = s.solver.solveLimited(s.assumptions);
+    s.assumptions.clear();
+
+    s.failed.clear();
+    if (res == l_False) {
+        s.failed.growTo(2 * s.solver.assignmentTrail.nVars(), 0);
+        for (int i = 0; i < s.solver.conflict.size(); i++)
+            s.failed[toInt(~s.solver.conflict[i])] = 1;
+    }
+
+    return res == l_True ? 10 : res == l_False ? 20 : 0;
+}
+
+int ipasir_val(void* solver, int lit) {
+    IpasirSolver& s = *static_cast<IpasirSolver*>(solver);
+    if (!s.known(lit)) return 0;
+
+    const Var v = s.solverVars[abs(lit) - 1];
+    if (v >= s.solver.model.size()) return 0;
+
+    const lbool value = s.solver.model[v];
+    return value == l_Undef ? 0 : (value == l_True) == (lit > 0) ? lit : -lit;
+}
+
+int ipasir_failed(void* solver, int lit) {
+    IpasirSolver& s = *static_cast<IpasirSolver*>(solver);
+    if (!s.known(lit)) return 0;
+
+    const Lit p = mkLit(s.solverVars[abs(lit) - 1], lit < 0);
+    return toInt(p) < s.failed.size() && s.failed[toInt(p)];
+}
+
+void ipasir_set_terminate(void* solver, void* state, int (*terminate)(void* state)) {
+    IpasirSolver& s = *static_cast<IpasirSolver*>(solver);
+    s.solver.terminateCallback = terminate;
+    s.solver.terminateState = state;
+}
+
+void ipasir_set_learn(void* solver, void* state, int max_length,
+                      void (*learn)(void* state, int* clause)) {
+    IpasirSolver& s = *static_cast<IpasirSolver*>(solver);
+    s.learn = learn;
+    s.learnState = state;
+    s.maxLength = max_length;
+    s.solver.learnCallback = learn ? exportLearnt : NULL;
+    s.solver.learnState = &s;
+}
+
+}
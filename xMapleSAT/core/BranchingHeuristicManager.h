@@ -560,9 +560,8 @@ namespace Minisat {
     // STATE MODIFICATION
 
     inline void BranchingHeuristicManager::newVar(Var v, bool sign, bool dvar) {
-        // Decision variables
+        // Decision variables (inserted into the order heap below, after their activities exist)
         decision.push();
-        setDecisionVar(v, dvar);
         
         // VSIDS
         activity.push(rnd_init_act ? randomNumberGenerator.drand() * 0.00001 : 0);
@@ -599,6 +598,8 @@ namespace Minisat {
         total_actual_rewards.push(0);
         total_actual_count.push(0);
     #endif
+
+        setDecisionVar(v, dvar);
     }
 
     inline void BranchingHeuristicManager::setDecisionVar(Var v, bool b) { 
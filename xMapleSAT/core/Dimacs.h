@@ -25,6 +25,10 @@ OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWA
 
 #include <stdio.h>
 
+#include <algorithm>
+#include <thread>
+#include <vector>
+
 #include "utils/ParseUtils.h"
 #include "core/SolverTypes.h"
 
@@ -105,6 +109,127 @@ static void parse_DIMACS(gzFile input_stream, Solver& S) {
     StreamBuffer in(input_stream);
     parse_DIMACS_main(in, S); }
 
+//=================================================================================================
+// Parallel DIMACS Parser for uncompressed files:
+//
+// The mapped file is split at line starts into one chunk per thread.  Every thread parses its chunk
+// into a flat buffer of literals in which each clause is terminated by '0'.  A clause may span
+// several lines and hence chunks, but the buffers concatenated in order are exactly the literals of
+// the file.  The clauses are then added by the calling thread in a single pass over the buffers.
+
+struct DimacsChunk {
+    const char*      begin;
+    const char*      end;
+    std::vector<int> lits;
+    int              max_var;
+    int              clauses;
+    int              header_vars;    // -1 if the chunk does not contain the 'p cnf' line
+    int              header_clauses;
+
+    DimacsChunk(const char* b, const char* e)
+        : begin(b), end(e), max_var(0), clauses(0), header_vars(-1), header_clauses(0) {}
+};
+
+static void parse_DIMACS_chunk(DimacsChunk* chunk) {
+    CharRange in(chunk->begin, chunk->end);
+    for (;;){
+        skipWhitespace(in);
+        if (*in == EOF) break;
+        else if (*in == 'p'){
+            if (eagerMatch(in, "p cnf")){
+                chunk->header_vars    = parseInt(in);
+                chunk->header_clauses = parseInt(in);
+            }else{
+                printf("PARSE ERROR! Unexpected char: %c\n", *in), exit(3);
+            }
+        } else if (*in == 'c')
+            skipLine(in);
+        else{
+            int parsed_lit = parseInt(in);
+            chunk->lits.push_back(parsed_lit);
+            if (parsed_lit == 0)
+                chunk->clauses++;
+            else if (abs(parsed_lit) > chunk->max_var)
+                chunk->max_var = abs(parsed_lit);
+        }
+    }
+}
+
+// Inserts problem into solver.  Returns false without touching the solver if 'path' can not be
+// memory mapped, e.g., because it is compressed, in which case the 'gzFile' version has to be used.
+// If 'threads' is zero, one thread per 16 MB of input is used, bounded by the number of cores.
+//
+template<class Solver>
+static bool parse_DIMACS(const char* path, Solver& S, int threads = 0) {
+#if PRIORITIZE_ER
+    // Extension levels given as comments are only read by the sequential parser.
+    return false;
+#endif
+    MappedFile file(path);
+    if (!file.mapped()) return false;
+
+    const char*  data = file.data();
+    const size_t size = file.size();
+    if (threads <= 0){
+        size_t cores = std::max(1u, std::thread::hardware_concurrency());
+        threads = (int)std::min(cores, size / (16 << 20) + 1); }
+
+    std::vector<DimacsChunk> chunks;
+    const char* begin = data;
+    for (int i = 1; i <= threads; i++){
+        const char* end = std::max(begin, data + size / threads * i);
+        if (i == threads) end = data + size;
+        while (end < data + size && end > data && end[-1] != '\n') end++;
+        chunks.push_back(DimacsChunk(begin, end));
+        begin = end; }
+
+    if (chunks.size() == 1)
+        parse_DIMACS_chunk(&chunks[0]);
+    else{
+        std::vector<std::thread> workers;
+        for (size_t i = 0; i < chunks.size(); i++)
+            workers.push_back(std::thread(parse_DIMACS_chunk, &chunks[i]));
+        for (size_t i = 0; i < workers.size(); i++)
+            workers[i].join(); }
+
+    int vars    = 0;
+    int clauses = 0;
+    int cnt     = 0;
+    int max_var = 0;
+    int last    = 0;
+    for (size_t i = 0; i < chunks.size(); i++){
+        const DimacsChunk& chunk = chunks[i];
+        if (chunk.header_vars >= 0){
+            vars    = chunk.header_vars;
+            clauses = chunk.header_clauses; }
+        cnt    += chunk.clauses;
+        max_var = std::max(max_var, chunk.max_var);
+        if (!chunk.lits.empty()) last = chunk.lits.back(); }
+    if (last != 0)
+        printf("PARSE ERROR! Unexpected end of file in last clause\n"), exit(3);
+
+    while (max_var > S.assignmentTrail.nVars()) S.newVar();
+
+    vec<Lit> lits;
+    for (size_t i = 0; i < chunks.size(); i++){
+        std::vector<int>& buffer = chunks[i].lits;
+        for (size_t j = 0; j < buffer.size(); j++){
+            int parsed_lit = buffer[j];
+            if (parsed_lit == 0){
+                S.addClause(lits);
+                lits.clear();
+            }else{
+                int var = abs(parsed_lit)-1;
+                lits.push( (parsed_lit > 0) ? mkLit(var) : ~mkLit(var) ); } }
+        std::vector<int>().swap(buffer); }
+
+    if (vars != S.assignmentTrail.nVars())
+        fprintf(stderr, "WARNING! DIMACS header mismatch: wrong number of variables.\n");
+    if (cnt  != clauses)
+        fprintf(stderr, "WARNING! DIMACS header mismatch: wrong number of clauses.\n");
+    return true;
+}
+
 //=================================================================================================
 }
 
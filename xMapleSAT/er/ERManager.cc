@@ -291,7 +291,8 @@ void ERManager::introduceExtVars(
     // Add extension definition clauses
     for (const ExtDef& def : *extVarDefBuffer) {
         const Lit x = def.x, a = def.a, b = def.b;
-        assert(var(x) >= originalNumVars && var(x) > var(a) && var(x) > var(b));
+        assert(var(x) > var(a) && var(x) > var(b));
+        extVars[var(x)] = true;
         
         // Update extension level
 #if PRIORITIZE_ER || BUMP_ER
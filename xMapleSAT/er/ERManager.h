@@ -81,9 +81,10 @@ private:
     ///////////////////////////////////////////////////////////////////////////////////////////////
     // MEMBER VARIABLES
 
-    /// @brief The number of variables in the original formula.
-    /// @note This value is used to quickly check whether a variable is an extension variable
-    int originalNumVars;
+    /// @brief Map from variables to whether they were introduced as extension variables
+    /// @note Input variables may be added after extension variables when solving incrementally,
+    /// hence extension variables are not simply those beyond the original number of variables
+    vec<bool> extVars;
 
     /// @brief Map from extension variables to a list of their extension definition clauses.
     std::tr1::unordered_map<Var, std::vector<CRef> > extDefs;
@@ -293,12 +294,6 @@ public:
     ///////////////////////////////////////////////////////////////////////////////////////////////
     // STATE MODIFICATION
 
-    /**
-     * @brief Set up data structures when the solver starts
-     * 
-     */
-    inline void init(void);
-
     /**
      * @brief Update data structures to allocate enough memory when a new variable is added
      * 
@@ -649,23 +644,20 @@ private:
 ///////////////////////
 // STATE MODIFICATION
 
-inline void ERManager::init(void) {
-    originalNumVars = assignmentTrail.nVars();
-}
-
 inline void ERManager::newVar(Var v) {
     extensionLevel.push(0);
+    extVars.push(false);
 }
 
 //////////////
 // ACCESSORS
 
 inline bool ERManager::isExtVar(Var x) const {
-    return x >= originalNumVars;
+    return extVars[x];
 }
 
 inline bool ERManager::isCurrentExtVar(Var x) const {
-    return x >= originalNumVars && xdm.containsExt(mkLit(x));
+    return extVars[x] && xdm.containsExt(mkLit(x));
 }
 
 // FIXME: need to handle the case where the pair is currently queued for variable introduction in
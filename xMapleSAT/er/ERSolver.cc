@@ -193,7 +193,6 @@ lbool ERSolver::solve_() {
 
     // Initialize solver components
     clauseDatabase.init();
-    erManager.init();
 
     lbool status = l_Undef;
 
@@ -221,9 +220,10 @@ lbool ERSolver::solve_() {
         printf("===============================================================================\n");
 
     if (status == l_True) {
-        // Extend & copy model:
+        // Extend & copy model (extension variables are left undefined):
         model.growTo(assignmentTrail.nVars());
-        for (int i = 0; i < assignmentTrail.nVars(); i++) model[i] = assignmentTrail.value(i);
+        for (int i = 0; i < assignmentTrail.nVars(); i++)
+            model[i] = erManager.isExtVar(i) ? l_Undef : assignmentTrail.value(i);
     } else if (status == l_False && conflict.size() == 0) {
         ok = false;
     }
@@ -31,6 +31,10 @@ namespace Minisat {
     /**
      * @brief This class augments the base solver with extended resolution capabilities.
      * 
+     * The solver can be used incrementally: variables and clauses may be added between calls to
+     * @code{solve}, each under its own assumptions. Extension variables, their definitions and the
+     * clauses learnt over them are kept across calls. Extension variables are left undefined in
+     * @code{model} and never occur in @code{conflict}, which only contains negated assumptions.
      */
     class ERSolver : public Solver {
     public:
@@ -35,8 +35,8 @@ SCENARIO("Introducing extension variables", "[ERManager]") {
         vec<Lit> clause, expect;
 
         // Set up variables for testing
-        erm.originalNumVars = 10;
-        for (int i = 0; i < erm.originalNumVars; i++) { s.newVar(); }
+        const int originalNumVars = 10;
+        for (int i = 0; i < originalNumVars; i++) { s.newVar(); }
 
         WHEN("introducing a new definition") {
             Lit x = mkLit(10), a = mkLit(0), b = mkLit(1);
@@ -58,7 +58,7 @@ SCENARIO("Introducing extension variables", "[ERManager]") {
                 }
 
                 // Test whether the extension variable was added to the solver
-                REQUIRE(at.nVars() == erm.originalNumVars + 1);
+                REQUIRE(at.nVars() == originalNumVars + 1);
 
                 // Test whether the extension variable definition was stored in the extension definition map
                 REQUIRE(erm.isCurrentExtVar(var(x)));
@@ -77,8 +77,8 @@ SCENARIO("Testing for valid definition pairs", "[ERManager]") {
     std::tr1::unordered_map<Var, std::vector<CRef> > db;
 
     // Set up variables for testing
-    erm.originalNumVars = 10;
-    for (int i = 0; i < erm.originalNumVars; i++) { s.newVar(); }
+    const int originalNumVars = 10;
+    for (int i = 0; i < originalNumVars; i++) { s.newVar(); }
 
     GIVEN("no pre-existing pairs") {
         std::tr1::unordered_set< std::pair<Lit, Lit> > generatedPairs;
@@ -175,8 +175,8 @@ SCENARIO("Choosing extension variables to delete", "[ERManager]") {
         vec<Var> actual, expect;
 
         // Set up variables for testing
-        erm.originalNumVars = 10;
-        for (int i = 0; i < erm.originalNumVars; i++) { s.newVar(); }
+        const int originalNumVars = 10;
+        for (int i = 0; i < originalNumVars; i++) { s.newVar(); }
 
         erm.m_extVarDefBuffer.push_back(ExtDef{ mkLit(10), mkLit(1), mkLit(2), additional });
         erm.m_extVarDefBuffer.push_back(ExtDef{ mkLit(11), mkLit(3), mkLit(4), additional });
@@ -246,8 +246,8 @@ SCENARIO("Find asserting extension definition clause", "[ERManager]") {
         CRef cr;
 
         // Set up variables for testing
-        erm.originalNumVars = 10;
-        for (int i = 0; i < erm.originalNumVars; i++) { s.newVar(); }
+        const int originalNumVars = 10;
+        for (int i = 0; i < originalNumVars; i++) { s.newVar(); }
 
         AND_GIVEN("a typical extension variable definition") {
             std::vector<CRef> cs;
@@ -283,25 +283,25 @@ SCENARIO("Find asserting extension definition clause", "[ERManager]") {
             std::vector<CRef> cs;
 
             // Non-asserting clauses
-            ps.clear(); for (int i = 0; i < erm.originalNumVars; i++) ps.push(mkLit(i, i % 2 == 0)); 
+            ps.clear(); for (int i = 0; i < originalNumVars; i++) ps.push(mkLit(i, i % 2 == 0)); 
             cs.push_back(s.ca.alloc(ps)); up.attachClause(cs[cs.size() - 1]);
-            ps.clear(); for (int i = 0; i < erm.originalNumVars; i++) ps.push(mkLit(i, true)); 
+            ps.clear(); for (int i = 0; i < originalNumVars; i++) ps.push(mkLit(i, true)); 
             cs.push_back(s.ca.alloc(ps)); up.attachClause(cs[cs.size() - 1]);
 
             // Asserting clause
             int asserting_cr = cs.size();
-            ps.clear(); for (int i = 0; i < erm.originalNumVars; i++) ps.push(mkLit(i, false)); 
+            ps.clear(); for (int i = 0; i < originalNumVars; i++) ps.push(mkLit(i, false)); 
             cs.push_back(s.ca.alloc(ps)); up.attachClause(cs[cs.size() - 1]);
 
             // Non-asserting clauses
-            ps.clear(); for (int i = 0; i < erm.originalNumVars; i++) ps.push(mkLit(i, i % 2 == 1)); 
+            ps.clear(); for (int i = 0; i < originalNumVars; i++) ps.push(mkLit(i, i % 2 == 1)); 
             cs.push_back(s.ca.alloc(ps)); up.attachClause(cs[cs.size() - 1]);
-            ps.clear(); for (int i = 0; i < erm.originalNumVars; i++) ps.push(mkLit(i, i % 3 == 0)); 
+            ps.clear(); for (int i = 0; i < originalNumVars; i++) ps.push(mkLit(i, i % 3 == 0)); 
             cs.push_back(s.ca.alloc(ps)); up.attachClause(cs[cs.size() - 1]);
 
             WHEN("the asserting literal is at the beginning") {
                 int expect_i_undef = 0, expect_i_max = 4;
-                setVariables(at, expect_i_undef, expect_i_max, erm.originalNumVars);
+                setVariables(at, expect_i_undef, expect_i_max, originalNumVars);
 
                 Lit x = s.ca[cs[asserting_cr]][expect_i_undef];
                 cr = erm.findAssertingClause(i_undef, i_max, ~x, cs);
@@ -314,8 +314,8 @@ SCENARIO("Find asserting extension definition clause", "[ERManager]") {
             }
 
             WHEN("the asserting literal is at the end") {
-                int expect_i_undef = erm.originalNumVars - 1, expect_i_max = 4;
-                setVariables(at, expect_i_undef, expect_i_max, erm.originalNumVars);
+                int expect_i_undef = originalNumVars - 1, expect_i_max = 4;
+                setVariables(at, expect_i_undef, expect_i_max, originalNumVars);
                 Lit x = s.ca[cs[asserting_cr]][expect_i_undef];
                 cr = erm.findAssertingClause(i_undef, i_max, ~x, cs);
                 
@@ -328,7 +328,7 @@ SCENARIO("Find asserting extension definition clause", "[ERManager]") {
 
             WHEN("the highest-level literal is at the beginning") {
                 int expect_i_undef = 4, expect_i_max = 0;
-                setVariables(at, expect_i_undef, expect_i_max, erm.originalNumVars);
+                setVariables(at, expect_i_undef, expect_i_max, originalNumVars);
                 Lit x = s.ca[cs[asserting_cr]][expect_i_undef];
                 cr = erm.findAssertingClause(i_undef, i_max, ~x, cs);
                 
@@ -340,8 +340,8 @@ SCENARIO("Find asserting extension definition clause", "[ERManager]") {
             }
 
             WHEN("the highest-level literal is at the end") {
-                int expect_i_undef = 4, expect_i_max = erm.originalNumVars - 1;
-                setVariables(at, expect_i_undef, expect_i_max, erm.originalNumVars);
+                int expect_i_undef = 4, expect_i_max = originalNumVars - 1;
+                setVariables(at, expect_i_undef, expect_i_max, originalNumVars);
                 Lit x = s.ca[cs[asserting_cr]][expect_i_undef];
                 cr = erm.findAssertingClause(i_undef, i_max, ~x, cs);
                 
@@ -354,7 +354,7 @@ SCENARIO("Find asserting extension definition clause", "[ERManager]") {
 
             WHEN("the asserting literal occurs before the highest-level literal") {
                 int expect_i_undef = 3, expect_i_max = 5;
-                setVariables(at, expect_i_undef, expect_i_max, erm.originalNumVars);
+                setVariables(at, expect_i_undef, expect_i_max, originalNumVars);
                 Lit x = s.ca[cs[asserting_cr]][expect_i_undef];
                 cr = erm.findAssertingClause(i_undef, i_max, ~x, cs);
                 
@@ -367,7 +367,7 @@ SCENARIO("Find asserting extension definition clause", "[ERManager]") {
 
             WHEN("the asserting literal occurs after the highest-level literal") {
                 int expect_i_undef = 5, expect_i_max = 3;
-                setVariables(at, expect_i_undef, expect_i_max, erm.originalNumVars);
+                setVariables(at, expect_i_undef, expect_i_max, originalNumVars);
                 Lit x = s.ca[cs[asserting_cr]][expect_i_undef];
                 cr = erm.findAssertingClause(i_undef, i_max, ~x, cs);
                 
@@ -381,6 +381,53 @@ SCENARIO("Find asserting extension definition clause", "[ERManager]") {
     }
 }
 
+SCENARIO("Solving incrementally with extension variables", "[ERSolver]") {
+    GIVEN("a formula with an extension variable") {
+        ERSolver s;
+        ERManager& erm = s.erManager;
+        vec<Lit> ps, assumps;
+
+        // (1 v 2) & (3 v 4) & (-1 v -3) with the extension variable 5 <=> 1 v 2
+        for (int i = 0; i < 5; i++) s.newVar();
+        setLitVec(ps, { 1,  2}); s.addClause(ps);
+        setLitVec(ps, { 3,  4}); s.addClause(ps);
+        setLitVec(ps, {-1, -3}); s.addClause(ps);
+        Lit x = mkLit(5);
+        erm.m_extVarDefBuffer.push_back(ExtDef{ x, mkLit(1), mkLit(2), std::vector< std::vector<Lit> >() });
+        erm.introduceExtVars();
+
+        WHEN("solving under inconsistent assumptions") {
+            setLitVec(assumps, {1, 3});
+            lbool ret = s.solveLimited(assumps);
+
+            THEN("the core only contains negated assumptions") {
+                REQUIRE(ret == l_False);
+                REQUIRE(s.okay());
+                setLitVec(ps, {-1, -3});
+                CHECK_THAT(s.conflict, vecEqualUnordered(ps));
+            }
+
+            AND_WHEN("solving again after adding a variable and a clause") {
+                Var y = s.newVar();
+                setLitVec(ps, {-2, 6}); s.addClause(ps);
+                setLitVec(assumps, {2, -3});
+                ret = s.solveLimited(assumps);
+
+                THEN("the extension variable is kept but excluded from the model") {
+                    REQUIRE(ret == l_True);
+                    CHECK(erm.isCurrentExtVar(var(x)));
+                    CHECK(!erm.isExtVar(y));
+                    CHECK(s.modelValue(var(x)) == l_Undef);
+                    CHECK(s.modelValue(mkLit(2)) == l_True);
+                    CHECK(s.modelValue(mkLit(3)) == l_False);
+                    CHECK(s.modelValue(mkLit(4)) == l_True);
+                    CHECK(s.modelValue(y) == l_True);
+                }
+            }
+        }
+    }
+}
+
 // ERManager::deleteExtVars
 // SCENARIO("Deleting extension variables", "[ERManager]") {}
 }
\ No newline at end of file
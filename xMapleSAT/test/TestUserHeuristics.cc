@@ -38,7 +38,6 @@ SCENARIO("Generating definitions for extension variables", "[UserHeuristics]") {
         setLitVec(ps, {-1,-2,-3,-4}); s.addClause(ps);
         setLitVec(ps, {    2, 3,-4}); s.addClause(ps);
         setLitVec(ps, { 1,    3,-4}); s.addClause(ps);
-        erm.originalNumVars = at.nVars();
 
         // Select all the clauses
         for (int i = 0; i < s.clauseDatabase.clauses.size(); i++) {